@@ -56,6 +56,18 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Every-cycle salience evaluation only updates   */
+/*            the activations of rules whose salience has    */
+/*            changed.                                       */
+/*                                                           */
+/*            Added AppendActivation to restore an agenda    */
+/*            captured by a reset snapshot.                  */
+/*                                                           */
+/*            Added binary trace records.                    */
+/*                                                           */
+/*            Salience refresh visits only the rules in the  */
+/*            list of rules with a dynamic salience.         */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -66,11 +78,15 @@
 #if DEFRULE_CONSTRUCT
 
 #include "argacces.h"
+#include "bintrace.h"
 #include "constant.h"
 #include "crstrtgy.h"
 #include "engine.h"
 #include "envrnmnt.h"
 #include "extnfunc.h"
+#if DEFGLOBAL_CONSTRUCT
+#include "globldef.h"
+#endif
 #include "memalloc.h"
 #include "moduldef.h"
 #include "modulutl.h"
@@ -98,6 +114,10 @@
    static struct salienceGroup   *ReuseOrCreateSalienceGroup(Environment *,struct defruleModule *,int);
    static struct salienceGroup   *FindSalienceGroup(struct defruleModule *,int);
    static void                    RemoveActivationFromGroup(Environment *,Activation *,struct defruleModule *);
+   static void                    RefreshRuleSalience(Environment *,Defrule *);
+   static bool                    SalienceDependsOnGlobals(struct expr *);
+   static bool                    SalienceGlobalsChanged(Environment *,struct expr *,unsigned long long);
+
 
 /*************************************************/
 /* InitializeAgenda: Initializes the activations */
@@ -162,6 +182,7 @@ void AddActivation(
    /*=======================================================*/
 
    newActivation = get_struct(theEnv,activation);
+   UpdateSubsystemMemory(theEnv,AGENDA_MEMORY,(long) sizeof(struct activation));
    newActivation->theRule = theRule;
    newActivation->basis = binds;
    newActivation->timetag = AgendaData(theEnv)->CurrentTimetag++;
@@ -191,6 +212,9 @@ void AddActivation(
       PrintActivation(theEnv,WTRACE,newActivation);
       PrintString(theEnv,WTRACE,"\n");
      }
+
+   if (BinaryTraceData(theEnv)->TraceActivations)
+     { BinaryTraceActivation(theEnv,BINARY_TRACE_ACTIVATE,newActivation); }
 #endif
 
     /*=====================================*/
@@ -204,6 +228,78 @@ void AddActivation(
     PlaceActivation(theEnv,&(theModuleItem->agenda),newActivation,theGroup);
    }
 
+/*******************************************************************/
+/* AppendActivation: Adds an activation to the end of the agenda   */
+/*   of its rule's module and links it with its partial match. The */
+/*   activations of a module must be appended in agenda order, so  */
+/*   the salience groups only need to be created at the end of the */
+/*   list of groups. Used to restore a previously captured agenda  */
+/*   without applying the conflict resolution strategy.            */
+/*******************************************************************/
+void AppendActivation(
+  Environment *theEnv,
+  Activation *theActivation)
+  {
+   struct defruleModule *theModuleItem;
+   struct salienceGroup *theGroup, *lastGroup;
+   Activation *lastActivation;
+
+   theModuleItem = (struct defruleModule *) theActivation->theRule->header.whichModule;
+
+   /*===================================================*/
+   /* The last activation on the agenda is the last     */
+   /* activation of the group with the lowest salience. */
+   /*===================================================*/
+
+   for (lastGroup = theModuleItem->groupings;
+        (lastGroup != NULL) && (lastGroup->next != NULL);
+        lastGroup = lastGroup->next)
+     { /* Do Nothing */ }
+
+   if (lastGroup == NULL)
+     { lastActivation = NULL; }
+   else
+     { lastActivation = lastGroup->last; }
+
+   if ((lastGroup != NULL) && (lastGroup->salience == theActivation->salience))
+     { theGroup = lastGroup; }
+   else
+     {
+      theGroup = get_struct(theEnv,salienceGroup);
+      theGroup->salience = theActivation->salience;
+      theGroup->first = NULL;
+      theGroup->last = NULL;
+      theGroup->next = NULL;
+      theGroup->prev = lastGroup;
+
+      if (lastGroup == NULL)
+        { theModuleItem->groupings = theGroup; }
+      else
+        { lastGroup->next = theGroup; }
+     }
+
+   /*=================================*/
+   /* Link the activation at the end. */
+   /*=================================*/
+
+   theActivation->prev = lastActivation;
+   theActivation->next = NULL;
+
+   if (lastActivation == NULL)
+     { theModuleItem->agenda = theActivation; }
+   else
+     { lastActivation->next = theActivation; }
+
+   if (theGroup->first == NULL)
+     { theGroup->first = theActivation; }
+   theGroup->last = theActivation;
+
+   theActivation->basis->marker = theActivation;
+
+   AgendaData(theEnv)->NumberOfActivations++;
+   AgendaData(theEnv)->AgendaChanged = true;
+  }
+
 /*******************************/
 /* ReuseOrCreateSalienceGroup: */
 /*******************************/
@@ -649,6 +745,9 @@ void RemoveActivation(
          PrintActivation(theEnv,WTRACE,theActivation);
          PrintString(theEnv,WTRACE,"\n");
         }
+
+      if (BinaryTraceData(theEnv)->TraceActivations)
+        { BinaryTraceActivation(theEnv,BINARY_TRACE_DEACTIVATE,theActivation); }
 #endif
 
       /*=============================*/
@@ -671,6 +770,7 @@ void RemoveActivation(
 
    AgendaData(theEnv)->NumberOfActivations--;
 
+   UpdateSubsystemMemory(theEnv,AGENDA_MEMORY,- (long) sizeof(struct activation));
    rtn_struct(theEnv,activation,theActivation);
   }
 
@@ -1235,6 +1335,234 @@ SalienceEvaluationType SetSalienceEvaluation(
    return ov;
   }
 
+/*******************************************************************/
+/* RefreshChangedSaliences: Updates the salience values of the     */
+/*   activations on the agenda after a rule fires when salience    */
+/*   evaluation is set to every-cycle. Only the rules in the list  */
+/*   of rules with a dynamic salience are visited. The activations */
+/*   of a rule whose salience is computed only from constants and  */
+/*   defglobals are updated only when one of those defglobals has  */
+/*   changed. The activations of other rules with dynamic salience */
+/*   are always updated. An activation is only moved on the agenda */
+/*   if its salience value changes.                                */
+/*******************************************************************/
+void RefreshChangedSaliences(
+  Environment *theEnv)
+  {
+   Defrule *theRule, *theDisjunct;
+
+   SaveCurrentModule(theEnv);
+
+   for (theRule = DefruleData(theEnv)->DynamicSalienceRules;
+        theRule != NULL;
+        theRule = theRule->nextDynamicSalience)
+     {
+      /*===================================================*/
+      /* Saliences are evaluated in the module of the rule */
+      /* as they are when the agenda is refreshed.         */
+      /*===================================================*/
+
+      SetCurrentModule(theEnv,theRule->header.whichModule->theModule);
+
+      for (theDisjunct = theRule;
+           theDisjunct != NULL;
+           theDisjunct = theDisjunct->disjunct)
+        { RefreshRuleSalience(theEnv,theDisjunct); }
+     }
+
+   RestoreCurrentModule(theEnv);
+  }
+
+/**************************************************************/
+/* RefreshRuleSalience: Updates the salience values of the    */
+/*   activations of a single rule disjunct. The activations   */
+/*   are found through the partial matches stored in the last */
+/*   join of the disjunct rather than by searching the        */
+/*   agenda.                                                  */
+/**************************************************************/
+static void RefreshRuleSalience(
+  Environment *theEnv,
+  Defrule *theRule)
+  {
+   struct betaMemory *theMemory;
+   struct partialMatch *theMatch;
+   struct defruleModule *theModuleItem;
+   struct salienceGroup *theGroup;
+   Activation *theActivation;
+   unsigned long b;
+   int salience = 0;
+   bool evaluateEach;
+
+   /*=======================================================*/
+   /* Determine the first time through whether the salience */
+   /* expression depends on anything other than defglobals. */
+   /*=======================================================*/
+
+   if (theRule->salienceDependency == SALIENCE_UNCLASSIFIED)
+     {
+      if (SalienceDependsOnGlobals(theRule->dynamicSalience))
+        { theRule->salienceDependency = SALIENCE_ON_GLOBALS; }
+      else
+        { theRule->salienceDependency = SALIENCE_VOLATILE; }
+     }
+
+   /*===============================================*/
+   /* A salience depending only on defglobals needs */
+   /* to be evaluated once, and only if one of its  */
+   /* defglobals has changed since the last update. */
+   /*===============================================*/
+
+   if (theRule->salienceDependency == SALIENCE_ON_GLOBALS)
+     {
+      if (! SalienceGlobalsChanged(theEnv,theRule->dynamicSalience,theRule->salienceTag))
+        { return; }
+
+#if DEFGLOBAL_CONSTRUCT
+      theRule->salienceTag = DefglobalData(theEnv)->CurrentChangeTag;
+#endif
+      salience = EvaluateSalience(theEnv,theRule);
+      evaluateEach = false;
+     }
+   else
+     { evaluateEach = true; }
+
+   /*====================================================*/
+   /* Move each activation whose salience has changed to */
+   /* its new place on the agenda.                       */
+   /*====================================================*/
+
+   theMemory = theRule->lastJoin->leftMemory;
+   if (theMemory == NULL) return;
+
+   theModuleItem = (struct defruleModule *) theRule->header.whichModule;
+
+   for (b = 0; b < theMemory->size; b++)
+     {
+      for (theMatch = theMemory->beta[b];
+           theMatch != NULL;
+           theMatch = theMatch->nextInMemory)
+        {
+         theActivation = (Activation *) theMatch->marker;
+         if (theActivation == NULL) continue;
+
+         if (evaluateEach)
+           { salience = EvaluateSalience(theEnv,theRule); }
+
+         if (theActivation->salience == salience) continue;
+
+         DetachActivation(theEnv,theActivation);
+         theActivation->salience = salience;
+         theGroup = ReuseOrCreateSalienceGroup(theEnv,theModuleItem,salience);
+         PlaceActivation(theEnv,&(theModuleItem->agenda),theActivation,theGroup);
+        }
+     }
+  }
+
+/****************************************************************/
+/* SalienceFunctionNames: Functions whose values depend only on */
+/*   their arguments. A salience expression built from these    */
+/*   functions, constants, and defglobals only needs to be      */
+/*   reevaluated when one of its defglobals changes.            */
+/****************************************************************/
+static const char *SalienceFunctionNames[] =
+  { "+", "-", "*", "/", "div", "**", "abs", "min", "max", "mod",
+    "float", "integer", "round", "sqrt", "exp", "log", "log10",
+    "=", "<>", ">", ">=", "<", "<=", "eq", "neq", "and", "or", "not",
+    "if", "progn", "length$", "nth$", "str-length", NULL };
+
+/****************************************************************/
+/* SalienceDependsOnGlobals: Returns true if an expression only */
+/*   contains constants, defglobal references, and calls to the */
+/*   functions listed in SalienceFunctionNames.                 */
+/****************************************************************/
+static bool SalienceDependsOnGlobals(
+  struct expr *theExp)
+  {
+   int i;
+
+   for (;
+        theExp != NULL;
+        theExp = theExp->nextArg)
+     {
+      switch (theExp->type)
+        {
+         case FCALL:
+           for (i = 0; SalienceFunctionNames[i] != NULL; i++)
+             {
+              if (strcmp(ExpressionFunctionCallName(theExp)->contents,
+                         SalienceFunctionNames[i]) == 0)
+                { break; }
+             }
+           if (SalienceFunctionNames[i] == NULL)
+             { return false; }
+           break;
+
+#if DEFGLOBAL_CONSTRUCT
+         case GBL_VARIABLE:
+         case DEFGLOBAL_PTR:
+#endif
+         case INTEGER_TYPE:
+         case FLOAT_TYPE:
+         case SYMBOL_TYPE:
+         case STRING_TYPE:
+           break;
+
+         default:
+           return false;
+        }
+
+      if (! SalienceDependsOnGlobals(theExp->argList))
+        { return false; }
+     }
+
+   return true;
+  }
+
+/*****************************************************************/
+/* SalienceGlobalsChanged: Returns true if any of the defglobals */
+/*   referenced by an expression has changed since the specified */
+/*   change tag. Global variables referenced by name are looked  */
+/*   up from the current module as they are when evaluated. A    */
+/*   reference to a missing defglobal is treated as a change.    */
+/*****************************************************************/
+static bool SalienceGlobalsChanged(
+  Environment *theEnv,
+  struct expr *theExp,
+  unsigned long long changeTag)
+  {
+#if DEFGLOBAL_CONSTRUCT
+   Defglobal *theGlobal;
+   int count;
+#endif
+
+   for (;
+        theExp != NULL;
+        theExp = theExp->nextArg)
+     {
+#if DEFGLOBAL_CONSTRUCT
+      if (theExp->type == DEFGLOBAL_PTR)
+        {
+         if (((Defglobal *) theExp->value)->changeTag > changeTag)
+           { return true; }
+        }
+      else if (theExp->type == GBL_VARIABLE)
+        {
+         theGlobal = (Defglobal *)
+                     FindImportedConstruct(theEnv,"defglobal",NULL,theExp->lexemeValue->contents,
+                                           &count,true,NULL);
+         if ((theGlobal == NULL) || (count > 1) ||
+             (theGlobal->changeTag > changeTag))
+           { return true; }
+        }
+#endif
+
+      if (SalienceGlobalsChanged(theEnv,theExp->argList,changeTag))
+        { return true; }
+     }
+
+   return false;
+  }
+
 /*****************************************************************/
 /* EvaluateSalience: Returns the salience value of the specified */
 /*   defrule. If salience evaluation is currently set to         */
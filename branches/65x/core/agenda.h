@@ -54,6 +54,10 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Every-cycle salience evaluation only updates   */
+/*            the activations of rules whose salience has    */
+/*            changed.                                       */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_agenda
@@ -125,6 +129,7 @@ struct agendaData
 /****************************************/
 
    void                    AddActivation(Environment *,Defrule *,PartialMatch *);
+   void                    AppendActivation(Environment *,Activation *);
    void                    ClearRuleFromAgenda(Environment *,Defrule *);
    Activation             *GetNextActivation(Environment *,Activation *);
    struct partialMatch    *GetActivationBasis(Environment *,Activation *);
@@ -146,6 +151,7 @@ struct agendaData
    SalienceEvaluationType  GetSalienceEvaluation(Environment *);
    SalienceEvaluationType  SetSalienceEvaluation(Environment *,SalienceEvaluationType);
    void                    RefreshAgenda(Defmodule *,Environment *);
+   void                    RefreshChangedSaliences(Environment *);
    void                    DefmoduleReorderAgenda(Defmodule *,Environment *);
    void                    InitializeAgenda(Environment *);
    void                    SetSalienceEvaluationCommand(Environment *,UDFContext *,UDFValue *);
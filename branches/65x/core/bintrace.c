@@ -0,0 +1,764 @@
+   /*******************************************************/
+   /*      "C" Language Integrated Production System      */
+   /*                                                     */
+   /*             CLIPS Version 6.50  11/01/16            */
+   /*                                                     */
+   /*                 BINARY TRACE MODULE                 */
+   /*******************************************************/
+
+/*************************************************************/
+/* Purpose: Writes compact binary records of fact, rule, and */
+/*   activation events to a trace file as an alternative to  */
+/*   the text output of the watch command, and decodes trace */
+/*   files into text.                                        */
+/*                                                           */
+/* Principal Programmer(s):                                  */
+/*      Gary D. Riley                                        */
+/*                                                           */
+/* Contributing Programmer(s):                               */
+/*                                                           */
+/* Revision History:                                         */
+/*                                                           */
+/*      6.50: Added binary trace files.                      */
+/*                                                           */
+/*            The decoder rejects name records with out of   */
+/*            sequence ids and keeps the length of each      */
+/*            name.                                          */
+/*                                                           */
+/*************************************************************/
+
+#include "setup.h"
+
+#if DEBUGGING_FUNCTIONS
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "argacces.h"
+#include "envrnmnt.h"
+#include "extnfunc.h"
+#include "memalloc.h"
+#include "prntutil.h"
+#include "router.h"
+#include "sysdep.h"
+
+#include "bintrace.h"
+
+/***************************************/
+/* LOCAL INTERNAL FUNCTION DEFINITIONS */
+/***************************************/
+
+   static void                    DeallocateBinaryTraceData(Environment *);
+   static void                    ReturnTraceFile(Environment *);
+   static unsigned int            TraceConstructID(Environment *,void *,const char *,unsigned char);
+   static void                    WriteTraceRecord(Environment *,unsigned char,unsigned short,
+                                                   unsigned int,long long,unsigned long long);
+   static void                    WriteTraceBasis(Environment *,PartialMatch *);
+   static void                    PrintDecodedBasis(Environment *,const char *,long long *,unsigned short);
+   static const char             *DecodedName(char **,unsigned int,unsigned int);
+
+/****************************************************/
+/* InitializeBinaryTraceData: Allocates environment */
+/*    data for binary trace files.                  */
+/****************************************************/
+void InitializeBinaryTraceData(
+  Environment *theEnv)
+  {
+   AllocateEnvironmentData(theEnv,BINARY_TRACE_DATA,sizeof(struct binaryTraceData),DeallocateBinaryTraceData);
+  }
+
+/******************************************************/
+/* DeallocateBinaryTraceData: Deallocates environment */
+/*    data for binary trace files.                    */
+/******************************************************/
+static void DeallocateBinaryTraceData(
+  Environment *theEnv)
+  {
+   ReturnTraceFile(theEnv);
+  }
+
+/******************************************************/
+/* BinaryTraceFunctionDefinitions: Initializes the    */
+/*   commands for writing and decoding binary traces. */
+/******************************************************/
+void BinaryTraceFunctionDefinitions(
+  Environment *theEnv)
+  {
+#if ! RUN_TIME
+   AddUDF(theEnv,"binary-trace-on","b",1,UNBOUNDED,"y;sy",BinaryTraceOnCommand,"BinaryTraceOnCommand",NULL);
+   AddUDF(theEnv,"binary-trace-off","b",0,0,NULL,BinaryTraceOffCommand,"BinaryTraceOffCommand",NULL);
+   AddUDF(theEnv,"binary-trace-decode","b",1,2,"*;sy",BinaryTraceDecodeCommand,"BinaryTraceDecodeCommand",NULL);
+#else
+#if MAC_XCD
+#pragma unused(theEnv)
+#endif
+#endif
+  }
+
+/****************************************************/
+/* OpenBinaryTrace: Opens a binary trace file and   */
+/*   begins writing records for the selected items. */
+/*   Any binary trace already in progress is ended. */
+/****************************************************/
+bool OpenBinaryTrace(
+  Environment *theEnv,
+  const char *fileName,
+  bool traceFacts,
+  bool traceRules,
+  bool traceActivations)
+  {
+   FILE *theFile;
+   struct binaryTraceHeader theHeader;
+
+   ReturnTraceFile(theEnv);
+
+   theFile = GenOpen(theEnv,fileName,"wb");
+   if (theFile == NULL)
+     { return false; }
+
+   /*==============================================*/
+   /* Records are written through a large buffer   */
+   /* so that a trace rarely requires a system     */
+   /* call. The buffer is flushed when the file is */
+   /* closed or the program exits.                 */
+   /*==============================================*/
+
+   BinaryTraceData(theEnv)->TraceBuffer = (char *) genalloc(theEnv,BINARY_TRACE_BUFFER_SIZE);
+   setvbuf(theFile,BinaryTraceData(theEnv)->TraceBuffer,_IOFBF,BINARY_TRACE_BUFFER_SIZE);
+
+   BinaryTraceData(theEnv)->NameTable = (struct binaryTraceName **)
+      gm2(theEnv,sizeof(struct binaryTraceName *) * BINARY_TRACE_HASH_SIZE);
+   memset(BinaryTraceData(theEnv)->NameTable,0,sizeof(struct binaryTraceName *) * BINARY_TRACE_HASH_SIZE);
+   BinaryTraceData(theEnv)->NextID = 1;
+   BinaryTraceData(theEnv)->TraceFile = theFile;
+
+   memcpy(theHeader.marker,BINARY_TRACE_MARKER,sizeof(theHeader.marker));
+   theHeader.byteOrder = BINARY_TRACE_BYTE_ORDER;
+   theHeader.recordSize = sizeof(struct binaryTraceRecord);
+   fwrite(&theHeader,sizeof(struct binaryTraceHeader),1,theFile);
+
+   BinaryTraceData(theEnv)->TraceFacts = traceFacts;
+   BinaryTraceData(theEnv)->TraceRules = traceRules;
+   BinaryTraceData(theEnv)->TraceActivations = traceActivations;
+
+   return true;
+  }
+
+/**************************************************/
+/* CloseBinaryTrace: Ends the binary trace that   */
+/*   is in progress. Returns false if no trace is */
+/*   in progress, otherwise true.                 */
+/**************************************************/
+bool CloseBinaryTrace(
+  Environment *theEnv)
+  {
+   if (BinaryTraceData(theEnv)->TraceFile == NULL)
+     { return false; }
+
+   ReturnTraceFile(theEnv);
+
+   return true;
+  }
+
+/***********************************************/
+/* BinaryTraceActive: Returns true if a binary */
+/*   trace is in progress, otherwise false.    */
+/***********************************************/
+bool BinaryTraceActive(
+  Environment *theEnv)
+  {
+   return (BinaryTraceData(theEnv)->TraceFile != NULL);
+  }
+
+/********************************************************/
+/* ReturnTraceFile: Closes the trace file, writing any  */
+/*   buffered records, and returns the buffer and the   */
+/*   table of construct ids to the pool of free memory. */
+/********************************************************/
+static void ReturnTraceFile(
+  Environment *theEnv)
+  {
+   struct binaryTraceName *theName, *nextName;
+   unsigned int i;
+
+   BinaryTraceData(theEnv)->TraceFacts = false;
+   BinaryTraceData(theEnv)->TraceRules = false;
+   BinaryTraceData(theEnv)->TraceActivations = false;
+
+   if (BinaryTraceData(theEnv)->TraceFile == NULL)
+     { return; }
+
+   GenClose(theEnv,BinaryTraceData(theEnv)->TraceFile);
+   BinaryTraceData(theEnv)->TraceFile = NULL;
+
+   genfree(theEnv,BinaryTraceData(theEnv)->TraceBuffer,BINARY_TRACE_BUFFER_SIZE);
+   BinaryTraceData(theEnv)->TraceBuffer = NULL;
+
+   for (i = 0; i < BINARY_TRACE_HASH_SIZE; i++)
+     {
+      for (theName = BinaryTraceData(theEnv)->NameTable[i];
+           theName != NULL;
+           theName = nextName)
+        {
+         nextName = theName->next;
+         rm(theEnv,theName->name,theName->length + 1);
+         rtn_struct(theEnv,binaryTraceName,theName);
+        }
+     }
+
+   rm(theEnv,BinaryTraceData(theEnv)->NameTable,sizeof(struct binaryTraceName *) * BINARY_TRACE_HASH_SIZE);
+   BinaryTraceData(theEnv)->NameTable = NULL;
+  }
+
+/********************************************************/
+/* TraceConstructID: Returns the id of a rule or        */
+/*   template in the trace file. The first time a       */
+/*   construct is seen, a name record is written to     */
+/*   assign the id. Since an entry is matched using     */
+/*   both the address and the name of the construct,    */
+/*   a construct deleted and replaced by another with a */
+/*   different name at the same address receives a new  */
+/*   id without the table having to track deletions.    */
+/********************************************************/
+static unsigned int TraceConstructID(
+  Environment *theEnv,
+  void *theConstruct,
+  const char *name,
+  unsigned char nameType)
+  {
+   struct binaryTraceName *theName;
+   unsigned long hashValue;
+   size_t length;
+
+   hashValue = (((unsigned long) theConstruct) >> 3) % BINARY_TRACE_HASH_SIZE;
+
+   for (theName = BinaryTraceData(theEnv)->NameTable[hashValue];
+        theName != NULL;
+        theName = theName->next)
+     {
+      if (theName->theConstruct == theConstruct)
+        {
+         if (strcmp(theName->name,name) == 0)
+           { return theName->id; }
+         rm(theEnv,theName->name,theName->length + 1);
+         break;
+        }
+     }
+
+   if (theName == NULL)
+     {
+      theName = get_struct(theEnv,binaryTraceName);
+      theName->theConstruct = theConstruct;
+      theName->next = BinaryTraceData(theEnv)->NameTable[hashValue];
+      BinaryTraceData(theEnv)->NameTable[hashValue] = theName;
+     }
+
+   length = strlen(name);
+   if (length > USHRT_MAX)
+     { length = USHRT_MAX; }
+
+   theName->length = length;
+   theName->name = (char *) gm2(theEnv,length + 1);
+   genstrncpy(theName->name,name,length);
+   theName->name[length] = EOS;
+   theName->id = BinaryTraceData(theEnv)->NextID++;
+
+   WriteTraceRecord(theEnv,nameType,(unsigned short) length,theName->id,0,0);
+   fwrite(theName->name,1,length,BinaryTraceData(theEnv)->TraceFile);
+
+   return theName->id;
+  }
+
+/****************************************************/
+/* WriteTraceRecord: Writes a record to the trace   */
+/*   file. The data following the record, if any,   */
+/*   is written by the caller.                      */
+/****************************************************/
+static void WriteTraceRecord(
+  Environment *theEnv,
+  unsigned char type,
+  unsigned short count,
+  unsigned int id,
+  long long value,
+  unsigned long long timetag)
+  {
+   struct binaryTraceRecord theRecord;
+
+   theRecord.type = type;
+   theRecord.reserved = 0;
+   theRecord.count = count;
+   theRecord.id = id;
+   theRecord.value = value;
+   theRecord.timetag = timetag;
+
+   fwrite(&theRecord,sizeof(struct binaryTraceRecord),1,BinaryTraceData(theEnv)->TraceFile);
+  }
+
+/*****************************************************/
+/* WriteTraceBasis: Writes the fact indices of the   */
+/*   partial match of a fire or activation record.   */
+/*****************************************************/
+static void WriteTraceBasis(
+  Environment *theEnv,
+  PartialMatch *theBasis)
+  {
+   PatternEntity *matchingItem;
+   long long factIndex;
+   unsigned short i;
+
+   for (i = 0; i < theBasis->bcount; i++)
+     {
+      if ((get_nth_pm_match(theBasis,i) == NULL) ||
+          (get_nth_pm_match(theBasis,i)->matchingItem == NULL))
+        { factIndex = BINARY_TRACE_NOT_MATCHED; }
+      else
+        {
+         matchingItem = get_nth_pm_match(theBasis,i)->matchingItem;
+         if (matchingItem->header.type == FACT_ADDRESS_TYPE)
+           { factIndex = ((Fact *) matchingItem)->factIndex; }
+         else
+           { factIndex = BINARY_TRACE_NOT_A_FACT; }
+        }
+
+      fwrite(&factIndex,sizeof(long long),1,BinaryTraceData(theEnv)->TraceFile);
+     }
+  }
+
+/************************************************/
+/* BinaryTraceFact: Writes an assert or retract */
+/*   record for a fact to the trace file.       */
+/************************************************/
+void BinaryTraceFact(
+  Environment *theEnv,
+  unsigned char type,
+  Fact *theFact)
+  {
+   unsigned int id;
+
+   id = TraceConstructID(theEnv,theFact->whichDeftemplate,
+                         theFact->whichDeftemplate->header.name->contents,
+                         BINARY_TRACE_TEMPLATE_NAME);
+
+   WriteTraceRecord(theEnv,type,0,id,theFact->factIndex,theFact->patternHeader.timeTag);
+  }
+
+/************************************************/
+/* BinaryTraceFiring: Writes a fire record for  */
+/*   an activation to the trace file.           */
+/************************************************/
+void BinaryTraceFiring(
+  Environment *theEnv,
+  Activation *theActivation,
+  long long rulesFired)
+  {
+   unsigned int id;
+
+   id = TraceConstructID(theEnv,theActivation->theRule,
+                         theActivation->theRule->header.name->contents,
+                         BINARY_TRACE_RULE_NAME);
+
+   WriteTraceRecord(theEnv,BINARY_TRACE_FIRE,theActivation->basis->bcount,
+                    id,rulesFired,theActivation->timetag);
+   WriteTraceBasis(theEnv,theActivation->basis);
+  }
+
+/*****************************************************/
+/* BinaryTraceActivation: Writes an activation added */
+/*   or removed record to the trace file.            */
+/*****************************************************/
+void BinaryTraceActivation(
+  Environment *theEnv,
+  unsigned char type,
+  Activation *theActivation)
+  {
+   unsigned int id;
+
+   id = TraceConstructID(theEnv,theActivation->theRule,
+                         theActivation->theRule->header.name->contents,
+                         BINARY_TRACE_RULE_NAME);
+
+   WriteTraceRecord(theEnv,type,theActivation->basis->bcount,
+                    id,theActivation->salience,theActivation->timetag);
+   WriteTraceBasis(theEnv,theActivation->basis);
+  }
+
+/*********************************************************/
+/* DecodeBinaryTrace: Prints the records of a binary     */
+/*   trace file in a format similar to the watch output. */
+/*   Each line begins with the timetag of the fact or    */
+/*   activation. Returns false if the file can't be      */
+/*   opened, isn't a binary trace file, or is truncated  */
+/*   or malformed.                                       */
+/*********************************************************/
+bool DecodeBinaryTrace(
+  Environment *theEnv,
+  const char *fileName,
+  const char *logicalName)
+  {
+   FILE *theFile;
+   struct binaryTraceHeader theHeader;
+   struct binaryTraceRecord theRecord;
+   char **names = NULL;
+   unsigned short *nameLengths = NULL;
+   unsigned int nameCount = 0, namesRead = 0, newCount, i;
+   char **newNames;
+   unsigned short *newLengths;
+   long long *basis = NULL;
+   unsigned short basisCount = 0;
+   char printSpace[60];
+   bool rv = true, malformed = false;
+
+   theFile = GenOpen(theEnv,fileName,"rb");
+   if (theFile == NULL)
+     {
+      OpenErrorMessage(theEnv,"binary-trace-decode",fileName);
+      return false;
+     }
+
+   if ((fread(&theHeader,sizeof(struct binaryTraceHeader),1,theFile) != 1) ||
+       (memcmp(theHeader.marker,BINARY_TRACE_MARKER,sizeof(theHeader.marker)) != 0) ||
+       (theHeader.byteOrder != BINARY_TRACE_BYTE_ORDER) ||
+       (theHeader.recordSize != sizeof(struct binaryTraceRecord)))
+     {
+      GenClose(theEnv,theFile);
+      PrintErrorID(theEnv,"BINTRACE",1,false);
+      PrintString(theEnv,WERROR,"File '");
+      PrintString(theEnv,WERROR,fileName);
+      PrintString(theEnv,WERROR,"' is not a binary trace file.\n");
+      return false;
+     }
+
+   while (fread(&theRecord,sizeof(struct binaryTraceRecord),1,theFile) == 1)
+     {
+      /*=========================================*/
+      /* Name records assign the id of a rule or */
+      /* template and aren't printed.            */
+      /*=========================================*/
+
+      if ((theRecord.type == BINARY_TRACE_RULE_NAME) ||
+          (theRecord.type == BINARY_TRACE_TEMPLATE_NAME))
+        {
+         /*================================================*/
+         /* Ids are assigned in sequence starting with 1,  */
+         /* so an id which is 0 or which skips ahead of    */
+         /* the names already read means the file has been */
+         /* corrupted.                                     */
+         /*================================================*/
+
+         if ((theRecord.id == 0) || (theRecord.id > namesRead + 1))
+           {
+            rv = false;
+            malformed = true;
+            break;
+           }
+         namesRead++;
+
+         if (theRecord.id >= nameCount)
+           {
+            newCount = (nameCount == 0) ? 64 : nameCount * 2;
+            newNames = (char **) gm2(theEnv,sizeof(char *) * newCount);
+            newLengths = (unsigned short *) gm2(theEnv,sizeof(unsigned short) * newCount);
+            for (i = 0; i < newCount; i++)
+              {
+               newNames[i] = (i < nameCount) ? names[i] : NULL;
+               newLengths[i] = (i < nameCount) ? nameLengths[i] : 0;
+              }
+            if (names != NULL)
+              {
+               rm(theEnv,names,sizeof(char *) * nameCount);
+               rm(theEnv,nameLengths,sizeof(unsigned short) * nameCount);
+              }
+            names = newNames;
+            nameLengths = newLengths;
+            nameCount = newCount;
+           }
+
+         /*=============================================*/
+         /* The length of each name is kept, since a    */
+         /* name read from a damaged file may contain   */
+         /* a null character and strlen can't be used   */
+         /* to determine the size of its allocation.    */
+         /*=============================================*/
+
+         if (names[theRecord.id] != NULL)
+           { rm(theEnv,names[theRecord.id],nameLengths[theRecord.id] + 1U); }
+
+         names[theRecord.id] = (char *) gm2(theEnv,theRecord.count + 1U);
+         nameLengths[theRecord.id] = theRecord.count;
+         if (fread(names[theRecord.id],1,theRecord.count,theFile) != theRecord.count)
+           {
+            rv = false;
+            break;
+           }
+         names[theRecord.id][theRecord.count] = EOS;
+         continue;
+        }
+
+      /*=====================================*/
+      /* Read the fact indices of the fire   */
+      /* and activation records.             */
+      /*=====================================*/
+
+      if (theRecord.count > basisCount)
+        {
+         if (basis != NULL)
+           { rm(theEnv,basis,sizeof(long long) * basisCount); }
+         basisCount = theRecord.count;
+         basis = (long long *) gm2(theEnv,sizeof(long long) * basisCount);
+        }
+
+      if ((theRecord.count > 0) &&
+          (fread(basis,sizeof(long long),theRecord.count,theFile) != theRecord.count))
+        {
+         rv = false;
+         break;
+        }
+
+      gensprintf(printSpace,"%-6llu ",theRecord.timetag);
+      PrintString(theEnv,logicalName,printSpace);
+
+      switch (theRecord.type)
+        {
+         case BINARY_TRACE_ASSERT:
+         case BINARY_TRACE_RETRACT:
+           PrintString(theEnv,logicalName,(theRecord.type == BINARY_TRACE_ASSERT) ? "==> " : "<== ");
+           gensprintf(printSpace,"f-%-5lld ",theRecord.value);
+           PrintString(theEnv,logicalName,printSpace);
+           PrintString(theEnv,logicalName,DecodedName(names,nameCount,theRecord.id));
+           break;
+
+         case BINARY_TRACE_FIRE:
+           gensprintf(printSpace,"FIRE %4lld ",theRecord.value);
+           PrintString(theEnv,logicalName,printSpace);
+           PrintString(theEnv,logicalName,DecodedName(names,nameCount,theRecord.id));
+           PrintString(theEnv,logicalName,": ");
+           PrintDecodedBasis(theEnv,logicalName,basis,theRecord.count);
+           break;
+
+         case BINARY_TRACE_ACTIVATE:
+         case BINARY_TRACE_DEACTIVATE:
+           PrintString(theEnv,logicalName,(theRecord.type == BINARY_TRACE_ACTIVATE) ? "==> " : "<== ");
+           gensprintf(printSpace,"Activation %-6lld ",theRecord.value);
+           PrintString(theEnv,logicalName,printSpace);
+           PrintString(theEnv,logicalName,DecodedName(names,nameCount,theRecord.id));
+           PrintString(theEnv,logicalName,": ");
+           PrintDecodedBasis(theEnv,logicalName,basis,theRecord.count);
+           break;
+
+         default:
+           PrintString(theEnv,logicalName,"???");
+           break;
+        }
+
+      PrintString(theEnv,logicalName,"\n");
+     }
+
+   GenClose(theEnv,theFile);
+
+   for (i = 0; i < nameCount; i++)
+     {
+      if (names[i] != NULL)
+        { rm(theEnv,names[i],nameLengths[i] + 1U); }
+     }
+
+   if (names != NULL)
+     {
+      rm(theEnv,names,sizeof(char *) * nameCount);
+      rm(theEnv,nameLengths,sizeof(unsigned short) * nameCount);
+     }
+
+   if (basis != NULL)
+     { rm(theEnv,basis,sizeof(long long) * basisCount); }
+
+   if (malformed)
+     {
+      PrintErrorID(theEnv,"BINTRACE",3,false);
+      PrintString(theEnv,WERROR,"Binary trace file '");
+      PrintString(theEnv,WERROR,fileName);
+      PrintString(theEnv,WERROR,"' is malformed.\n");
+     }
+   else if (! rv)
+     {
+      PrintErrorID(theEnv,"BINTRACE",2,false);
+      PrintString(theEnv,WERROR,"Binary trace file '");
+      PrintString(theEnv,WERROR,fileName);
+      PrintString(theEnv,WERROR,"' is truncated.\n");
+     }
+
+   return rv;
+  }
+
+/*****************************************************/
+/* PrintDecodedBasis: Prints the fact indices of a   */
+/*   fire or activation record in the same format as */
+/*   the PrintPartialMatch function.                 */
+/*****************************************************/
+static void PrintDecodedBasis(
+  Environment *theEnv,
+  const char *logicalName,
+  long long *basis,
+  unsigned short count)
+  {
+   char printSpace[30];
+   unsigned short i;
+
+   for (i = 0; i < count;)
+     {
+      if (basis[i] == BINARY_TRACE_NOT_MATCHED)
+        { PrintString(theEnv,logicalName,"*"); }
+      else if (basis[i] == BINARY_TRACE_NOT_A_FACT)
+        { PrintString(theEnv,logicalName,"[]"); }
+      else
+        {
+         gensprintf(printSpace,"f-%lld",basis[i]);
+         PrintString(theEnv,logicalName,printSpace);
+        }
+      i++;
+      if (i < count) PrintString(theEnv,logicalName,",");
+     }
+  }
+
+/*************************************************/
+/* DecodedName: Returns the name assigned to an  */
+/*   id by the name records of a trace file.     */
+/*************************************************/
+static const char *DecodedName(
+  char **names,
+  unsigned int nameCount,
+  unsigned int id)
+  {
+   if ((id >= nameCount) || (names[id] == NULL))
+     { return "???"; }
+
+   return names[id];
+  }
+
+/****************************************************/
+/* BinaryTraceOnCommand: H/L access routine for the */
+/*   binary-trace-on command.                       */
+/****************************************************/
+void BinaryTraceOnCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   const char *fileName, *item;
+   UDFValue theArg;
+   bool traceFacts = false, traceRules = false, traceActivations = false;
+
+   if ((fileName = GetFileName(context)) == NULL)
+     {
+      returnValue->lexemeValue = FalseSymbol(theEnv);
+      return;
+     }
+
+   /*===============================================*/
+   /* Determine the items to be traced. If no items */
+   /* are specified, all of them are traced.        */
+   /*===============================================*/
+
+   if (! UDFHasNextArgument(context))
+     { traceFacts = traceRules = traceActivations = true; }
+
+   while (UDFHasNextArgument(context))
+     {
+      if (! UDFNextArgument(context,SYMBOL_BIT,&theArg))
+        {
+         returnValue->lexemeValue = FalseSymbol(theEnv);
+         return;
+        }
+
+      item = theArg.lexemeValue->contents;
+      if (strcmp(item,"facts") == 0)
+        { traceFacts = true; }
+      else if (strcmp(item,"rules") == 0)
+        { traceRules = true; }
+      else if (strcmp(item,"activations") == 0)
+        { traceActivations = true; }
+      else if (strcmp(item,"all") == 0)
+        { traceFacts = traceRules = traceActivations = true; }
+      else
+        {
+         UDFInvalidArgumentMessage(context,"traceable symbol");
+         SetEvaluationError(theEnv,true);
+         returnValue->lexemeValue = FalseSymbol(theEnv);
+         return;
+        }
+     }
+
+   if (! OpenBinaryTrace(theEnv,fileName,traceFacts,traceRules,traceActivations))
+     {
+      OpenErrorMessage(theEnv,"binary-trace-on",fileName);
+      returnValue->lexemeValue = FalseSymbol(theEnv);
+      return;
+     }
+
+   returnValue->lexemeValue = TrueSymbol(theEnv);
+  }
+
+/*****************************************************/
+/* BinaryTraceOffCommand: H/L access routine for the */
+/*   binary-trace-off command.                       */
+/*****************************************************/
+void BinaryTraceOffCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+#if MAC_XCD
+#pragma unused(context)
+#endif
+
+   returnValue->lexemeValue = CreateBoolean(theEnv,CloseBinaryTrace(theEnv));
+  }
+
+/********************************************************/
+/* BinaryTraceDecodeCommand: H/L access routine for the */
+/*   binary-trace-decode command.                       */
+/********************************************************/
+void BinaryTraceDecodeCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   const char *fileName, *logicalName;
+
+   if ((fileName = GetFileName(context)) == NULL)
+     {
+      returnValue->lexemeValue = FalseSymbol(theEnv);
+      return;
+     }
+
+   if (UDFHasNextArgument(context))
+     {
+      logicalName = GetLogicalName(context,STDOUT);
+      if (logicalName == NULL)
+        {
+         IllegalLogicalNameMessage(theEnv,"binary-trace-decode");
+         SetHaltExecution(theEnv,true);
+         SetEvaluationError(theEnv,true);
+         returnValue->lexemeValue = FalseSymbol(theEnv);
+         return;
+        }
+     }
+   else
+     { logicalName = STDOUT; }
+
+   if (QueryRouters(theEnv,logicalName) == false)
+     {
+      UnrecognizedRouterMessage(theEnv,logicalName);
+      returnValue->lexemeValue = FalseSymbol(theEnv);
+      return;
+     }
+
+   if (! DecodeBinaryTrace(theEnv,fileName,logicalName))
+     {
+      returnValue->lexemeValue = FalseSymbol(theEnv);
+      return;
+     }
+
+   returnValue->lexemeValue = TrueSymbol(theEnv);
+  }
+
+#endif /* DEBUGGING_FUNCTIONS */
@@ -0,0 +1,121 @@
+   /*******************************************************/
+   /*      "C" Language Integrated Production System      */
+   /*                                                     */
+   /*             CLIPS Version 6.50  11/01/16            */
+   /*                                                     */
+   /*              BINARY TRACE HEADER FILE               */
+   /*******************************************************/
+
+/*************************************************************/
+/* Purpose: Writes compact binary records of fact, rule, and */
+/*   activation events to a trace file as an alternative to  */
+/*   the text output of the watch command, and decodes trace */
+/*   files into text.                                        */
+/*                                                           */
+/* Principal Programmer(s):                                  */
+/*      Gary D. Riley                                        */
+/*                                                           */
+/* Contributing Programmer(s):                               */
+/*                                                           */
+/* Revision History:                                         */
+/*                                                           */
+/*      6.50: Added binary trace files.                      */
+/*                                                           */
+/*************************************************************/
+
+#ifndef _H_bintrace
+
+#pragma once
+
+#define _H_bintrace
+
+#include <stdio.h>
+
+#include "agenda.h"
+#include "factmngr.h"
+#include "match.h"
+#include "ruledef.h"
+
+/***********************************************************/
+/* A trace file begins with a header followed by a stream  */
+/* of records. Each record is followed by count fact       */
+/* indices (as long long values) for the fire and          */
+/* activation records or by count characters of the name   */
+/* for the name records. A fact index of -1 represents an  */
+/* unmatched (not) pattern and -2 represents a non-fact    */
+/* pattern entity. The first event referring to a rule or  */
+/* template is preceded by a name record assigning the id. */
+/***********************************************************/
+
+#define BINARY_TRACE_MARKER "CLIPSBT1"
+#define BINARY_TRACE_BYTE_ORDER 0x01020304
+
+#define BINARY_TRACE_ASSERT            1
+#define BINARY_TRACE_RETRACT           2
+#define BINARY_TRACE_FIRE              3
+#define BINARY_TRACE_ACTIVATE          4
+#define BINARY_TRACE_DEACTIVATE        5
+#define BINARY_TRACE_RULE_NAME         6
+#define BINARY_TRACE_TEMPLATE_NAME     7
+
+#define BINARY_TRACE_NOT_MATCHED      -1
+#define BINARY_TRACE_NOT_A_FACT       -2
+
+#define BINARY_TRACE_HASH_SIZE      1021
+#define BINARY_TRACE_BUFFER_SIZE   65536
+
+struct binaryTraceHeader
+  {
+   char marker[8];
+   unsigned int byteOrder;
+   unsigned int recordSize;
+  };
+
+struct binaryTraceRecord
+  {
+   unsigned char type;
+   unsigned char reserved;
+   unsigned short count;
+   unsigned int id;
+   long long value;
+   unsigned long long timetag;
+  };
+
+struct binaryTraceName
+  {
+   void *theConstruct;
+   char *name;
+   size_t length;
+   unsigned int id;
+   struct binaryTraceName *next;
+  };
+
+#define BINARY_TRACE_DATA 6
+
+struct binaryTraceData
+  {
+   bool TraceFacts;
+   bool TraceRules;
+   bool TraceActivations;
+   FILE *TraceFile;
+   char *TraceBuffer;
+   unsigned int NextID;
+   struct binaryTraceName **NameTable;
+  };
+
+#define BinaryTraceData(theEnv) ((struct binaryTraceData *) GetEnvironmentData(theEnv,BINARY_TRACE_DATA))
+
+   void                           InitializeBinaryTraceData(Environment *);
+   void                           BinaryTraceFunctionDefinitions(Environment *);
+   bool                           OpenBinaryTrace(Environment *,const char *,bool,bool,bool);
+   bool                           CloseBinaryTrace(Environment *);
+   bool                           DecodeBinaryTrace(Environment *,const char *,const char *);
+   bool                           BinaryTraceActive(Environment *);
+   void                           BinaryTraceFact(Environment *,unsigned char,Fact *);
+   void                           BinaryTraceFiring(Environment *,Activation *,long long);
+   void                           BinaryTraceActivation(Environment *,unsigned char,Activation *);
+   void                           BinaryTraceOnCommand(Environment *,UDFContext *,UDFValue *);
+   void                           BinaryTraceOffCommand(Environment *,UDFContext *,UDFValue *);
+   void                           BinaryTraceDecodeCommand(Environment *,UDFContext *,UDFValue *);
+
+#endif /* _H_bintrace */
@@ -49,6 +49,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: The construct index is invalidated by a binary */
+/*            load or clear.                                 */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -60,6 +63,7 @@
 #include "envrnmnt.h"
 #include "exprnpsr.h"
 #include "memalloc.h"
+#include "modulutl.h"
 #include "prntutil.h"
 #include "router.h"
 #include "utility.h"
@@ -381,6 +385,14 @@ bool Bload(
      }
    FreeAtomicValueStorage(theEnv);
 
+   /*=======================================*/
+   /* The construct lists of the modules    */
+   /* were installed directly, so the index */
+   /* of construct names must be rebuilt.   */
+   /*=======================================*/
+
+   InvalidateConstructIndex(theEnv);
+
    /*==================================*/
    /* Call the list of functions to be */
    /* executed after a bload occurs.   */
@@ -699,6 +711,13 @@ static bool ClearBload(
         biPtr = biPtr->next)
      { if (biPtr->clearFunction != NULL) (*biPtr->clearFunction)(theEnv); }
 
+   /*=====================================*/
+   /* Discard the index of the constructs */
+   /* in the binary image.                */
+   /*=====================================*/
+
+   InvalidateConstructIndex(theEnv);
+
    /*===========================*/
    /* Free bloaded expressions. */
    /*===========================*/
@@ -51,6 +51,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: The slot accessor cache is cleared when        */
+/*            handlers or class ids change.                  */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -83,6 +86,7 @@
 #include "memalloc.h"
 #include "modulutl.h"
 #include "msgfun.h"
+#include "msgpass.h"
 #include "prntutil.h"
 #include "router.h"
 #include "scanner.h"
@@ -617,6 +621,7 @@ void AssignClassID(
      }
    DefclassData(theEnv)->ClassIDMap[DefclassData(theEnv)->MaxClassID] = cls;
    cls->id = DefclassData(theEnv)->MaxClassID++;
+   ClearSlotAccessorCache(theEnv);
   }
 
 /*********************************************************
@@ -1319,6 +1324,7 @@ static void DeassignClassID(
    unsigned short oldChunk = 0,newChunk = 0;
 
    DefclassData(theEnv)->ClassIDMap[id] = NULL;
+   ClearSlotAccessorCache(theEnv);
    for (i = id + 1 ; i < DefclassData(theEnv)->MaxClassID ; i++)
      if (DefclassData(theEnv)->ClassIDMap[i] != NULL)
        return;
@@ -59,6 +59,13 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: FindNamedConstructInModule uses the construct  */
+/*            index instead of searching the module's        */
+/*            construct list.                                */
+/*                                                           */
+/*            Compressed pretty print forms are expanded     */
+/*            when retrieved.                                */
+/*                                                           */
 /*************************************************************/
 
 #include <string.h>
@@ -72,6 +79,7 @@
 #include "moduldef.h"
 #include "argacces.h"
 #include "multifld.h"
+#include "pprint.h"
 #include "modulutl.h"
 #include "prntutil.h"
 #include "router.h"
@@ -119,6 +127,8 @@ void AddConstructToModule(
 
    theConstruct->whichModule->lastItem = theConstruct;
    theConstruct->next = NULL;
+
+   AddConstructToIndex(theConstruct->env,theConstruct);
   }
 
 #endif /* (! RUN_TIME) */
@@ -280,19 +290,19 @@ ConstructHeader *FindNamedConstructInModule(
       return NULL;
      }
 
-   /*===============================================*/
-   /* Loop through every construct of the specified */
-   /* class in the current module checking to see   */
-   /* if the construct's name matches the construct */
-   /* being sought. If found, restore the current   */
-   /* module and return a pointer to the construct. */
-   /*===============================================*/
+   /*================================================*/
+   /* If the current module has any constructs of    */
+   /* the specified class, look up the construct's   */
+   /* name in the construct index for the module's   */
+   /* list of constructs. If found, restore the      */
+   /* current module and return the construct.       */
+   /*================================================*/
 
-   for (theConstruct = (*constructClass->getNextItemFunction)(theEnv,NULL);
-        theConstruct != NULL;
-        theConstruct = (*constructClass->getNextItemFunction)(theEnv,theConstruct))
+   theConstruct = (*constructClass->getNextItemFunction)(theEnv,NULL);
+   if (theConstruct != NULL)
      {
-      if (findValue == (*constructClass->getConstructNameFunction)(theConstruct))
+      theConstruct = FindIndexedConstruct(theEnv,theConstruct->whichModule,findValue);
+      if (theConstruct != NULL)
         {
          RestoreCurrentModule(theEnv);
          return theConstruct;
@@ -1161,7 +1171,7 @@ struct defmoduleItemHeader *GetConstructModuleItem(
 const char *GetConstructPPForm(
   ConstructHeader *theConstruct)
   {
-   return theConstruct->ppForm;
+   return ExpandPPForm(theConstruct->env,theConstruct->ppForm);
   }
 
 /****************************************************/
@@ -53,6 +53,9 @@
 /*                                                           */
 /*            Removed initial-fact support.                  */
 /*                                                           */
+/*      6.50: Deffacts aren't asserted when a reset restores */
+/*            a reset snapshot.                              */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -74,6 +77,7 @@
 #include "memalloc.h"
 #include "multifld.h"
 #include "router.h"
+#include "rsetsnap.h"
 #include "scanner.h"
 #include "tmpltdef.h"
 
@@ -133,6 +137,10 @@ static void ResetDeffacts(
   Environment *theEnv,
   void *context)
   {
+#if DEFRULE_CONSTRUCT && DEFTEMPLATE_CONSTRUCT
+   if (ResetSnapshotRestored(theEnv)) return;
+#endif
+
    DoForAllConstructs(theEnv,
                       ResetDeffactsAction,
                       DeffactsData(theEnv)->DeffactsModuleIndex,
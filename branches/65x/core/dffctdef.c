@@ -46,6 +46,9 @@
 /*                                                           */
 /*            ALLOW_ENVIRONMENT_GLOBALS no longer supported. */
 /*                                                           */
+/*      6.50: Adding or removing a deffacts discards the     */
+/*            reset snapshot.                                */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -58,6 +61,7 @@
 #include "dffctpsr.h"
 #include "envrnmnt.h"
 #include "memalloc.h"
+#include "rsetsnap.h"
 
 #if BLOAD || BLOAD_ONLY || BLOAD_AND_BSAVE
 #include "bload.h"
@@ -327,6 +331,10 @@ static void ReturnDeffacts(
 #if (! BLOAD_ONLY) && (! RUN_TIME)
    if (theDeffacts == NULL) return;
 
+#if DEFRULE_CONSTRUCT && DEFTEMPLATE_CONSTRUCT
+   DiscardResetSnapshot(theEnv);
+#endif
+
    ExpressionDeinstall(theEnv,theDeffacts->assertList);
    ReturnPackedExpression(theEnv,theDeffacts->assertList);
 
@@ -37,6 +37,9 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Adding or removing a deffacts discards the     */
+/*            reset snapshot.                                */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -57,6 +60,7 @@
 #include "pprint.h"
 #include "prntutil.h"
 #include "router.h"
+#include "rsetsnap.h"
 
 #include "dffctpsr.h"
 
@@ -163,6 +167,10 @@ bool ParseDeffacts(
    /* Add the deffacts to the appropriate module. */
    /*=============================================*/
 
+#if DEFRULE_CONSTRUCT && DEFTEMPLATE_CONSTRUCT
+   DiscardResetSnapshot(theEnv);
+#endif
+
    AddConstructToModule(&newDeffacts->header);
 
 #endif /* (! RUN_TIME) && (! BLOAD_ONLY) */
@@ -53,6 +53,9 @@
 /*                                                           */
 /*      6.50: Fact ?var:slot references in deffunctions.     */
 /*                                                           */
+/*            A redefined deffunction already at the end of  */
+/*            its module's list is not removed and re-added. */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -462,6 +465,7 @@ static Deffunction *AddDeffunction(
       dfuncPtr->numberOfLocalVars = lvars;
       dfuncPtr->busy = 0;
       dfuncPtr->executing = 0;
+      AddConstructToModule(&dfuncPtr->header);
      }
    else
      {
@@ -481,13 +485,17 @@ static Deffunction *AddDeffunction(
       /*======================================*/
       /* Remove the deffunction from the list */
       /* so that it can be added at the end.  */
+      /* A deffunction whose header was just  */
+      /* added is already at the end.         */
       /*======================================*/
 
-      RemoveConstructFromModule(theEnv,&dfuncPtr->header);
+      if (dfuncPtr->header.whichModule->lastItem != &dfuncPtr->header)
+        {
+         RemoveConstructFromModule(theEnv,&dfuncPtr->header);
+         AddConstructToModule(&dfuncPtr->header);
+        }
      }
 
-   AddConstructToModule(&dfuncPtr->header);
-
    /*====================================*/
    /* Install the new interpretive code. */
    /*====================================*/
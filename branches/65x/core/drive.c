@@ -47,6 +47,10 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Joins with an empty opposite memory are        */
+/*            skipped without a memory lookup (left and      */
+/*            right unlinking).                              */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -146,6 +150,21 @@ void NetworkAssertRight(
       return;
      }
 
+   /*=====================================================*/
+   /* If the left beta memory of the join is empty, then  */
+   /* there is nothing to compare against. The join is    */
+   /* treated as unlinked from its right input without    */
+   /* locating the hash bucket for the partial match.     */
+   /*=====================================================*/
+
+   if (join->leftMemory->count == 0)
+     {
+#if DEVELOPER
+      EngineData(theEnv)->leftUnlinkedSkips++;
+#endif
+      return;
+     }
+
    /*=====================================================*/
    /* The partial matches entering from the LHS of a join */
    /* are stored in the left beta memory of the join.     */
@@ -393,8 +412,24 @@ void NetworkAssertLeft(
    /* side is being compared to the new partial match. */
    /*==================================================*/
 
+   /*=====================================================*/
+   /* If the right memory of the join is empty, the join  */
+   /* is treated as unlinked from its left input and the  */
+   /* memory lookup is skipped. The partial match is then */
+   /* handled as if no matches were found on the right.   */
+   /*=====================================================*/
+
    entryHashValue = lhsBinds->hashValue;
-   if (join->joinFromTheRight)
+   if (join->joinFromTheRight ?
+       (join->rightMemory->count == 0) :
+       (((struct patternNodeHeader *) join->rightSideEntryStructure)->firstHash == NULL))
+     {
+#if DEVELOPER
+      EngineData(theEnv)->rightUnlinkedSkips++;
+#endif
+      rhsBinds = NULL;
+     }
+   else if (join->joinFromTheRight)
      { rhsBinds = GetRightBetaMemory(join,entryHashValue); }
    else
      { rhsBinds = GetAlphaMemory(theEnv,(struct patternNodeHeader *) join->rightSideEntryStructure,entryHashValue); }
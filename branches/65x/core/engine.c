@@ -85,6 +85,20 @@
 /*            Added CLIPSBlockStart and CLIPSBlockEnd        */
 /*            functions for garbage collection blocks.       */
 /*                                                           */
+/*      6.50: Garbage created by rule firings is swept at    */
+/*            the garbage sweep interval rather than after   */
+/*            every firing.                                  */
+/*                                                           */
+/*            Added unlinked join statistics.                */
+/*                                                           */
+/*            Added rules-fired command.                     */
+/*                                                           */
+/*            Every-cycle salience evaluation only updates   */
+/*            the activations of rules whose salience has    */
+/*            changed.                                       */
+/*                                                           */
+/*            Added binary trace records.                    */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -96,6 +110,7 @@
 
 #include "agenda.h"
 #include "argacces.h"
+#include "bintrace.h"
 #include "commline.h"
 #include "constant.h"
 #include "envrnmnt.h"
@@ -246,6 +261,8 @@ long long Run(
    EngineData(theEnv)->betaHashListSkips = 0;
    EngineData(theEnv)->betaHashHTSkips = 0;
    EngineData(theEnv)->unneededMarkerCompare = 0;
+   EngineData(theEnv)->leftUnlinkedSkips = 0;
+   EngineData(theEnv)->rightUnlinkedSkips = 0;
 #endif
 
    /*=====================================================*/
@@ -306,6 +323,9 @@ long long Run(
          PrintPartialMatch(theEnv,WTRACE,theBasis);
          PrintString(theEnv,WTRACE,"\n");
         }
+
+      if (BinaryTraceData(theEnv)->TraceRules)
+        { BinaryTraceFiring(theEnv,theActivation,rulesFired); }
 #endif
 
       /*=================================================*/
@@ -445,9 +465,14 @@ long long Run(
       /*==================================*/
       /* Get rid of other garbage created */
       /* while executing the rule's RHS.  */
+      /* The sweep is deferred until the  */
+      /* sweep interval or threshold is   */
+      /* reached. Any remaining garbage   */
+      /* is removed when the run's block  */
+      /* ends.                            */
       /*==================================*/
 
-      CleanCurrentGarbageFrame(theEnv,NULL);
+      SweepCurrentGarbageFrame(theEnv,NULL);
       CallPeriodicTasks(theEnv);
 
       /*==========================*/
@@ -478,7 +503,7 @@ long long Run(
       /*==================================*/
 
       if (GetSalienceEvaluation(theEnv) == EVERY_CYCLE)
-        { RefreshAgenda(NULL,theEnv); }
+        { RefreshChangedSaliences(theEnv); }
 
       /*========================================*/
       /* Execute the list of functions that are */
@@ -638,6 +663,14 @@ long long Run(
                           EngineData(theEnv)->unneededMarkerCompare);
       PrintString(theEnv,WDIALOG,printSpace);
 
+      gensprintf(printSpace,"%9ld left unlinked skips.\n",
+                          EngineData(theEnv)->leftUnlinkedSkips);
+      PrintString(theEnv,WDIALOG,printSpace);
+
+      gensprintf(printSpace,"%9ld right unlinked skips.\n",
+                          EngineData(theEnv)->rightUnlinkedSkips);
+      PrintString(theEnv,WDIALOG,printSpace);
+
 #endif
      }
 #endif
@@ -665,9 +698,20 @@ long long Run(
    /*===================================*/
 
    EngineData(theEnv)->AlreadyRunning = false;
+   EngineData(theEnv)->LastRulesFired = rulesFired;
    return rulesFired;
   }
 
+/*******************************************************/
+/* GetLastRulesFired: Returns the number of rules that */
+/*   fired during the most recent call to Run.         */
+/*******************************************************/
+long long GetLastRulesFired(
+  Environment *theEnv)
+  {
+   return EngineData(theEnv)->LastRulesFired;
+  }
+
 /***********************************************************/
 /* NextActivationToFire: Returns the next activation which */
 /*   should be executed based on the current focus.        */
@@ -1007,6 +1051,19 @@ void RunCommand(
    Run(theEnv,runLimit);
   }
 
+/**************************************************/
+/* RulesFiredCommand: H/L access routine for the  */
+/*   rules-fired command. Returns the number of   */
+/*   rules fired by the most recent run command.  */
+/**************************************************/
+void RulesFiredCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   returnValue->integerValue = CreateInteger(theEnv,GetLastRulesFired(theEnv));
+  }
+
 /***********************************************/
 /* HaltCommand: Causes rule execution to halt. */
 /***********************************************/
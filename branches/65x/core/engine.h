@@ -72,6 +72,10 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added unlinked join statistics.                */
+/*                                                           */
+/*            Added rules-fired command.                     */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_engine
@@ -119,6 +123,7 @@ struct engineData
    struct partialMatch *GarbagePartialMatches;
    struct alphaMatch *GarbageAlphaMatches;
    bool AlreadyRunning;
+   long long LastRulesFired;
 #if DEVELOPER
    long leftToRightComparisons;
    long rightToLeftComparisons;
@@ -130,6 +135,8 @@ struct engineData
    long betaHashHTSkips;
    long betaHashListSkips;
    long unneededMarkerCompare;
+   long leftUnlinkedSkips;
+   long rightUnlinkedSkips;
 #endif
   };
 
@@ -138,6 +145,7 @@ struct engineData
 #define MAX_PATTERNS_CHECKED 64
 
    long long               Run(Environment *,long long);
+   long long               GetLastRulesFired(Environment *);
    bool                    AddAfterRuleFiresFunction(Environment *,const char *,
                                                      VoidCallFunction *,int,void *);
    bool                    RemoveAfterRuleFiresFunction(Environment *,const char *);
@@ -152,6 +160,7 @@ struct engineData
    void                    ShowBreaks(Environment *,const char *,Defmodule *);
    bool                    DefruleHasBreakpoint(Defrule *);
    void                    RunCommand(Environment *,UDFContext *,UDFValue *);
+   void                    RulesFiredCommand(Environment *,UDFContext *,UDFValue *);
    void                    SetBreakCommand(Environment *,UDFContext *,UDFValue *);
    void                    RemoveBreakCommand(Environment *,UDFContext *,UDFValue *);
    void                    ShowBreaksCommand(Environment *,UDFContext *,UDFValue *);
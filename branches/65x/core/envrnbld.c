@@ -17,6 +17,8 @@
 /*      6.40: Added to separate environment creation and     */
 /*            deletion code.                                 */
 /*                                                           */
+/*      6.50: Added binary trace records.                    */
+/*                                                           */
 /*************************************************************/
 
 #include <stdlib.h>
@@ -25,6 +27,7 @@
 
 #include "setup.h"
 
+#include "bintrace.h"
 #include "bmathfun.h"
 #include "commline.h"
 #include "emathfun.h"
@@ -323,6 +326,7 @@ static void InitializeEnvironment(
    InitializeUtilityData(theEnvironment);
 #if DEBUGGING_FUNCTIONS
    InitializeWatchData(theEnvironment);
+   InitializeBinaryTraceData(theEnvironment);
 #endif
 
    /*===============================================*/
@@ -498,6 +502,7 @@ static void SystemFunctionDefinitions(
 
 #if DEBUGGING_FUNCTIONS
    WatchFunctionDefinitions(theEnv);
+   BinaryTraceFunctionDefinitions(theEnv);
 #endif
 
 #if MULTIFIELD_FUNCTIONS
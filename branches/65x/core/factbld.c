@@ -35,6 +35,9 @@
 /*                                                           */
 /*            Removed initial-fact support.                  */
 /*                                                           */
+/*      6.50: Added EstimateFactPatternMatches for cost-     */
+/*            based join ordering.                           */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -59,6 +62,8 @@
 
 #include "factbld.h"
 
+#define FACT_ESTIMATE_LIMIT 100000
+
 /***************************************/
 /* LOCAL INTERNAL FUNCTION DEFINITIONS */
 /***************************************/
@@ -73,6 +78,7 @@
    static struct patternNodeHeader  *PlaceFactPattern(Environment *,struct lhsParseNode *);
    static struct lhsParseNode       *RemoveUnneededSlots(Environment *,struct lhsParseNode *);
    static void                       FindAndSetDeftemplatePatternNetwork(Environment *,struct factPatternNode *,struct factPatternNode *);
+   static unsigned long              EstimateFactPatternMatches(Environment *,struct lhsParseNode *);
 #endif
 
 /*********************************************************/
@@ -110,6 +116,7 @@ void InitializeFactPatterns(
    newPtr->genComparePNValuesFunction = FactPNVariableComparison;
    newPtr->returnUserDataFunction = NULL;
    newPtr->copyUserDataFunction = NULL;
+   newPtr->estimateMatchesFunction = EstimateFactPatternMatches;
 #else
    newPtr->recognizeFunction = NULL;
    newPtr->parseFunction = NULL;
@@ -126,6 +133,7 @@ void InitializeFactPatterns(
    newPtr->genComparePNValuesFunction = NULL;
    newPtr->returnUserDataFunction = NULL;
    newPtr->copyUserDataFunction = NULL;
+   newPtr->estimateMatchesFunction = NULL;
 #endif
 
    newPtr->markIRPatternFunction = MarkFactPatternForIncrementalReset;
@@ -1027,6 +1035,51 @@ static void ClearPatternMatches(
     }
   }
 
+/**************************************************************/
+/* EstimateFactPatternMatches: Returns the number of facts    */
+/*   currently asserted for the deftemplate associated with a */
+/*   fact pattern (counting stops at FACT_ESTIMATE_LIMIT).    */
+/*   Used by the cost-based ordering of a rule's patterns.    */
+/**************************************************************/
+static unsigned long EstimateFactPatternMatches(
+  Environment *theEnv,
+  struct lhsParseNode *thePattern)
+  {
+   Deftemplate *theDeftemplate;
+   Fact *theFact;
+   unsigned long factCount = 0;
+   int count;
+
+   /*===========================================*/
+   /* The first field of a fact pattern is the  */
+   /* name of the pattern's deftemplate.        */
+   /*===========================================*/
+
+   if ((thePattern->right == NULL) ||
+       (thePattern->right->bottom == NULL) ||
+       (thePattern->right->bottom->pnType != SYMBOL_NODE))
+     { return 0; }
+
+   theDeftemplate = (Deftemplate *)
+                    FindImportedConstruct(theEnv,"deftemplate",NULL,
+                                          thePattern->right->bottom->lexemeValue->contents,
+                                          &count,true,NULL);
+
+   if (theDeftemplate == NULL)
+     { return 0; }
+
+   /*================================*/
+   /* Count the deftemplate's facts. */
+   /*================================*/
+
+   for (theFact = theDeftemplate->factList;
+        (theFact != NULL) && (factCount < FACT_ESTIMATE_LIMIT);
+        theFact = theFact->nextTemplateFact)
+     { factCount++; }
+
+   return factCount;
+  }
+
 #endif /* (! RUN_TIME) && (! BLOAD_ONLY) */
 
 #endif /* DEFTEMPLATE_CONSTRUCT && DEFRULE_CONSTRUCT */
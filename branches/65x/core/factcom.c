@@ -67,6 +67,9 @@
 /*            Watch facts for modify command only prints     */
 /*            changed slots.                                 */
 /*                                                           */
+/*      6.50: Facts are loaded directly from tokens without  */
+/*            building assert expressions.                   */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -109,6 +112,18 @@
 #define INVALID     -2L
 #define UNSPECIFIED -1L
 
+/*************************************************************/
+/* Scratch space for the values of an ordered fact or of a   */
+/* multislot while a fact is read by the load-facts command. */
+/*************************************************************/
+
+struct loadFactBuffer
+  {
+   CLIPSValue *values;
+   size_t count;
+   size_t maximum;
+  };
+
 /***************************************/
 /* LOCAL INTERNAL FUNCTION DEFINITIONS */
 /***************************************/
@@ -117,7 +132,13 @@
 #if DEBUGGING_FUNCTIONS
    static long long               GetFactsArgument(UDFContext *);
 #endif
-   static struct expr            *StandardLoadFact(Environment *,const char *,struct token *);
+   static void                    LoadFactsDriver(Environment *,const char *);
+   static Fact                   *LoadSingleFact(Environment *,const char *,struct token *,struct loadFactBuffer *,bool *);
+   static bool                    LoadFactValues(Environment *,const char *,struct token *,struct loadFactBuffer *);
+   static bool                    LiteralFactToken(struct token *);
+   static void                    AddLoadedValue(Environment *,struct loadFactBuffer *,void *);
+   static Multifield             *LoadedValuesToMultifield(Environment *,struct loadFactBuffer *);
+   static bool                    AssignLoadedFactDefaults(Environment *,Fact *);
    static Deftemplate           **GetSaveFactsDeftemplateNames(Environment *,struct expr *,int,int *,bool *);
 
 /***************************************/
@@ -1132,9 +1153,6 @@ bool LoadFacts(
   const char *fileName)
   {
    FILE *filePtr;
-   struct token theToken;
-   struct expr *testPtr;
-   UDFValue rv;
 
    /*======================================================*/
    /* Open the file. Use either "fast save" or I/O Router. */
@@ -1152,14 +1170,7 @@ bool LoadFacts(
    /* Load the facts. */
    /*=================*/
 
-   theToken.tknType = LEFT_PARENTHESIS_TOKEN;
-   while (theToken.tknType != STOP_TOKEN)
-     {
-      testPtr = StandardLoadFact(theEnv,(char *) filePtr,&theToken);
-      if (testPtr == NULL) theToken.tknType = STOP_TOKEN;
-      else EvaluateExpression(theEnv,testPtr,&rv);
-      ReturnExpression(theEnv,testPtr);
-     }
+   LoadFactsDriver(theEnv,(char *) filePtr);
 
    /*=================*/
    /* Close the file. */
@@ -1186,9 +1197,6 @@ bool LoadFactsFromString(
   long theMax)
   {
    const char *theStrRouter = "*** load-facts-from-string ***";
-   struct token theToken;
-   struct expr *testPtr;
-   UDFValue rv;
 
    /*==========================*/
    /* Initialize string router */
@@ -1202,14 +1210,7 @@ bool LoadFactsFromString(
    /* Load the facts. */
    /*=================*/
 
-   theToken.tknType = LEFT_PARENTHESIS_TOKEN;
-   while (theToken.tknType != STOP_TOKEN)
-     {
-      testPtr = StandardLoadFact(theEnv,theStrRouter,&theToken);
-      if (testPtr == NULL) theToken.tknType = STOP_TOKEN;
-      else EvaluateExpression(theEnv,testPtr,&rv);
-      ReturnExpression(theEnv,testPtr);
-     }
+   LoadFactsDriver(theEnv,theStrRouter);
 
    /*=================*/
    /* Close router.   */
@@ -1226,39 +1227,361 @@ bool LoadFactsFromString(
    return true;
   }
 
-/**************************************************************************/
-/* StandardLoadFact: Loads a single fact from the specified logical name. */
-/**************************************************************************/
-static struct expr *StandardLoadFact(
+/*************************************************************/
+/* LoadFactsDriver: Loads and asserts each fact found in the */
+/*   specified logical name until the end of input is        */
+/*   reached or an error occurs.                             */
+/*************************************************************/
+static void LoadFactsDriver(
+  Environment *theEnv,
+  const char *logicalName)
+  {
+   struct token theToken;
+   struct loadFactBuffer theBuffer = { NULL, 0, 0 };
+   Fact *newFact;
+   bool error, omitPrintForms;
+
+   omitPrintForms = ScannerData(theEnv)->OmitPrintForms;
+
+   while (true)
+     {
+      /*===================================================*/
+      /* The print forms of the tokens aren't needed since */
+      /* the facts are built directly from token values.   */
+      /*===================================================*/
+
+      ScannerData(theEnv)->OmitPrintForms = true;
+      newFact = LoadSingleFact(theEnv,logicalName,&theToken,&theBuffer,&error);
+      ScannerData(theEnv)->OmitPrintForms = omitPrintForms;
+
+      if (newFact != NULL)
+        {
+         IncrementClearReadyLocks(theEnv);
+         if (AssignLoadedFactDefaults(theEnv,newFact))
+           { Assert(theEnv,newFact); }
+         else
+           {
+            ReturnFact(theEnv,newFact);
+            SetEvaluationError(theEnv,true);
+           }
+         DecrementClearReadyLocks(theEnv);
+        }
+      else
+        {
+         if (error)
+           {
+            PrintString(theEnv,WERROR,"Function load-facts encountered an error\n");
+            SetEvaluationError(theEnv,true);
+           }
+         break;
+        }
+     }
+
+   if (theBuffer.values != NULL)
+     { rm(theEnv,theBuffer.values,sizeof(CLIPSValue) * theBuffer.maximum); }
+  }
+
+/**********************************************************/
+/* LoadSingleFact: Loads a single fact from the specified */
+/*   logical name. The facts read by load-facts contain   */
+/*   only constants, so the values are stored directly in */
+/*   a new fact rather than parsing an assert expression  */
+/*   and then evaluating it. Slots without a value are    */
+/*   left void and are assigned their defaults later.     */
+/**********************************************************/
+static Fact *LoadSingleFact(
   Environment *theEnv,
   const char *logicalName,
-  struct token *theToken)
+  struct token *theToken,
+  struct loadFactBuffer *theBuffer,
+  bool *error)
   {
-   bool error = false;
-   struct expr *temp;
+   Deftemplate *theDeftemplate;
+   Fact *newFact;
+   struct templateSlot *slotPtr;
+   CLIPSValue *theField;
+   short position;
+
+   *error = false;
+
+   /*=======================================*/
+   /* A fact begins with a left parenthesis */
+   /* followed by the relation name.        */
+   /*=======================================*/
 
    GetToken(theEnv,logicalName,theToken);
    if (theToken->tknType != LEFT_PARENTHESIS_TOKEN) return NULL;
 
-   temp = GenConstant(theEnv,FCALL,FindFunction(theEnv,"assert"));
-   temp->argList = GetRHSPattern(theEnv,logicalName,theToken,&error,
-                                  true,false,true,RIGHT_PARENTHESIS_TOKEN);
-
-   if (error == true)
+   theDeftemplate = GetRHSPatternDeftemplate(theEnv,logicalName,theToken,error);
+   if (theDeftemplate == NULL)
      {
-      PrintString(theEnv,WERROR,"Function load-facts encountered an error\n");
-      SetEvaluationError(theEnv,true);
-      ReturnExpression(theEnv,temp);
+      *error = true;
       return NULL;
      }
 
-   if (ExpressionContainsVariables(temp,true))
+   /*==========================================*/
+   /* An ordered fact stores its values in the */
+   /* implied multifield slot.                 */
+   /*==========================================*/
+
+   if (theDeftemplate->implied)
      {
-      ReturnExpression(theEnv,temp);
-      return NULL;
+      if (! LoadFactValues(theEnv,logicalName,theToken,theBuffer))
+        {
+         SyntaxErrorMessage(theEnv,"RHS patterns");
+         *error = true;
+         return NULL;
+        }
+
+      newFact = CreateFactBySize(theEnv,1);
+      newFact->whichDeftemplate = theDeftemplate;
+      newFact->theProposition.contents[0].multifieldValue = LoadedValuesToMultifield(theEnv,theBuffer);
+      return newFact;
+     }
+
+   /*======================================*/
+   /* Otherwise store the value (or values */
+   /* for a multislot) of each slot.       */
+   /*======================================*/
+
+   newFact = CreateFact(theEnv,theDeftemplate);
+   theField = newFact->theProposition.contents;
+
+   while (true)
+     {
+      GetToken(theEnv,logicalName,theToken);
+      if (theToken->tknType == RIGHT_PARENTHESIS_TOKEN) break;
+
+      if (theToken->tknType != LEFT_PARENTHESIS_TOKEN)
+        {
+         SyntaxErrorMessage(theEnv,"deftemplate pattern");
+         goto LoadError;
+        }
+
+      GetToken(theEnv,logicalName,theToken);
+      if (theToken->tknType != SYMBOL_TOKEN)
+        {
+         SyntaxErrorMessage(theEnv,"deftemplate pattern");
+         goto LoadError;
+        }
+
+      if ((slotPtr = FindSlot(theDeftemplate,theToken->lexemeValue,&position)) == NULL)
+        {
+         InvalidDeftemplateSlotMessage(theEnv,theToken->lexemeValue->contents,
+                                       theDeftemplate->header.name->contents,true);
+         goto LoadError;
+        }
+
+      position--;
+      if (theField[position].value != VoidConstant(theEnv))
+        {
+         AlreadyParsedErrorMessage(theEnv,"slot ",slotPtr->slotName->contents);
+         goto LoadError;
+        }
+
+      if (slotPtr->multislot)
+        {
+         if (! LoadFactValues(theEnv,logicalName,theToken,theBuffer))
+           {
+            SyntaxErrorMessage(theEnv,"deftemplate pattern");
+            goto LoadError;
+           }
+
+         if (! CheckLiteralSlotValues(theEnv,theBuffer->values,theBuffer->count,slotPtr,"assert"))
+           { goto LoadError; }
+
+         theField[position].multifieldValue = LoadedValuesToMultifield(theEnv,theBuffer);
+        }
+      else
+        {
+         GetToken(theEnv,logicalName,theToken);
+         if (theToken->tknType == RIGHT_PARENTHESIS_TOKEN)
+           {
+            SingleFieldSlotCardinalityError(theEnv,slotPtr->slotName->contents);
+            goto LoadError;
+           }
+
+         if (! LiteralFactToken(theToken))
+           {
+            SyntaxErrorMessage(theEnv,"deftemplate pattern");
+            goto LoadError;
+           }
+
+         theBuffer->count = 0;
+         AddLoadedValue(theEnv,theBuffer,theToken->value);
+
+         GetToken(theEnv,logicalName,theToken);
+         if (theToken->tknType != RIGHT_PARENTHESIS_TOKEN)
+           {
+            SingleFieldSlotCardinalityError(theEnv,slotPtr->slotName->contents);
+            goto LoadError;
+           }
+
+         if (! CheckLiteralSlotValues(theEnv,theBuffer->values,1,slotPtr,"assert"))
+           { goto LoadError; }
+
+         theField[position].value = theBuffer->values[0].value;
+        }
      }
 
-   return(temp);
+   /*====================================================*/
+   /* Slots with a (default ?NONE) attribute must be     */
+   /* given a value. Other slots without a value are     */
+   /* assigned their default once parsing is complete.   */
+   /*====================================================*/
+
+   for (slotPtr = theDeftemplate->slotList, position = 0;
+        slotPtr != NULL;
+        slotPtr = slotPtr->next, position++)
+     {
+      if ((theField[position].value == VoidConstant(theEnv)) && slotPtr->noDefault)
+        {
+         RequiredSlotValueError(theEnv,slotPtr->slotName->contents);
+         goto LoadError;
+        }
+     }
+
+   return newFact;
+
+LoadError:
+   ReturnFact(theEnv,newFact);
+   *error = true;
+   return NULL;
+  }
+
+/***************************************************************/
+/* LoadFactValues: Reads the literal values of an ordered fact */
+/*   or a multislot into the load buffer up to the closing     */
+/*   right parenthesis. Returns false if a token other than a  */
+/*   literal value is encountered.                             */
+/***************************************************************/
+static bool LoadFactValues(
+  Environment *theEnv,
+  const char *logicalName,
+  struct token *theToken,
+  struct loadFactBuffer *theBuffer)
+  {
+   theBuffer->count = 0;
+
+   GetToken(theEnv,logicalName,theToken);
+   while (theToken->tknType != RIGHT_PARENTHESIS_TOKEN)
+     {
+      if (! LiteralFactToken(theToken)) return false;
+      AddLoadedValue(theEnv,theBuffer,theToken->value);
+      GetToken(theEnv,logicalName,theToken);
+     }
+
+   return true;
+  }
+
+/**********************************************************/
+/* LiteralFactToken: Returns true if the token is one of  */
+/*   the literal values allowed in the facts read by the  */
+/*   load-facts command.                                  */
+/**********************************************************/
+static bool LiteralFactToken(
+  struct token *theToken)
+  {
+   switch (theToken->tknType)
+     {
+      case SYMBOL_TOKEN:
+        return (strcmp(theToken->lexemeValue->contents,"=") != 0);
+
+      case STRING_TOKEN:
+      case FLOAT_TOKEN:
+      case INTEGER_TOKEN:
+#if OBJECT_SYSTEM
+      case INSTANCE_NAME_TOKEN:
+#endif
+        return true;
+
+      default:
+        return false;
+     }
+  }
+
+/******************************************************/
+/* AddLoadedValue: Adds a value to the load buffer,   */
+/*   doubling the size of the buffer when it is full. */
+/******************************************************/
+static void AddLoadedValue(
+  Environment *theEnv,
+  struct loadFactBuffer *theBuffer,
+  void *theValue)
+  {
+   size_t newMaximum;
+
+   if (theBuffer->count == theBuffer->maximum)
+     {
+      newMaximum = (theBuffer->maximum == 0) ? 16 : (theBuffer->maximum * 2);
+      theBuffer->values = (CLIPSValue *)
+                          genrealloc(theEnv,theBuffer->values,
+                                     sizeof(CLIPSValue) * theBuffer->maximum,
+                                     sizeof(CLIPSValue) * newMaximum);
+      theBuffer->maximum = newMaximum;
+     }
+
+   theBuffer->values[theBuffer->count++].value = theValue;
+  }
+
+/*************************************************************/
+/* LoadedValuesToMultifield: Creates an unmanaged multifield */
+/*   containing the values stored in the load buffer.        */
+/*************************************************************/
+static Multifield *LoadedValuesToMultifield(
+  Environment *theEnv,
+  struct loadFactBuffer *theBuffer)
+  {
+   Multifield *theMultifield;
+   size_t i;
+
+   theMultifield = CreateUnmanagedMultifield(theEnv,theBuffer->count);
+   for (i = 0; i < theBuffer->count; i++)
+     { theMultifield->contents[i].value = theBuffer->values[i].value; }
+
+   return theMultifield;
+  }
+
+/****************************************************************/
+/* AssignLoadedFactDefaults: Assigns the default value of each  */
+/*   slot of a loaded fact which was not given a value. Mirrors */
+/*   the evaluation of the defaults by the assert command.      */
+/****************************************************************/
+static bool AssignLoadedFactDefaults(
+  Environment *theEnv,
+  Fact *theFact)
+  {
+   Deftemplate *theDeftemplate = theFact->whichDeftemplate;
+   struct templateSlot *slotPtr;
+   CLIPSValue *theField = theFact->theProposition.contents;
+   UDFValue theValue;
+   unsigned short i;
+
+   if (theDeftemplate->implied) return true;
+
+   for (slotPtr = theDeftemplate->slotList, i = 0;
+        slotPtr != NULL;
+        slotPtr = slotPtr->next, i++)
+     {
+      if (theField[i].value != VoidConstant(theEnv)) continue;
+
+      if (slotPtr->defaultDynamic)
+        {
+         EvaluateAndStoreInDataObject(theEnv,slotPtr->multislot,
+                                      (Expression *) slotPtr->defaultList,&theValue,false);
+         if ((slotPtr->multislot == false) && (theValue.header->type == MULTIFIELD_TYPE))
+           {
+            MultiIntoSingleFieldSlotError(theEnv,slotPtr,theDeftemplate);
+            return false;
+           }
+        }
+      else
+        { DeftemplateSlotDefault(theEnv,theDeftemplate,slotPtr,&theValue,false); }
+
+      theField[i].value = theValue.value;
+     }
+
+   return true;
   }
 
 /****************************************************************/
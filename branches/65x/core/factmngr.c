@@ -87,6 +87,8 @@
 /*            Assert returns duplicate fact. FALSE is now    */
 /*            returned only if an error occurs.              */
 /*                                                           */
+/*      6.50: Added binary trace records.                    */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -95,6 +97,7 @@
 
 #if DEFTEMPLATE_CONSTRUCT && DEFRULE_CONSTRUCT
 
+#include "bintrace.h"
 #include "commline.h"
 #include "default.h"
 #include "engine.h"
@@ -555,6 +558,9 @@ bool RetractDriver(
       PrintFactWithIdentifier(theEnv,WTRACE,theFact,changeMap);
       PrintString(theEnv,WTRACE,"\n");
      }
+
+   if (BinaryTraceData(theEnv)->TraceFacts)
+     { BinaryTraceFact(theEnv,BINARY_TRACE_RETRACT,theFact); }
 #endif
 
    /*==================================*/
@@ -928,6 +934,9 @@ Fact *AssertDriver(
       PrintFactWithIdentifier(theEnv,WTRACE,theFact,changeMap);
       PrintString(theEnv,WTRACE,"\n");
      }
+
+   if (BinaryTraceData(theEnv)->TraceFacts)
+     { BinaryTraceFact(theEnv,BINARY_TRACE_ASSERT,theFact); }
 #endif
 
    /*==================================*/
@@ -1390,6 +1399,7 @@ Fact *CreateFactBySize(
    else newSize = size;
 
    theFact = get_var_struct(theEnv,fact,sizeof(struct clipsValue) * (newSize - 1));
+   UpdateSubsystemMemory(theEnv,FACT_MEMORY,(long) (sizeof(struct fact) + (sizeof(struct clipsValue) * (newSize - 1))));
 
    theFact->patternHeader.header.type = FACT_ADDRESS_TYPE;
    theFact->garbage = false;
@@ -1439,6 +1449,7 @@ void ReturnFact(
    if (theFact->theProposition.length == 0) newSize = 1;
    else newSize = theFact->theProposition.length;
 
+   UpdateSubsystemMemory(theEnv,FACT_MEMORY,- (long) (sizeof(struct fact) + (sizeof(struct clipsValue) * (size_t) (newSize - 1))));
    rtn_var_struct(theEnv,fact,sizeof(struct clipsValue) * (newSize - 1),theFact);
   }
 
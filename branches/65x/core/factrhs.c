@@ -47,6 +47,8 @@
 /*                                                           */
 /*            Eval support for run time and bload only.      */
 /*                                                           */
+/*      6.50: Added GetRHSPatternDeftemplate.                */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -224,9 +226,7 @@ struct expr *GetRHSPattern(
    struct expr *lastOne = NULL;
    struct expr *nextOne, *firstOne, *argHead = NULL;
    bool printError;
-   int count;
    Deftemplate *theDeftemplate;
-   CLIPSLexeme *templateName;
    const char *nullBitMap = "\0";
 
    /*=================================================*/
@@ -249,6 +249,124 @@ struct expr *GetRHSPattern(
         }
      }
 
+   /*=====================================================*/
+   /* Get the deftemplate associated with the relation    */
+   /* name, creating an implied deftemplate if necessary. */
+   /*=====================================================*/
+
+   theDeftemplate = GetRHSPatternDeftemplate(theEnv,readSource,tempToken,error);
+   if (*error) return NULL;
+
+   /*=========================================*/
+   /* If an explicit deftemplate exists, then */
+   /* parse the fact as a deftemplate fact.   */
+   /*=========================================*/
+
+   if ((theDeftemplate != NULL) && (theDeftemplate->implied == false))
+     {
+      firstOne = GenConstant(theEnv,DEFTEMPLATE_PTR,theDeftemplate);
+      firstOne->nextArg = ParseAssertTemplate(theEnv,readSource,tempToken,
+                                              error,endType,
+                                              constantsOnly,theDeftemplate);
+
+#if (! RUN_TIME) && (! BLOAD_ONLY)
+      if (! ConstructData(theEnv)->ParsingConstruct)
+        { ConstructData(theEnv)->DanglingConstructs++; }
+#endif
+
+      if (*error)
+        {
+         ReturnExpression(theEnv,firstOne);
+         firstOne = NULL;
+        }
+
+      return(firstOne);
+     }
+
+   /*========================================*/
+   /* Parse the fact as an ordered RHS fact. */
+   /*========================================*/
+
+   firstOne = GenConstant(theEnv,DEFTEMPLATE_PTR,theDeftemplate);
+
+#if (! RUN_TIME) && (! BLOAD_ONLY)
+   if (! ConstructData(theEnv)->ParsingConstruct)
+     { ConstructData(theEnv)->DanglingConstructs++; }
+#endif
+
+#if (! RUN_TIME) && (! BLOAD_ONLY)
+   SavePPBuffer(theEnv," ");
+#endif
+
+   while ((nextOne = GetAssertArgument(theEnv,readSource,tempToken,
+                                        error,endType,constantsOnly,&printError)) != NULL)
+     {
+      if (argHead == NULL) argHead = nextOne;
+      else lastOne->nextArg = nextOne;
+      lastOne = nextOne;
+#if (! RUN_TIME) && (! BLOAD_ONLY)
+      SavePPBuffer(theEnv," ");
+#endif
+     }
+
+   /*===========================================================*/
+   /* If an error occurred, set the error flag and return NULL. */
+   /*===========================================================*/
+
+   if (*error)
+     {
+      if (printError) SyntaxErrorMessage(theEnv,"RHS patterns");
+      ReturnExpression(theEnv,firstOne);
+      ReturnExpression(theEnv,argHead);
+      return NULL;
+     }
+
+   /*=====================================*/
+   /* Fix the pretty print representation */
+   /* of the RHS ordered fact.            */
+   /*=====================================*/
+
+#if (! RUN_TIME) && (! BLOAD_ONLY)
+   PPBackup(theEnv);
+   PPBackup(theEnv);
+   SavePPBuffer(theEnv,tempToken->printForm);
+#endif
+
+   /*==========================================================*/
+   /* Ordered fact assertions are processed by stuffing all of */
+   /* the fact's proposition (except the relation name) into a */
+   /* single multifield slot.                                  */
+   /*==========================================================*/
+
+   firstOne->nextArg = GenConstant(theEnv,FACT_STORE_MULTIFIELD,AddBitMap(theEnv,(void *) nullBitMap,1));
+   firstOne->nextArg->argList = argHead;
+
+   /*==============================*/
+   /* Return the RHS ordered fact. */
+   /*==============================*/
+
+   return(firstOne);
+  }
+
+/*******************************************************************/
+/* GetRHSPatternDeftemplate: Parses the relation name of a RHS     */
+/*   pattern and returns the deftemplate associated with it. If no */
+/*   deftemplate exists with the relation name, then an implied    */
+/*   deftemplate is created. In the event of a parse error, the    */
+/*   error flag passed as an argument is set.                      */
+/*******************************************************************/
+Deftemplate *GetRHSPatternDeftemplate(
+  Environment *theEnv,
+  const char *readSource,
+  struct token *tempToken,
+  bool *error)
+  {
+   Deftemplate *theDeftemplate;
+   CLIPSLexeme *templateName;
+   int count;
+
+   *error = false;
+
    /*======================================================*/
    /* The first field of an asserted fact must be a symbol */
    /* (but not = or : which have special significance).    */
@@ -294,11 +412,9 @@ struct expr *GetRHSPattern(
       return NULL;
      }
 
-   /*=============================================================*/
-   /* Determine if there is an associated deftemplate. If so, let */
-   /* the deftemplate parsing functions parse the RHS pattern and */
-   /* then return the fact pattern that was parsed.               */
-   /*=============================================================*/
+   /*==================================================*/
+   /* Determine if there is an associated deftemplate. */
+   /*==================================================*/
 
    theDeftemplate = (Deftemplate *)
                     FindImportedConstruct(theEnv,"deftemplate",NULL,templateName->contents,
@@ -346,95 +462,7 @@ struct expr *GetRHSPattern(
     }
 #endif
 
-   /*=========================================*/
-   /* If an explicit deftemplate exists, then */
-   /* parse the fact as a deftemplate fact.   */
-   /*=========================================*/
-
-   if ((theDeftemplate != NULL) && (theDeftemplate->implied == false))
-     {
-      firstOne = GenConstant(theEnv,DEFTEMPLATE_PTR,theDeftemplate);
-      firstOne->nextArg = ParseAssertTemplate(theEnv,readSource,tempToken,
-                                              error,endType,
-                                              constantsOnly,theDeftemplate);
-
-#if (! RUN_TIME) && (! BLOAD_ONLY)
-      if (! ConstructData(theEnv)->ParsingConstruct)
-        { ConstructData(theEnv)->DanglingConstructs++; }
-#endif
-
-      if (*error)
-        {
-         ReturnExpression(theEnv,firstOne);
-         firstOne = NULL;
-        }
-
-      return(firstOne);
-     }
-
-   /*========================================*/
-   /* Parse the fact as an ordered RHS fact. */
-   /*========================================*/
-
-   firstOne = GenConstant(theEnv,DEFTEMPLATE_PTR,theDeftemplate);
-
-#if (! RUN_TIME) && (! BLOAD_ONLY)
-   if (! ConstructData(theEnv)->ParsingConstruct)
-     { ConstructData(theEnv)->DanglingConstructs++; }
-#endif
-
-#if (! RUN_TIME) && (! BLOAD_ONLY)
-   SavePPBuffer(theEnv," ");
-#endif
-
-   while ((nextOne = GetAssertArgument(theEnv,readSource,tempToken,
-                                        error,endType,constantsOnly,&printError)) != NULL)
-     {
-      if (argHead == NULL) argHead = nextOne;
-      else lastOne->nextArg = nextOne;
-      lastOne = nextOne;
-#if (! RUN_TIME) && (! BLOAD_ONLY)
-      SavePPBuffer(theEnv," ");
-#endif
-     }
-
-   /*===========================================================*/
-   /* If an error occurred, set the error flag and return NULL. */
-   /*===========================================================*/
-
-   if (*error)
-     {
-      if (printError) SyntaxErrorMessage(theEnv,"RHS patterns");
-      ReturnExpression(theEnv,firstOne);
-      ReturnExpression(theEnv,argHead);
-      return NULL;
-     }
-
-   /*=====================================*/
-   /* Fix the pretty print representation */
-   /* of the RHS ordered fact.            */
-   /*=====================================*/
-
-#if (! RUN_TIME) && (! BLOAD_ONLY)
-   PPBackup(theEnv);
-   PPBackup(theEnv);
-   SavePPBuffer(theEnv,tempToken->printForm);
-#endif
-
-   /*==========================================================*/
-   /* Ordered fact assertions are processed by stuffing all of */
-   /* the fact's proposition (except the relation name) into a */
-   /* single multifield slot.                                  */
-   /*==========================================================*/
-
-   firstOne->nextArg = GenConstant(theEnv,FACT_STORE_MULTIFIELD,AddBitMap(theEnv,(void *) nullBitMap,1));
-   firstOne->nextArg->argList = argHead;
-
-   /*==============================*/
-   /* Return the RHS ordered fact. */
-   /*==============================*/
-
-   return(firstOne);
+   return theDeftemplate;
   }
 
 /********************************************************************/
@@ -32,6 +32,8 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added GetRHSPatternDeftemplate.                */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_factrhs
@@ -49,6 +51,7 @@
    struct expr                   *GetAssertArgument(Environment *,const char *,struct token *,bool *,TokenType,bool,bool *);
    struct expr                   *GetRHSPattern(Environment*,const char *,struct token *,bool *,bool,
                                                        bool,bool,TokenType);
+   Deftemplate                   *GetRHSPatternDeftemplate(Environment *,const char *,struct token *,bool *);
    Fact                          *StringToFact(Environment *,const char *);
 
 #endif /* _H_factrhs */
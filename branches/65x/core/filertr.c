@@ -49,6 +49,13 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added OpenBufferedFile, FlushFile, and         */
+/*            FlushAllFiles. Output to a buffered file isn't */
+/*            flushed after each print request.              */
+/*                                                           */
+/*            The size of a file buffer is limited to        */
+/*            MAXIMUM_FILE_BUFFER_SIZE.                      */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -73,6 +80,8 @@
    static int                     GetcFile(Environment *,const char *,void *);
    static int                     UngetcFile(Environment *,const char *,int,void *);
    static void                    DeallocateFileRouterData(Environment *);
+   static struct fileRouter      *FindFileRouter(Environment *,const char *);
+   static void                    ReturnFileRouter(Environment *,struct fileRouter *);
 
 /***************************************************************/
 /* InitializeFileRouter: Initializes file input/output router. */
@@ -100,13 +109,63 @@ static void DeallocateFileRouterData(
    while (tmpPtr != NULL)
      {
       nextPtr = tmpPtr->next;
-      GenClose(theEnv,tmpPtr->stream);
-      rm(theEnv,(void *) tmpPtr->logicalName,strlen(tmpPtr->logicalName) + 1);
-      rtn_struct(theEnv,fileRouter,tmpPtr);
+      ReturnFileRouter(theEnv,tmpPtr);
       tmpPtr = nextPtr;
      }
   }
 
+/*******************************************************/
+/* ReturnFileRouter: Closes the stream of a file       */
+/*   router, writing any buffered output, and returns  */
+/*   the file router to the pool of free memory.       */
+/*******************************************************/
+static void ReturnFileRouter(
+  Environment *theEnv,
+  struct fileRouter *theRouter)
+  {
+   if (FileRouterData(theEnv)->LastFileRouter == theRouter)
+     { FileRouterData(theEnv)->LastFileRouter = NULL; }
+
+   GenClose(theEnv,theRouter->stream);
+
+   if (theRouter->buffer != NULL)
+     { genfree(theEnv,theRouter->buffer,theRouter->bufferSize); }
+
+   rm(theEnv,(void *) theRouter->logicalName,strlen(theRouter->logicalName) + 1);
+   rtn_struct(theEnv,fileRouter,theRouter);
+  }
+
+/******************************************************/
+/* FindFileRouter: Returns the file router for a      */
+/*   logical name opened with the open function, or   */
+/*   NULL if there is none. The router most recently  */
+/*   found is checked first since output to a file is */
+/*   usually done with a series of print requests.    */
+/******************************************************/
+static struct fileRouter *FindFileRouter(
+  Environment *theEnv,
+  const char *logicalName)
+  {
+   struct fileRouter *fptr;
+
+   fptr = FileRouterData(theEnv)->LastFileRouter;
+   if ((fptr != NULL) && (strcmp(logicalName,fptr->logicalName) == 0))
+     { return fptr; }
+
+   for (fptr = FileRouterData(theEnv)->ListOfFileRouters;
+        fptr != NULL;
+        fptr = fptr->next)
+     {
+      if (strcmp(logicalName,fptr->logicalName) == 0)
+        {
+         FileRouterData(theEnv)->LastFileRouter = fptr;
+         return fptr;
+        }
+     }
+
+   return NULL;
+  }
+
 /*****************************************/
 /* FindFptr: Returns a pointer to a file */
 /*   stream for a given logical name.    */
@@ -142,9 +201,7 @@ FILE *FindFptr(
    /* Otherwise, look up the logical name on the global file list. */
    /*==============================================================*/
 
-   fptr = FileRouterData(theEnv)->ListOfFileRouters;
-   while ((fptr != NULL) ? (strcmp(logicalName,fptr->logicalName) != 0) : false)
-     { fptr = fptr->next; }
+   fptr = FindFileRouter(theEnv,logicalName);
 
    if (fptr != NULL) return(fptr->stream);
 
@@ -198,6 +255,21 @@ static void PrintFile(
   void *context)
   {
    FILE *fptr;
+   struct fileRouter *theRouter;
+
+   /*=================================================*/
+   /* Output to a file opened with a buffer is left   */
+   /* in the buffer until it's full or the file is    */
+   /* flushed or closed. Otherwise, the output is     */
+   /* flushed after each print request.               */
+   /*=================================================*/
+
+   theRouter = FindFileRouter(theEnv,logicalName);
+   if ((theRouter != NULL) && (theRouter->buffer != NULL))
+     {
+      fprintf(theRouter->stream,"%s",str);
+      return;
+     }
 
    fptr = FindFptr(theEnv,logicalName);
 
@@ -262,6 +334,24 @@ bool OpenAFile(
   const char *fileName,
   const char *accessMode,
   const char *logicalName)
+  {
+   return OpenBufferedFile(theEnv,fileName,accessMode,logicalName,0);
+  }
+
+/**********************************************************/
+/* OpenBufferedFile: Opens a file as OpenAFile does. If   */
+/*   the buffer size is greater than zero and the file is */
+/*   opened only for output, output to the file is held   */
+/*   in a buffer of that size rather than being flushed   */
+/*   after each print request. Sizes larger than          */
+/*   MAXIMUM_FILE_BUFFER_SIZE are reduced to that size.   */
+/**********************************************************/
+bool OpenBufferedFile(
+  Environment *theEnv,
+  const char *fileName,
+  const char *accessMode,
+  const char *logicalName,
+  size_t bufferSize)
   {
    FILE *newstream;
    struct fileRouter *newRouter;
@@ -284,6 +374,25 @@ bool OpenAFile(
    genstrcpy(theName,logicalName);
    newRouter->logicalName = theName;
    newRouter->stream = newstream;
+   newRouter->buffer = NULL;
+   newRouter->bufferSize = 0;
+
+   /*===============================================*/
+   /* The buffer must be assigned before any output */
+   /* is written to the stream.                     */
+   /*===============================================*/
+
+   if (bufferSize > MAXIMUM_FILE_BUFFER_SIZE)
+     { bufferSize = MAXIMUM_FILE_BUFFER_SIZE; }
+
+   if ((bufferSize > 0) &&
+       (strchr(accessMode,'r') == NULL) &&
+       (strchr(accessMode,'+') == NULL))
+     {
+      newRouter->buffer = (char *) genalloc(theEnv,bufferSize);
+      newRouter->bufferSize = bufferSize;
+      setvbuf(newstream,newRouter->buffer,_IOFBF,bufferSize);
+     }
 
    /*==========================================*/
    /* Add the newly opened file to the list of */
@@ -293,6 +402,8 @@ bool OpenAFile(
    newRouter->next = FileRouterData(theEnv)->ListOfFileRouters;
    FileRouterData(theEnv)->ListOfFileRouters = newRouter;
 
+   InvalidateRouterCache(theEnv);
+
    /*==================================*/
    /* Return true to indicate the file */
    /* was opened successfully.         */
@@ -318,13 +429,12 @@ bool CloseFile(
      {
       if (strcmp(fptr->logicalName,fid) == 0)
         {
-         GenClose(theEnv,fptr->stream);
-         rm(theEnv,(void *) fptr->logicalName,strlen(fptr->logicalName) + 1);
          if (prev == NULL)
            { FileRouterData(theEnv)->ListOfFileRouters = fptr->next; }
          else
            { prev->next = fptr->next; }
-         rm(theEnv,fptr,(int) sizeof(struct fileRouter));
+         ReturnFileRouter(theEnv,fptr);
+         InvalidateRouterCache(theEnv);
 
          return true;
         }
@@ -351,14 +461,53 @@ bool CloseAllFiles(
 
    while (fptr != NULL)
      {
-      GenClose(theEnv,fptr->stream);
       prev = fptr;
-      rm(theEnv,(void *) fptr->logicalName,strlen(fptr->logicalName) + 1);
       fptr = fptr->next;
-      rm(theEnv,prev,(int) sizeof(struct fileRouter));
+      ReturnFileRouter(theEnv,prev);
      }
 
    FileRouterData(theEnv)->ListOfFileRouters = NULL;
+   InvalidateRouterCache(theEnv);
+
+   return true;
+  }
+
+/******************************************************/
+/* FlushFile: Writes any buffered output for the      */
+/*   file associated with the specified logical name. */
+/*   Returns true if the logical name is associated   */
+/*   with an open file, otherwise false.              */
+/******************************************************/
+bool FlushFile(
+  Environment *theEnv,
+  const char *logicalName)
+  {
+   struct fileRouter *fptr;
+
+   fptr = FindFileRouter(theEnv,logicalName);
+   if (fptr == NULL) return false;
+
+   fflush(fptr->stream);
+
+   return true;
+  }
+
+/******************************************************/
+/* FlushAllFiles: Writes any buffered output for all  */
+/*   files associated with a file I/O router. Returns */
+/*   true if any file is open, otherwise false.       */
+/******************************************************/
+bool FlushAllFiles(
+  Environment *theEnv)
+  {
+   struct fileRouter *fptr;
+
+   if (FileRouterData(theEnv)->ListOfFileRouters == NULL) return false;
+
+   for (fptr = FileRouterData(theEnv)->ListOfFileRouters;
+        fptr != NULL;
+        fptr = fptr->next)
+     { fflush(fptr->stream); }
 
    return true;
   }
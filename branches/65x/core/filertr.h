@@ -45,6 +45,11 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added OpenBufferedFile, FlushFile, and         */
+/*            FlushAllFiles.                                 */
+/*                                                           */
+/*            Added MAXIMUM_FILE_BUFFER_SIZE.                */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_filertr
@@ -57,16 +62,21 @@
 
 #define FILE_ROUTER_DATA 47
 
+#define MAXIMUM_FILE_BUFFER_SIZE 16777216
+
 struct fileRouter
   {
    const char *logicalName;
    FILE *stream;
+   char *buffer;
+   size_t bufferSize;
    struct fileRouter *next;
   };
 
 struct fileRouterData
   {
    struct fileRouter *ListOfFileRouters;
+   struct fileRouter *LastFileRouter;
   };
 
 #define FileRouterData(theEnv) ((struct fileRouterData *) GetEnvironmentData(theEnv,FILE_ROUTER_DATA))
@@ -74,9 +84,12 @@ struct fileRouterData
    void                           InitializeFileRouter(Environment *);
    FILE                          *FindFptr(Environment *,const char *);
    bool                           OpenAFile(Environment *,const char *,const char *,const char *);
+   bool                           OpenBufferedFile(Environment *,const char *,const char *,const char *,size_t);
    bool                           CloseAllFiles(Environment *);
    bool                           CloseFile(Environment *,const char *);
    bool                           FindFile(Environment *,const char *,void *);
+   bool                           FlushFile(Environment *,const char *);
+   bool                           FlushAllFiles(Environment *);
 
 #endif /* _H_filertr */
 
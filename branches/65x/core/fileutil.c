@@ -22,6 +22,9 @@
 /*                                                           */
 /*      6.40: Split from filecom.c                           */
 /*                                                           */
+/*      6.50: batch* only checks for a complete command at   */
+/*            the end of a line.                             */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -898,16 +901,21 @@ bool BatchStar(
    SetHaltExecution(theEnv,false);
    SetEvaluationError(theEnv,false);
 
-   /*=============================================*/
-   /* Evaluate commands from the file one by one. */
-   /*=============================================*/
+   /*=================================================*/
+   /* Evaluate commands from the file one by one. A   */
+   /* command can only be completed by the end of a   */
+   /* line, so the command string is only checked for */
+   /* completion when a line ends rather than after   */
+   /* every character is read.                        */
+   /*=================================================*/
 
    while ((inchar = getc(theFile)) != EOF)
      {
       theString = ExpandStringWithChar(theEnv,inchar,theString,&position,
-                                       &maxChars,maxChars+80);
+                                       &maxChars,(maxChars * 2) + 80);
 
-      if (CompleteCommand(theString) != 0)
+      if (((inchar == '\r') || (inchar == '\n')) &&
+          (CompleteCommand(theString) != 0))
         {
          FlushPPBuffer(theEnv);
          SetPPBufferStatus(theEnv,false);
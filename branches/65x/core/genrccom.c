@@ -68,6 +68,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Compressed pretty print forms are expanded     */
+/*            when retrieved.                                */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -109,6 +112,7 @@
 #include "modulpsr.h"
 #include "modulutl.h"
 #include "multifld.h"
+#include "pprint.h"
 #include "router.h"
 #include "strngrtr.h"
 #if DEBUGGING_FUNCTIONS
@@ -938,7 +942,7 @@ void PPDefmethodCommand(
    if (gi == -1)
      return;
    if (gfunc->methods[gi].header.ppForm != NULL)
-     PrintInChunks(theEnv,WDISPLAY,gfunc->methods[gi].header.ppForm);
+     PrintInChunks(theEnv,WDISPLAY,ExpandPPForm(theEnv,gfunc->methods[gi].header.ppForm));
   }
 
 /******************************************************
@@ -986,7 +990,7 @@ const char *DefmethodPPForm(
    int mi;
 
    mi = FindMethodByIndex(theDefgeneric,theIndex);
-   return theDefgeneric->methods[mi].header.ppForm;
+   return ExpandPPForm(theDefgeneric->header.env,theDefgeneric->methods[mi].header.ppForm);
   }
 
 /***************************************************
@@ -1486,7 +1490,7 @@ static void SaveDefmethodsForDefgeneric(
      {
       if (gfunc->methods[i].header.ppForm != NULL)
         {
-         PrintInChunks(theEnv,logName,gfunc->methods[i].header.ppForm);
+         PrintInChunks(theEnv,logName,ExpandPPForm(theEnv,gfunc->methods[i].header.ppForm));
          PrintString(theEnv,logName,"\n");
         }
      }
@@ -53,6 +53,9 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: A defgeneric already at the end of its         */
+/*            module's list is not removed and re-added.     */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -1345,8 +1348,14 @@ static Defgeneric *AddGeneric(
 
       /* ================================
          The old trace state is preserved
+         (the generic is moved to the end
+         of the list unless it's there)
          ================================ */
-      RemoveConstructFromModule(theEnv,&gfunc->header);
+      if (gfunc->header.whichModule->lastItem != &gfunc->header)
+        {
+         RemoveConstructFromModule(theEnv,&gfunc->header);
+         AddConstructToModule(&gfunc->header);
+        }
      }
    else
      {
@@ -1354,8 +1363,8 @@ static Defgeneric *AddGeneric(
       gfunc = NewGeneric(theEnv,name);
       IncrementLexemeCount(name);
       AddImplicitMethods(theEnv,gfunc);
+      AddConstructToModule(&gfunc->header);
      }
-   AddConstructToModule(&gfunc->header);
    return(gfunc);
   }
 
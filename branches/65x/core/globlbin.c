@@ -27,6 +27,8 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added change tags to defglobals.               */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -397,6 +399,7 @@ static void UpdateDefglobal(
 #endif
    DefglobalBinaryData(theEnv)->DefglobalArray[obji].initial = HashedExpressionPointer(bdp->initial);
    DefglobalBinaryData(theEnv)->DefglobalArray[obji].current.voidValue = VoidConstant(theEnv);
+   DefglobalBinaryData(theEnv)->DefglobalArray[obji].changeTag = 0;
   }
 
 /***************************************/
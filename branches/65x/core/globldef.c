@@ -57,6 +57,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added change tags to defglobals.               */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -475,6 +477,7 @@ void QSetDefglobalValue(
    /*===========================================*/
 
    DefglobalData(theEnv)->ChangeToGlobals = true;
+   theGlobal->changeTag = ++DefglobalData(theEnv)->CurrentChangeTag;
 
    if ((UtilityData(theEnv)->CurrentGarbageFrame->topLevel) && (! CommandLineData(theEnv)->EvaluatingTopLevelCommand) &&
        (EvaluationData(theEnv)->CurrentExpression == NULL) && (UtilityData(theEnv)->GarbageCollectionLocks == 0))
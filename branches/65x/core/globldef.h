@@ -55,6 +55,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added change tags to defglobals.               */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_globldef
@@ -80,6 +82,7 @@ struct defglobalData
    Construct *DefglobalConstruct;
    int DefglobalModuleIndex;
    bool ChangeToGlobals;
+   unsigned long long CurrentChangeTag;
 #if DEBUGGING_FUNCTIONS
    bool WatchGlobals;
 #endif
@@ -101,6 +104,7 @@ struct defglobal
    long busyCount;
    UDFValue current;
    struct expr *initial;
+   unsigned long long changeTag;
   };
 
 struct defglobalModule
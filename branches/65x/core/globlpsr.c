@@ -45,6 +45,8 @@
 /*                                                           */
 /*            Eval support for run time and bload only.      */
 /*                                                           */
+/*      6.50: Added change tags to defglobals.               */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -398,6 +400,7 @@ static void AddDefglobal(
    defglobalPtr->initial = AddHashedExpression(theEnv,ePtr);
    ReturnExpression(theEnv,ePtr);
    DefglobalData(theEnv)->ChangeToGlobals = true;
+   defglobalPtr->changeTag = ++DefglobalData(theEnv)->CurrentChangeTag;
 
    /*=================================*/
    /* Restore the old watch value to  */
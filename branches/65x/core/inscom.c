@@ -64,6 +64,8 @@
 /*                                                           */
 /*            Eval support for run time and bload only.      */
 /*                                                           */
+/*      6.50: Corrected return type of instance-address.     */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -203,7 +205,7 @@ void SetupInstances(
 
    AddUDF(theEnv,"symbol-to-instance-name","*",1,1,"y",SymbolToInstanceNameFunction,"SymbolToInstanceNameFunction",NULL);
    AddUDF(theEnv,"instance-name-to-symbol","y",1,1,"ny",InstanceNameToSymbolFunction,"InstanceNameToSymbolFunction",NULL);
-   AddUDF(theEnv,"instance-address","bn",1,2,";iyn;yn",InstanceAddressCommand,"InstanceAddressCommand",NULL);
+   AddUDF(theEnv,"instance-address","bi",1,2,";iyn;yn",InstanceAddressCommand,"InstanceAddressCommand",NULL);
    AddUDF(theEnv,"instance-addressp","b",1,1,NULL,InstanceAddressPCommand,"InstanceAddressPCommand",NULL);
    AddUDF(theEnv,"instance-namep","b",1,1,NULL,InstanceNamePCommand,"InstanceNamePCommand",NULL);
    AddUDF(theEnv,"instance-name","bn",1,1,"yin",InstanceNameCommand,"InstanceNameCommand",NULL);
@@ -284,6 +286,9 @@ static void DeallocateInstanceData(
 
       if (tmpIPtr->cls->instanceSlotCount != 0)
         {
+         UpdateSubsystemMemory(theEnv,INSTANCE_MEMORY,
+                               - (long) ((tmpIPtr->cls->instanceSlotCount * sizeof(InstanceSlot *)) +
+                                         (tmpIPtr->cls->localInstanceSlotCount * sizeof(InstanceSlot))));
          rm(theEnv,tmpIPtr->slotAddresses,
             (tmpIPtr->cls->instanceSlotCount * sizeof(InstanceSlot *)));
          if (tmpIPtr->cls->localInstanceSlotCount != 0)
@@ -293,6 +298,7 @@ static void DeallocateInstanceData(
            }
         }
 
+      UpdateSubsystemMemory(theEnv,INSTANCE_MEMORY,- (long) sizeof(struct instance));
       rtn_struct(theEnv,instance,tmpIPtr);
 
       tmpIPtr = nextIPtr;
@@ -306,6 +312,7 @@ static void DeallocateInstanceData(
    while (tmpGPtr != NULL)
      {
       nextGPtr = tmpGPtr->nxt;
+      UpdateSubsystemMemory(theEnv,INSTANCE_MEMORY,- (long) sizeof(struct instance));
       rtn_struct(theEnv,instance,tmpGPtr->ins);
       rtn_struct(theEnv,igarbage,tmpGPtr);
       tmpGPtr = nextGPtr;
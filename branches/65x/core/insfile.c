@@ -56,6 +56,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: The print forms of tokens are omitted while    */
+/*            instances are loaded.                          */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -86,6 +89,7 @@
 #include "object.h"
 #include "prntutil.h"
 #include "router.h"
+#include "scanner.h"
 #include "strngrtr.h"
 #include "symblbin.h"
 #include "sysdep.h"
@@ -1286,7 +1290,7 @@ static long LoadOrRestoreInstances(
    FILE *sfile = NULL,*svload = NULL;
    const char *ilog;
    Expression *top;
-   bool svoverride;
+   bool svoverride, svprintforms;
    long instanceCount = 0L;
 
    if (isFileName) {
@@ -1302,6 +1306,8 @@ static long LoadOrRestoreInstances(
      ilog = file;
    }
    top = GenConstant(theEnv,FCALL,FindFunction(theEnv,"make-instance"));
+   svprintforms = ScannerData(theEnv)->OmitPrintForms;
+   ScannerData(theEnv)->OmitPrintForms = true;
    GetToken(theEnv,ilog,&DefclassData(theEnv)->ObjectParseToken);
    svoverride = InstanceData(theEnv)->MkInsMsgPass;
    InstanceData(theEnv)->MkInsMsgPass = usemsgs;
@@ -1317,6 +1323,7 @@ static long LoadOrRestoreInstances(
          }
          SetEvaluationError(theEnv,true);
          InstanceData(theEnv)->MkInsMsgPass = svoverride;
+         ScannerData(theEnv)->OmitPrintForms = svprintforms;
          return(instanceCount);
         }
       if (ParseSimpleInstance(theEnv,top,ilog) == NULL)
@@ -1326,9 +1333,11 @@ static long LoadOrRestoreInstances(
            SetFastLoad(theEnv,svload);
          }
          InstanceData(theEnv)->MkInsMsgPass = svoverride;
+         ScannerData(theEnv)->OmitPrintForms = svprintforms;
          SetEvaluationError(theEnv,true);
          return(instanceCount);
         }
+      ScannerData(theEnv)->OmitPrintForms = svprintforms;
       ExpressionInstall(theEnv,top);
       EvaluateExpression(theEnv,top,&temp);
       ExpressionDeinstall(theEnv,top);
@@ -1336,6 +1345,7 @@ static long LoadOrRestoreInstances(
         instanceCount++;
       ReturnExpression(theEnv,top->argList);
       top->argList = NULL;
+      ScannerData(theEnv)->OmitPrintForms = true;
       GetToken(theEnv,ilog,&DefclassData(theEnv)->ObjectParseToken);
      }
    rtn_struct(theEnv,expr,top);
@@ -1344,6 +1354,7 @@ static long LoadOrRestoreInstances(
      SetFastLoad(theEnv,svload);
    }
    InstanceData(theEnv)->MkInsMsgPass = svoverride;
+   ScannerData(theEnv)->OmitPrintForms = svprintforms;
    return(instanceCount);
   }
 
@@ -250,6 +250,7 @@ void CleanupInstances(
 #endif
         {
          DecrementLexemeReferenceCount(theEnv,gtmp->ins->name);
+         UpdateSubsystemMemory(theEnv,INSTANCE_MEMORY,- (long) sizeof(struct instance));
          rtn_struct(theEnv,instance,gtmp->ins);
          if (gprv == NULL)
            InstanceData(theEnv)->InstanceGarbageList = gtmp->nxt;
@@ -361,6 +362,9 @@ void RemoveInstanceData(
      }
    if (ins->cls->instanceSlotCount != 0)
      {
+      UpdateSubsystemMemory(theEnv,INSTANCE_MEMORY,
+                            - (long) ((ins->cls->instanceSlotCount * sizeof(InstanceSlot *)) +
+                                      (ins->cls->localInstanceSlotCount * sizeof(InstanceSlot))));
       rm(theEnv,ins->slotAddresses,
          (ins->cls->instanceSlotCount * sizeof(InstanceSlot *)));
       if (ins->cls->localInstanceSlotCount != 0)
@@ -51,6 +51,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Initializes the queued object match action of  */
+/*            new instances.                                 */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -379,6 +382,7 @@ Instance *BuildInstance(
    if (AddLogicalDependencies(theEnv,(struct patternEntity *) InstanceData(theEnv)->CurrentInstance,false)
         == false)
      {
+      UpdateSubsystemMemory(theEnv,INSTANCE_MEMORY,- (long) sizeof(struct instance));
       rtn_struct(theEnv,instance,InstanceData(theEnv)->CurrentInstance);
       InstanceData(theEnv)->CurrentInstance = NULL;
       return NULL;
@@ -589,6 +593,7 @@ bool QuashInstance(
        )
      {
       DecrementLexemeReferenceCount(theEnv,ins->name);
+      UpdateSubsystemMemory(theEnv,INSTANCE_MEMORY,- (long) sizeof(struct instance));
       rtn_struct(theEnv,instance,ins);
      }
    else
@@ -679,6 +684,7 @@ static Instance *NewInstance(
    Instance *instance;
 
    instance = get_struct(theEnv,instance);
+   UpdateSubsystemMemory(theEnv,INSTANCE_MEMORY,(long) sizeof(struct instance));
 #if DEFRULE_CONSTRUCT
    instance->patternHeader.theInfo = &InstanceData(theEnv)->InstanceInfo;
 
@@ -689,6 +695,7 @@ static Instance *NewInstance(
    instance->partialMatchList = NULL;
    instance->basisSlots = NULL;
    instance->reteSynchronized = false;
+   instance->matchAction = NULL;
 #endif
    instance->patternHeader.header.type = INSTANCE_ADDRESS_TYPE;
    instance->busy = 0;
@@ -852,6 +859,8 @@ static void BuildDefaultSlots(
       if (lscnt != 0)
         InstanceData(theEnv)->CurrentInstance->slots = dst =
            (InstanceSlot *) gm2(theEnv,(sizeof(InstanceSlot) * lscnt));
+      UpdateSubsystemMemory(theEnv,INSTANCE_MEMORY,
+                            (long) ((sizeof(InstanceSlot *) * scnt) + (sizeof(InstanceSlot) * lscnt)));
       src = InstanceData(theEnv)->CurrentInstance->cls->instanceTemplate;
 
       /* ==================================================
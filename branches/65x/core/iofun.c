@@ -87,6 +87,9 @@
 /*                                                           */
 /*            Added print and println functions.             */
 /*                                                           */
+/*      6.50: Added an optional buffer size argument to the  */
+/*            open function and added the flush function.    */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -172,8 +175,9 @@ void IOFunctionDefinitions(
    AddUDF(theEnv,"print","v",0,UNBOUNDED,NULL,PrintFunction,"PrintFunction",NULL);
    AddUDF(theEnv,"println","v",0,UNBOUNDED,NULL,PrintlnFunction,"PrintlnFunction",NULL);
    AddUDF(theEnv,"read","synldfie",0,1,NULL,ReadFunction,"ReadFunction",NULL);
-   AddUDF(theEnv,"open","b",2,3,"*;sy",OpenFunction,"OpenFunction",NULL);
+   AddUDF(theEnv,"open","b",2,4,"*;sy",OpenFunction,"OpenFunction",NULL);
    AddUDF(theEnv,"close","b",0,1,NULL,CloseFunction,"CloseFunction",NULL);
+   AddUDF(theEnv,"flush","b",0,1,NULL,FlushFunction,"FlushFunction",NULL);
    AddUDF(theEnv,"get-char","l",0,1,NULL,GetCharFunction,"GetCharFunction",NULL);
    AddUDF(theEnv,"put-char","v",1,2,NULL,PutCharFunction,"PutCharFunction",NULL);
    AddUDF(theEnv,"remove","b",1,1,"sy",RemoveFunction,"RemoveFunction",NULL);
@@ -515,6 +519,7 @@ void OpenFunction(
   {
    const char *fileName, *logicalName, *accessMode = NULL;
    UDFValue theArg;
+   size_t bufferSize = 0;
 
    /*====================*/
    /* Get the file name. */
@@ -589,13 +594,37 @@ void OpenFunction(
       return;
      }
 
+   /*=====================================================*/
+   /* Get the optional output buffer size. Output to the  */
+   /* file is held in the buffer until it's full or until */
+   /* the file is flushed or closed.                      */
+   /*=====================================================*/
+
+   if (UDFHasNextArgument(context))
+     {
+      if (! UDFNextArgument(context,INTEGER_BIT,&theArg))
+        { return; }
+
+      if ((theArg.integerValue->contents < 0) ||
+          (theArg.integerValue->contents > MAXIMUM_FILE_BUFFER_SIZE))
+        {
+         UDFInvalidArgumentMessage(context,"integer from 0 to 16777216");
+         SetHaltExecution(theEnv,true);
+         SetEvaluationError(theEnv,true);
+         returnValue->lexemeValue = FalseSymbol(theEnv);
+         return;
+        }
+
+      bufferSize = (size_t) theArg.integerValue->contents;
+     }
+
    /*================================================*/
    /* Open the named file and associate it with the  */
    /* specified logical name. Return TRUE if the     */
    /* file was opened successfully, otherwise FALSE. */
    /*================================================*/
 
-   returnValue->lexemeValue = CreateBoolean(theEnv,OpenAFile(theEnv,fileName,accessMode,logicalName));
+   returnValue->lexemeValue = CreateBoolean(theEnv,OpenBufferedFile(theEnv,fileName,accessMode,logicalName,bufferSize));
   }
 
 /***************************************************************/
@@ -643,6 +672,51 @@ void CloseFunction(
    returnValue->lexemeValue = CreateBoolean(theEnv,CloseFile(theEnv,logicalName));
   }
 
+/***************************************************************/
+/* FlushFunction: H/L access routine for the flush function.   */
+/***************************************************************/
+void FlushFunction(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   const char *logicalName;
+
+   /*=====================================================*/
+   /* If no arguments are specified, then flush all files */
+   /* opened with the open command. Return true if any    */
+   /* files were flushed, otherwise false.                */
+   /*=====================================================*/
+
+   if (! UDFHasNextArgument(context))
+     {
+      returnValue->lexemeValue = CreateBoolean(theEnv,FlushAllFiles(theEnv));
+      return;
+     }
+
+   /*================================*/
+   /* Get the logical name argument. */
+   /*================================*/
+
+   logicalName = GetLogicalName(context,NULL);
+   if (logicalName == NULL)
+     {
+      IllegalLogicalNameMessage(theEnv,"flush");
+      SetHaltExecution(theEnv,true);
+      SetEvaluationError(theEnv,true);
+      returnValue->lexemeValue = FalseSymbol(theEnv);
+      return;
+     }
+
+   /*=====================================================*/
+   /* Flush the file associated with the specified        */
+   /* logical name. Return true if the file was flushed,  */
+   /* otherwise false.                                    */
+   /*=====================================================*/
+
+   returnValue->lexemeValue = CreateBoolean(theEnv,FlushFile(theEnv,logicalName));
+  }
+
 /***************************************/
 /* GetCharFunction: H/L access routine */
 /*   for the get-char function.        */
@@ -69,6 +69,8 @@
 /*                                                           */
 /*            Added print and println functions.             */
 /*                                                           */
+/*      6.50: Added the flush function.                      */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_iofun
@@ -86,6 +88,7 @@
    void                           ReadFunction(Environment *,UDFContext *,UDFValue *);
    void                           OpenFunction(Environment *,UDFContext *,UDFValue *);
    void                           CloseFunction(Environment *,UDFContext *,UDFValue *);
+   void                           FlushFunction(Environment *,UDFContext *,UDFValue *);
    void                           GetCharFunction(Environment *,UDFContext *,UDFValue *);
    void                           PutCharFunction(Environment *,UDFContext *,UDFValue *);
    void                           ReadlineFunction(Environment *,UDFContext *,UDFValue *);
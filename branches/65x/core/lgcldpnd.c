@@ -38,6 +38,10 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Logical dependencies are shared by the partial */
+/*            match and the data entity and can be removed   */
+/*            from either in constant time.                  */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -62,7 +66,8 @@
 /* LOCAL INTERNAL FUNCTION DEFINITIONS */
 /***************************************/
 
-   static struct dependency      *DetachAssociatedDependencies(Environment *,struct dependency *,void *);
+   static void                    DetachFromBinds(struct dependency *);
+   static void                    DetachFromEntity(struct dependency *);
 
 /***********************************************************************/
 /* AddLogicalDependencies: Adds the logical dependency links between a */
@@ -115,24 +120,26 @@ bool AddLogicalDependencies(
      { return false; }
 
    /*==============================================================*/
-   /* Add a dependency link between the partial match and the data */
-   /* entity. The dependency links are stored in the partial match */
-   /* behind the data entities stored in the partial match and the */
-   /* activation link, if any.                                     */
+   /* Create a single dependency for the link between the partial  */
+   /* match and the data entity. It is placed at the front of both */
+   /* the partial match's list of dependents and the data entity's */
+   /* list of logical support.                                     */
    /*==============================================================*/
 
    newDependency = get_struct(theEnv,dependency);
-   newDependency->dPtr = theEntity;
-   newDependency->next = (struct dependency *) theBinds->dependents;
-   theBinds->dependents = newDependency;
+   newDependency->theBinds = theBinds;
+   newDependency->theEntity = theEntity;
 
-   /*================================================================*/
-   /* Add a dependency link between the entity and the partialMatch. */
-   /*================================================================*/
+   newDependency->prevInBinds = NULL;
+   newDependency->nextInBinds = (struct dependency *) theBinds->dependents;
+   if (newDependency->nextInBinds != NULL)
+     { newDependency->nextInBinds->prevInBinds = newDependency; }
+   theBinds->dependents = newDependency;
 
-   newDependency = get_struct(theEnv,dependency);
-   newDependency->dPtr = theBinds;
-   newDependency->next = (struct dependency *) theEntity->dependents;
+   newDependency->prevInEntity = NULL;
+   newDependency->nextInEntity = (struct dependency *) theEntity->dependents;
+   if (newDependency->nextInEntity != NULL)
+     { newDependency->nextInEntity->prevInEntity = newDependency; }
    theEntity->dependents = newDependency;
 
    /*==================================================================*/
@@ -184,8 +191,7 @@ void RemoveEntityDependencies(
   Environment *theEnv,
   struct patternEntity *theEntity)
   {
-   struct dependency *fdPtr, *nextPtr, *theList;
-   struct partialMatch *theBinds;
+   struct dependency *fdPtr, *nextPtr;
 
    /*===============================*/
    /* Get the list of dependencies. */
@@ -203,16 +209,13 @@ void RemoveEntityDependencies(
       /* Remember the next dependency. */
       /*===============================*/
 
-      nextPtr = fdPtr->next;
+      nextPtr = fdPtr->nextInEntity;
 
       /*================================================================*/
       /* Remove the link between the data entity and the partial match. */
       /*================================================================*/
 
-      theBinds = (struct partialMatch *) fdPtr->dPtr;
-      theList = (struct dependency *) theBinds->dependents;
-      theList = DetachAssociatedDependencies(theEnv,theList,theEntity);
-      theBinds->dependents = theList;
+      DetachFromBinds(fdPtr);
 
       /*========================*/
       /* Return the dependency. */
@@ -236,61 +239,50 @@ void RemoveEntityDependencies(
 
 /********************************************************************/
 /* ReturnEntityDependencies: Removes all logical support links from */
-/*   a pattern entity. This is unidirectional. The links from the   */
-/*   the partial match to the entity are not removed.               */
+/*   a pattern entity. Since a dependency is shared by the partial  */
+/*   match and the pattern entity, it is also removed from the      */
+/*   partial match so that it is only returned once.                */
 /********************************************************************/
 void ReturnEntityDependencies(
   Environment *theEnv,
   struct patternEntity *theEntity)
   {
-   struct dependency *fdPtr, *nextPtr;
-
-   fdPtr = (struct dependency *) theEntity->dependents;
-
-   while (fdPtr != NULL)
-     {
-      nextPtr = fdPtr->next;
-      rtn_struct(theEnv,dependency,fdPtr);
-      fdPtr = nextPtr;
-     }
-
-   theEntity->dependents = NULL;
+   RemoveEntityDependencies(theEnv,theEntity);
   }
 
-/*******************************************************************/
-/* DetachAssociatedDependencies: Removes all logical support links */
-/*   which pointer to a pattern entity from a list of dependencies */
-/*   (which may be associated with either a partial match or       */
-/*   another pattern entity). Does not remove links which point in */
-/*   the other direction.                                          */
-/*******************************************************************/
-static struct dependency *DetachAssociatedDependencies(
-  Environment *theEnv,
-  struct dependency *theList,
-  void *theEntity)
+/*************************************************************/
+/* DetachFromBinds: Removes a dependency from the list of    */
+/*   dependents of the partial match which provides logical  */
+/*   support. The dependency is not removed from the list of */
+/*   logical support of its data entity.                     */
+/*************************************************************/
+static void DetachFromBinds(
+  struct dependency *theDependency)
   {
-   struct dependency *fdPtr, *nextPtr, *lastPtr = NULL;
+   if (theDependency->prevInBinds == NULL)
+     { theDependency->theBinds->dependents = theDependency->nextInBinds; }
+   else
+     { theDependency->prevInBinds->nextInBinds = theDependency->nextInBinds; }
 
-   fdPtr = theList;
+   if (theDependency->nextInBinds != NULL)
+     { theDependency->nextInBinds->prevInBinds = theDependency->prevInBinds; }
+  }
 
-   while (fdPtr != NULL)
-     {
-      if (fdPtr->dPtr == theEntity)
-        {
-         nextPtr = fdPtr->next;
-         if (lastPtr == NULL) theList = nextPtr;
-         else lastPtr->next = nextPtr;
-         rtn_struct(theEnv,dependency,fdPtr);
-         fdPtr = nextPtr;
-        }
-      else
-        {
-         lastPtr = fdPtr;
-         fdPtr = fdPtr->next;
-        }
-     }
+/***************************************************************/
+/* DetachFromEntity: Removes a dependency from the list of     */
+/*   logical support of its data entity. The dependency is not */
+/*   removed from the list of dependents of its partial match. */
+/***************************************************************/
+static void DetachFromEntity(
+  struct dependency *theDependency)
+  {
+   if (theDependency->prevInEntity == NULL)
+     { theDependency->theEntity->dependents = theDependency->nextInEntity; }
+   else
+     { theDependency->prevInEntity->nextInEntity = theDependency->nextInEntity; }
 
-   return(theList);
+   if (theDependency->nextInEntity != NULL)
+     { theDependency->nextInEntity->prevInEntity = theDependency->prevInEntity; }
   }
 
 /**************************************************************************/
@@ -302,21 +294,14 @@ void RemovePMDependencies(
   Environment *theEnv,
   struct partialMatch *theBinds)
   {
-   struct dependency *fdPtr, *nextPtr, *theList;
-   struct patternEntity *theEntity;
+   struct dependency *fdPtr, *nextPtr;
 
    fdPtr = (struct dependency *) theBinds->dependents;
 
    while (fdPtr != NULL)
      {
-      nextPtr = fdPtr->next;
-
-      theEntity = (struct patternEntity *) fdPtr->dPtr;
-
-      theList = (struct dependency *) theEntity->dependents;
-      theList = DetachAssociatedDependencies(theEnv,theList,theBinds);
-      theEntity->dependents = theList;
-
+      nextPtr = fdPtr->nextInBinds;
+      DetachFromEntity(fdPtr);
       rtn_struct(theEnv,dependency,fdPtr);
       fdPtr = nextPtr;
      }
@@ -327,41 +312,31 @@ void RemovePMDependencies(
 /************************************************************/
 /* DestroyPMDependencies: Removes all logical support links */
 /*   from a partial match that point to any data entities.  */
+/*   Since a dependency is shared by the partial match and  */
+/*   the data entity, it is also removed from the data      */
+/*   entity so that it is only returned once.               */
 /************************************************************/
 void DestroyPMDependencies(
   Environment *theEnv,
   struct partialMatch *theBinds)
   {
-   struct dependency *fdPtr, *nextPtr;
-
-   fdPtr = (struct dependency *) theBinds->dependents;
-
-   while (fdPtr != NULL)
-     {
-      nextPtr = fdPtr->next;
-
-      rtn_struct(theEnv,dependency,fdPtr);
-      fdPtr = nextPtr;
-     }
-
-   theBinds->dependents = NULL;
+   RemovePMDependencies(theEnv,theBinds);
   }
 
 /************************************************************************/
 /* RemoveLogicalSupport: Removes the dependency links between a partial */
 /*   match and the data entities it logically supports. Also removes    */
 /*   the associated links from the data entities which point back to    */
-/*   the partial match by calling DetachAssociatedEntityDependencies.   */
-/*   If an entity has all of its logical support removed as a result of */
-/*   this procedure, the dependency link from the partial match is      */
-/*   added to the list of unsupported data entities so that the entity  */
-/*   will be deleted as a result of losing its logical support.         */
+/*   the partial match. If an entity has all of its logical support     */
+/*   removed as a result of this procedure, the dependency is added to  */
+/*   the list of unsupported data entities so that the entity will be   */
+/*   deleted as a result of losing its logical support.                 */
 /************************************************************************/
 void RemoveLogicalSupport(
   Environment *theEnv,
   struct partialMatch *theBinds)
   {
-   struct dependency *dlPtr, *tempPtr, *theList;
+   struct dependency *dlPtr, *tempPtr;
    struct patternEntity *theEntity;
 
    /*========================================*/
@@ -384,31 +359,28 @@ void RemoveLogicalSupport(
       /* Remember the next dependency. */
       /*===============================*/
 
-      tempPtr = dlPtr->next;
-
-      /*==========================================================*/
-      /* Determine the data entity associated with the dependency */
-      /* structure and delete its dependency references to this   */
-      /* partial match.                                           */
-      /*==========================================================*/
+      tempPtr = dlPtr->nextInBinds;
 
-      theEntity = (struct patternEntity *) dlPtr->dPtr;
+      /*=======================================================*/
+      /* Remove the dependency from the list of support of the */
+      /* data entity associated with the dependency structure. */
+      /*=======================================================*/
 
-      theList = (struct dependency *) theEntity->dependents;
-      theList = DetachAssociatedDependencies(theEnv,theList,theBinds);
-      theEntity->dependents = theList;
+      theEntity = dlPtr->theEntity;
+      DetachFromEntity(dlPtr);
 
       /*==============================================================*/
       /* If the data entity has lost all of its logical support, then */
-      /* add the dependency structure from the partial match to the   */
-      /* list of unsupported data entities to be deleted. Otherwise,  */
-      /* just delete the dependency structure.                        */
+      /* add the dependency structure to the list of unsupported data */
+      /* entities to be deleted. Otherwise, just delete the           */
+      /* dependency structure.                                        */
       /*==============================================================*/
 
       if (theEntity->dependents == NULL)
         {
          (*theEntity->theInfo->base.incrementBusyCount)(theEnv,theEntity);
-         dlPtr->next = EngineData(theEnv)->UnsupportedDataEntities;
+         dlPtr->theBinds = NULL;
+         dlPtr->nextInEntity = EngineData(theEnv)->UnsupportedDataEntities;
          EngineData(theEnv)->UnsupportedDataEntities = dlPtr;
         }
       else
@@ -466,14 +438,14 @@ void ForceLogicalRetractions(
       /* Determine the data entity to be deleted. */
       /*==========================================*/
 
-      theEntity = (struct patternEntity *) EngineData(theEnv)->UnsupportedDataEntities->dPtr;
+      theEntity = EngineData(theEnv)->UnsupportedDataEntities->theEntity;
 
       /*================================================*/
       /* Remove the dependency structure from the list. */
       /*================================================*/
 
       tempPtr = EngineData(theEnv)->UnsupportedDataEntities;
-      EngineData(theEnv)->UnsupportedDataEntities = EngineData(theEnv)->UnsupportedDataEntities->next;
+      EngineData(theEnv)->UnsupportedDataEntities = EngineData(theEnv)->UnsupportedDataEntities->nextInEntity;
       rtn_struct(theEnv,dependency,tempPtr);
 
       /*=========================*/
@@ -518,10 +490,10 @@ void Dependencies(
 
    for (fdPtr = (struct dependency *) theEntity->dependents;
         fdPtr != NULL;
-        fdPtr = fdPtr->next)
+        fdPtr = fdPtr->nextInEntity)
      {
       if (GetHaltExecution(theEnv) == true) return;
-      PrintPartialMatch(theEnv,WDISPLAY,(struct partialMatch *) fdPtr->dPtr);
+      PrintPartialMatch(theEnv,WDISPLAY,fdPtr->theBinds);
       PrintString(theEnv,WDISPLAY,"\n");
      }
   }
@@ -556,7 +528,7 @@ void Dependents(
 
       for (fdPtr = (struct dependency *) entityPtr->dependents;
            fdPtr != NULL;
-           fdPtr = fdPtr->next)
+           fdPtr = fdPtr->nextInEntity)
         {
          if (GetHaltExecution(theEnv) == true) return;
 
@@ -569,7 +541,7 @@ void Dependents(
          /* to the next data entity.                            */
          /*=====================================================*/
 
-         theBinds = (struct partialMatch *) fdPtr->dPtr;
+         theBinds = fdPtr->theBinds;
          if (FindEntityInPartialMatch(theEntity,theBinds) == true)
            {
             if (found) PrintString(theEnv,WDISPLAY,",");
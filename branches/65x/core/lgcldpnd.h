@@ -37,6 +37,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Logical dependencies are doubly linked from    */
+/*            both the partial match and the data entity.    */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_lgcldpnd
@@ -45,10 +48,23 @@
 
 #define _H_lgcldpnd
 
+/*==================================================================*/
+/* A dependency links a partial match to a data entity it logically */
+/* supports. Each dependency is on two doubly linked lists: the     */
+/* dependents of the partial match and the logical support of the   */
+/* data entity, so it can be removed from either side in constant   */
+/* time. Data entities which have lost their logical support are    */
+/* queued using the entity links with theBinds set to NULL.         */
+/*==================================================================*/
+
 struct dependency
   {
-   void *dPtr;
-   struct dependency *next;
+   struct partialMatch *theBinds;
+   struct patternEntity *theEntity;
+   struct dependency *nextInBinds;
+   struct dependency *prevInBinds;
+   struct dependency *nextInEntity;
+   struct dependency *prevInEntity;
   };
 
 #include "entities.h"
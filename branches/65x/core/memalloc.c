@@ -49,6 +49,14 @@
 /*                                                           */
 /*            ALLOW_ENVIRONMENT_GLOBALS no longer supported. */
 /*                                                           */
+/*      6.50: Added soft and hard memory limits. Crossing    */
+/*            the soft limit releases the free memory pool.  */
+/*            Crossing the hard limit halts execution.       */
+/*                                                           */
+/*            Added peak memory tracking by subsystem.       */
+/*                                                           */
+/*            Added mem-peak-reset command.                  */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -57,6 +65,7 @@
 
 #include "constant.h"
 #include "envrnmnt.h"
+#include "evaluatn.h"
 #include "memalloc.h"
 #include "prntutil.h"
 #include "router.h"
@@ -73,6 +82,12 @@
 #define SpecialMalloc(sz) malloc((STD_SIZE) sz)
 #define SpecialFree(ptr) free(ptr)
 
+/***************************************/
+/* LOCAL INTERNAL FUNCTION DEFINITIONS */
+/***************************************/
+
+   static void                    MemoryLimitReached(Environment *);
+
 /********************************************/
 /* InitializeMemory: Sets up memory tables. */
 /********************************************/
@@ -135,9 +150,63 @@ void *genalloc(
    MemoryData(theEnv)->MemoryAmount += (long) size;
    MemoryData(theEnv)->MemoryCalls++;
 
+   if (MemoryData(theEnv)->MemoryAmount > MemoryData(theEnv)->MemoryPeak)
+     { MemoryData(theEnv)->MemoryPeak = MemoryData(theEnv)->MemoryAmount; }
+
+   if ((MemoryData(theEnv)->MemoryLimitCheck != 0) &&
+       (MemoryData(theEnv)->MemoryAmount > MemoryData(theEnv)->MemoryLimitCheck))
+     { MemoryLimitReached(theEnv); }
+
    return memPtr;
   }
 
+/***********************************************************/
+/* MemoryLimitReached: Handles the amount of memory in use */
+/*   exceeding the soft or hard memory limit. The free     */
+/*   memory pool is released when the soft limit is        */
+/*   crossed. If the hard limit is then still exceeded,    */
+/*   an error is generated and execution is halted. The    */
+/*   check is not repeated until memory use drops back     */
+/*   below the limit by a margin.                          */
+/***********************************************************/
+static void MemoryLimitReached(
+  Environment *theEnv)
+  {
+   struct memoryData *theData = MemoryData(theEnv);
+
+   if (theData->MemoryLimitCheck == theData->MemorySoftLimit)
+     {
+      theData->MemoryLimitCheck = 0;
+      ReleaseMem(theEnv,-1L);
+
+      theData->MemoryLimitRearm = theData->MemorySoftLimit - (theData->MemorySoftLimit / 8);
+      theData->MemoryLimitCheck = theData->MemoryHardLimit;
+
+      if ((theData->MemoryHardLimit == 0) ||
+          (theData->MemoryAmount <= theData->MemoryHardLimit))
+        { return; }
+     }
+   else
+     {
+      theData->MemoryLimitCheck = 0;
+      ReleaseMem(theEnv,-1L);
+
+      if (theData->MemoryAmount <= theData->MemoryHardLimit)
+        {
+         theData->MemoryLimitCheck = theData->MemoryHardLimit;
+         return;
+        }
+     }
+
+   theData->MemoryLimitCheck = 0;
+   theData->MemoryLimitRearm = theData->MemoryHardLimit - (theData->MemoryHardLimit / 8);
+
+   PrintErrorID(theEnv,"MEMORY",2,true);
+   PrintString(theEnv,WERROR,"Hard memory limit exceeded.\n");
+   SetEvaluationError(theEnv,true);
+   SetHaltExecution(theEnv,true);
+  }
+
 /***********************************************/
 /* DefaultOutOfMemoryFunction: Function called */
 /*   when the KB runs out of memory.           */
@@ -183,6 +252,16 @@ void genfree(
 
    MemoryData(theEnv)->MemoryAmount -= (long) size;
    MemoryData(theEnv)->MemoryCalls--;
+
+   if ((MemoryData(theEnv)->MemoryLimitRearm != 0) &&
+       (MemoryData(theEnv)->MemoryAmount < MemoryData(theEnv)->MemoryLimitRearm))
+     {
+      MemoryData(theEnv)->MemoryLimitRearm = 0;
+      if (MemoryData(theEnv)->MemorySoftLimit != 0)
+        { MemoryData(theEnv)->MemoryLimitCheck = MemoryData(theEnv)->MemorySoftLimit; }
+      else
+        { MemoryData(theEnv)->MemoryLimitCheck = MemoryData(theEnv)->MemoryHardLimit; }
+     }
   }
 
 /******************************************************/
@@ -233,6 +312,109 @@ long int MemRequests(
    return MemoryData(theEnv)->MemoryCalls;
   }
 
+/*******************************/
+/* MemPeak: C access routine   */
+/*   for the mem-peak command. */
+/*******************************/
+long int MemPeak(
+  Environment *theEnv)
+  {
+   return MemoryData(theEnv)->MemoryPeak;
+  }
+
+/*********************************************/
+/* ResetMemPeak: Sets the overall peak and   */
+/*   the subsystem peaks to the amount of    */
+/*   memory currently in use so that the     */
+/*   peak for a single task can be measured. */
+/*********************************************/
+void ResetMemPeak(
+  Environment *theEnv)
+  {
+   struct memoryData *theData = MemoryData(theEnv);
+   int i;
+
+   theData->MemoryPeak = theData->MemoryAmount;
+   for (i = 0; i < MEMORY_SUBSYSTEM_COUNT; i++)
+     { theData->SubsystemPeak[i] = theData->SubsystemMemory[i]; }
+  }
+
+/***********************************************/
+/* SubsystemMemPeak: Returns the peak number   */
+/*   of bytes used by the data structures of a */
+/*   subsystem such as facts or the agenda.    */
+/***********************************************/
+long int SubsystemMemPeak(
+  Environment *theEnv,
+  MemorySubsystem subsystem)
+  {
+   return MemoryData(theEnv)->SubsystemPeak[subsystem];
+  }
+
+/******************************************************/
+/* UpdateSubsystemMemory: Updates the number of bytes */
+/*   used by the data structures of a subsystem.      */
+/******************************************************/
+void UpdateSubsystemMemory(
+  Environment *theEnv,
+  MemorySubsystem subsystem,
+  long int value)
+  {
+   struct memoryData *theData = MemoryData(theEnv);
+
+   theData->SubsystemMemory[subsystem] += value;
+   if (theData->SubsystemMemory[subsystem] > theData->SubsystemPeak[subsystem])
+     { theData->SubsystemPeak[subsystem] = theData->SubsystemMemory[subsystem]; }
+  }
+
+/*******************************************************/
+/* SetMemoryLimits: Sets the soft and hard limits for  */
+/*   the number of bytes of memory in use. A limit of  */
+/*   zero indicates that there is no limit. Returns    */
+/*   false and leaves the limits unchanged if the soft */
+/*   limit is greater than the hard limit.             */
+/*******************************************************/
+bool SetMemoryLimits(
+  Environment *theEnv,
+  long int softLimit,
+  long int hardLimit)
+  {
+   if (softLimit < 0) softLimit = 0;
+   if (hardLimit < 0) hardLimit = 0;
+
+   if ((hardLimit != 0) && (softLimit > hardLimit))
+     { return false; }
+
+   MemoryData(theEnv)->MemorySoftLimit = softLimit;
+   MemoryData(theEnv)->MemoryHardLimit = hardLimit;
+   MemoryData(theEnv)->MemoryLimitRearm = 0;
+
+   if (softLimit != 0)
+     { MemoryData(theEnv)->MemoryLimitCheck = softLimit; }
+   else
+     { MemoryData(theEnv)->MemoryLimitCheck = hardLimit; }
+
+   return true;
+  }
+
+/******************************************************/
+/* GetMemorySoftLimit: Returns the soft memory limit. */
+/******************************************************/
+long int GetMemorySoftLimit(
+  Environment *theEnv)
+  {
+   return MemoryData(theEnv)->MemorySoftLimit;
+  }
+
+/******************************************************/
+/* GetMemoryHardLimit: Returns the hard memory limit. */
+/******************************************************/
+long int GetMemoryHardLimit(
+  Environment *theEnv)
+  {
+   return MemoryData(theEnv)->MemoryHardLimit;
+  }
+
 /***************************************/
 /* UpdateMemoryUsed: Allows the amount */
 /*   of memory used to be updated.     */
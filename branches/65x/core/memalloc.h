@@ -52,6 +52,12 @@
 /*                                                           */
 /*            ALLOW_ENVIRONMENT_GLOBALS no longer supported. */
 /*                                                           */
+/*      6.50: Added soft and hard memory limits.             */
+/*                                                           */
+/*            Added peak memory tracking by subsystem.       */
+/*                                                           */
+/*            Added mem-peak-reset command.                  */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_memalloc
@@ -68,6 +74,17 @@ struct memoryPtr;
 
 typedef bool OutOfMemoryFunction(Environment *,size_t);
 
+typedef enum
+  {
+   ATOM_MEMORY,
+   FACT_MEMORY,
+   INSTANCE_MEMORY,
+   ALPHA_MEMORY,
+   BETA_MEMORY,
+   AGENDA_MEMORY,
+   MEMORY_SUBSYSTEM_COUNT
+  } MemorySubsystem;
+
 #ifndef MEM_TABLE_SIZE
 #define MEM_TABLE_SIZE 500
 #endif
@@ -182,6 +199,13 @@ struct memoryData
    struct memoryPtr *TempMemoryPtr;
    struct memoryPtr **MemoryTable;
    size_t TempSize;
+   long int MemoryPeak;
+   long int MemorySoftLimit;
+   long int MemoryHardLimit;
+   long int MemoryLimitCheck;
+   long int MemoryLimitRearm;
+   long int SubsystemMemory[MEMORY_SUBSYSTEM_COUNT];
+   long int SubsystemPeak[MEMORY_SUBSYSTEM_COUNT];
   };
 
 #define MemoryData(theEnv) ((struct memoryData *) GetEnvironmentData(theEnv,MEMORY_DATA))
@@ -194,6 +218,13 @@ struct memoryData
    void                          *genrealloc(Environment *,void *,size_t,size_t);
    long                           MemUsed(Environment *);
    long                           MemRequests(Environment *);
+   long                           MemPeak(Environment *);
+   void                           ResetMemPeak(Environment *);
+   long                           SubsystemMemPeak(Environment *,MemorySubsystem);
+   void                           UpdateSubsystemMemory(Environment *,MemorySubsystem,long);
+   bool                           SetMemoryLimits(Environment *,long,long);
+   long                           GetMemorySoftLimit(Environment *);
+   long                           GetMemoryHardLimit(Environment *);
    long                           UpdateMemoryUsed(Environment *,long int);
    long                           UpdateMemoryRequests(Environment *,long int);
    long                           ReleaseMem(Environment *,long);
@@ -94,6 +94,17 @@
 /*                                                           */
 /*      6.50: Fact ?var:slot reference support.              */
 /*                                                           */
+/*            Added set-garbage-sweep-interval,              */
+/*            get-garbage-sweep-interval, and                */
+/*            garbage-statistics functions.                  */
+/*                                                           */
+/*            Added mem-peak, set-memory-limits, and         */
+/*            get-memory-limits functions.                   */
+/*                                                           */
+/*            Added mem-peak-reset command.                  */
+/*                                                           */
+/*            The conserve-mem command accepts compress.     */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -107,6 +118,7 @@
 #include "exprnpsr.h"
 #include "memalloc.h"
 #include "multifld.h"
+#include "pprint.h"
 #include "prntutil.h"
 #include "router.h"
 #include "sysdep.h"
@@ -167,10 +179,17 @@ void MiscFunctionDefinitions(
    AddUDF(theEnv,"seed","v",1,1,"l",SeedFunction,"SeedFunction",NULL);
    AddUDF(theEnv,"conserve-mem","v",1,1,"y",ConserveMemCommand,"ConserveMemCommand",NULL);
    AddUDF(theEnv,"release-mem","l",0,0,NULL,ReleaseMemCommand,"ReleaseMemCommand",NULL);
+   AddUDF(theEnv,"set-memory-limits","v",2,2,"l",SetMemoryLimitsCommand,"SetMemoryLimitsCommand",NULL);
+   AddUDF(theEnv,"get-memory-limits","m",0,0,NULL,GetMemoryLimitsCommand,"GetMemoryLimitsCommand",NULL);
 #if DEBUGGING_FUNCTIONS
    AddUDF(theEnv,"mem-used","l",0,0,NULL,MemUsedCommand,"MemUsedCommand",NULL);
    AddUDF(theEnv,"mem-requests","l",0,0,NULL,MemRequestsCommand,"MemRequestsCommand",NULL);
+   AddUDF(theEnv,"mem-peak","l",0,1,"y",MemPeakCommand,"MemPeakCommand",NULL);
+   AddUDF(theEnv,"mem-peak-reset","v",0,0,NULL,MemPeakResetCommand,"MemPeakResetCommand",NULL);
+   AddUDF(theEnv,"garbage-statistics","m",0,0,NULL,GarbageStatisticsCommand,"GarbageStatisticsCommand",NULL);
 #endif
+   AddUDF(theEnv,"set-garbage-sweep-interval","l",1,1,"l",SetGarbageSweepIntervalCommand,"SetGarbageSweepIntervalCommand",NULL);
+   AddUDF(theEnv,"get-garbage-sweep-interval","l",0,0,NULL,GetGarbageSweepIntervalCommand,"GetGarbageSweepIntervalCommand",NULL);
 
    AddUDF(theEnv,"options","v",0,0,NULL,OptionsCommand,"OptionsCommand",NULL);
 
@@ -485,6 +504,63 @@ void ReleaseMemCommand(
    returnValue->integerValue = CreateInteger(theEnv,ReleaseMem(theEnv,-1L));
   }
 
+/*************************************************/
+/* SetMemoryLimitsCommand: H/L access routine    */
+/*   for the set-memory-limits function. A limit */
+/*   of zero indicates that there is no limit.   */
+/*************************************************/
+void SetMemoryLimitsCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   UDFValue theArg;
+   long long softLimit;
+
+   if (! UDFFirstArgument(context,INTEGER_BIT,&theArg))
+     { return; }
+
+   softLimit = theArg.integerValue->contents;
+   if (softLimit < 0)
+     {
+      UDFInvalidArgumentMessage(context,"integer (greater than or equal to 0)");
+      return;
+     }
+
+   if (! UDFNextArgument(context,INTEGER_BIT,&theArg))
+     { return; }
+
+   if (theArg.integerValue->contents < 0)
+     {
+      UDFInvalidArgumentMessage(context,"integer (greater than or equal to 0)");
+      return;
+     }
+
+   if (! SetMemoryLimits(theEnv,(long) softLimit,(long) theArg.integerValue->contents))
+     { UDFInvalidArgumentMessage(context,"integer (0 or greater than or equal to the soft limit)"); }
+  }
+
+/*************************************************/
+/* GetMemoryLimitsCommand: H/L access routine    */
+/*   for the get-memory-limits function. Returns */
+/*   the soft and hard limits.                   */
+/*************************************************/
+void GetMemoryLimitsCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   Multifield *theList;
+
+   theList = CreateMultifield(theEnv,2L);
+   theList->contents[0].integerValue = CreateInteger(theEnv,GetMemorySoftLimit(theEnv));
+   theList->contents[1].integerValue = CreateInteger(theEnv,GetMemoryHardLimit(theEnv));
+
+   returnValue->begin = 0;
+   returnValue->range = 2;
+   returnValue->value = theList;
+  }
+
 /******************************************/
 /* ConserveMemCommand: H/L access routine */
 /*   for the conserve-mem command.        */
@@ -507,32 +583,50 @@ void ConserveMemCommand(
 
    argument = theValue.lexemeValue->contents;
 
-   /*====================================================*/
-   /* If the argument is the symbol "on", then store the */
-   /* pretty print representation of a construct when it */
-   /* is defined.                                        */
-   /*====================================================*/
+   /*=====================================================*/
+   /* If the argument is the symbol "on", then don't      */
+   /* store the pretty print representation of a          */
+   /* construct when it is defined.                       */
+   /*=====================================================*/
 
    if (strcmp(argument,"on") == 0)
-     { SetConserveMemory(theEnv,true); }
+     {
+      SetConserveMemory(theEnv,true);
+      SetCompressPPForms(theEnv,false);
+     }
 
    /*======================================================*/
    /* Otherwise, if the argument is the symbol "off", then */
-   /* don't store the pretty print representation of a     */
-   /* construct when it is defined.                        */
+   /* store the pretty print representation of a construct */
+   /* when it is defined.                                  */
    /*======================================================*/
 
    else if (strcmp(argument,"off") == 0)
-     { SetConserveMemory(theEnv,false); }
+     {
+      SetConserveMemory(theEnv,false);
+      SetCompressPPForms(theEnv,false);
+     }
+
+   /*=====================================================*/
+   /* Otherwise, if the argument is the symbol "compress" */
+   /* then store a compressed copy of the pretty print    */
+   /* representation of a construct when it is defined.   */
+   /*=====================================================*/
+
+   else if (strcmp(argument,"compress") == 0)
+     {
+      SetConserveMemory(theEnv,false);
+      SetCompressPPForms(theEnv,true);
+     }
 
    /*=====================================================*/
    /* Otherwise, generate an error since the only allowed */
-   /* arguments are "on" or "off."                        */
+   /* arguments are "on", "off", or "compress".           */
    /*=====================================================*/
 
    else
      {
-      UDFInvalidArgumentMessage(context,"symbol with value on or off");
+      UDFInvalidArgumentMessage(context,"symbol with value on, off, or compress");
       return;
      }
 
@@ -575,6 +669,133 @@ void MemRequestsCommand(
    returnValue->integerValue = CreateInteger(theEnv,MemRequests(theEnv));
   }
 
+/***********************************************/
+/* MemPeakCommand: H/L access routine for the  */
+/*   mem-peak command. Returns the peak amount */
+/*   of memory in use, or the peak for one of  */
+/*   the subsystems atoms, facts, instances,   */
+/*   alpha, beta, or agenda.                   */
+/***********************************************/
+void MemPeakCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   UDFValue theArg;
+   const char *name;
+   MemorySubsystem subsystem;
+
+   if (! UDFHasNextArgument(context))
+     {
+      returnValue->integerValue = CreateInteger(theEnv,MemPeak(theEnv));
+      return;
+     }
+
+   if (! UDFFirstArgument(context,SYMBOL_BIT,&theArg))
+     { return; }
+
+   name = theArg.lexemeValue->contents;
+
+   if (strcmp(name,"atoms") == 0)
+     { subsystem = ATOM_MEMORY; }
+   else if (strcmp(name,"facts") == 0)
+     { subsystem = FACT_MEMORY; }
+   else if (strcmp(name,"instances") == 0)
+     { subsystem = INSTANCE_MEMORY; }
+   else if (strcmp(name,"alpha") == 0)
+     { subsystem = ALPHA_MEMORY; }
+   else if (strcmp(name,"beta") == 0)
+     { subsystem = BETA_MEMORY; }
+   else if (strcmp(name,"agenda") == 0)
+     { subsystem = AGENDA_MEMORY; }
+   else
+     {
+      UDFInvalidArgumentMessage(context,"symbol with value atoms, facts, instances, alpha, beta, or agenda");
+      returnValue->integerValue = CreateInteger(theEnv,0);
+      return;
+     }
+
+   returnValue->integerValue = CreateInteger(theEnv,SubsystemMemPeak(theEnv,subsystem));
+  }
+
+/***********************************************/
+/* MemPeakResetCommand: H/L access routine for */
+/*   the mem-peak-reset command.               */
+/***********************************************/
+void MemPeakResetCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   ResetMemPeak(theEnv);
+  }
+
+/**************************************************/
+/* GarbageStatisticsCommand: H/L access routine   */
+/*   for the garbage-statistics command. Returns  */
+/*   the number of garbage sweeps, the number of  */
+/*   atoms and multifields reclaimed in total,    */
+/*   and the number reclaimed by the last sweep.  */
+/**************************************************/
+void GarbageStatisticsCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   GarbageStatistics theStats;
+   Multifield *theList;
+
+   GetGarbageStatistics(theEnv,&theStats);
+
+   theList = CreateMultifield(theEnv,5L);
+   theList->contents[0].integerValue = CreateInteger(theEnv,(long long) theStats.sweeps);
+   theList->contents[1].integerValue = CreateInteger(theEnv,(long long) theStats.atomsReclaimed);
+   theList->contents[2].integerValue = CreateInteger(theEnv,(long long) theStats.multifieldsReclaimed);
+   theList->contents[3].integerValue = CreateInteger(theEnv,(long long) theStats.lastAtomsReclaimed);
+   theList->contents[4].integerValue = CreateInteger(theEnv,(long long) theStats.lastMultifieldsReclaimed);
+
+   returnValue->begin = 0;
+   returnValue->range = 5;
+   returnValue->value = theList;
+  }
+
+/********************************************************/
+/* SetGarbageSweepIntervalCommand: H/L access routine   */
+/*   for the set-garbage-sweep-interval command.        */
+/********************************************************/
+void SetGarbageSweepIntervalCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   UDFValue theArg;
+
+   if (! UDFFirstArgument(context,INTEGER_BIT,&theArg))
+     { return; }
+
+   if (theArg.integerValue->contents < 0)
+     {
+      UDFInvalidArgumentMessage(context,"integer (greater than or equal to 0)");
+      returnValue->integerValue = CreateInteger(theEnv,(long long) GetGarbageSweepInterval(theEnv));
+      return;
+     }
+
+   returnValue->integerValue =
+      CreateInteger(theEnv,(long long) SetGarbageSweepInterval(theEnv,(unsigned long) theArg.integerValue->contents));
+  }
+
+/********************************************************/
+/* GetGarbageSweepIntervalCommand: H/L access routine   */
+/*   for the get-garbage-sweep-interval command.        */
+/********************************************************/
+void GetGarbageSweepIntervalCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   returnValue->integerValue = CreateInteger(theEnv,(long long) GetGarbageSweepInterval(theEnv));
+  }
+
 #endif
 
 /****************************************/
@@ -75,6 +75,11 @@
 /*                                                           */
 /*      6.50: Fact ?var:slot reference support.              */
 /*                                                           */
+/*            Added mem-peak, set-memory-limits, and         */
+/*            get-memory-limits functions.                   */
+/*                                                           */
+/*            Added mem-peak-reset command.                  */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_miscfun
@@ -94,8 +99,15 @@
    void                           LengthFunction(Environment *,UDFContext *,UDFValue *);
    void                           ConserveMemCommand(Environment *,UDFContext *,UDFValue *);
    void                           ReleaseMemCommand(Environment *,UDFContext *,UDFValue *);
+   void                           SetMemoryLimitsCommand(Environment *,UDFContext *,UDFValue *);
+   void                           GetMemoryLimitsCommand(Environment *,UDFContext *,UDFValue *);
    void                           MemUsedCommand(Environment *,UDFContext *,UDFValue *);
    void                           MemRequestsCommand(Environment *,UDFContext *,UDFValue *);
+   void                           MemPeakCommand(Environment *,UDFContext *,UDFValue *);
+   void                           MemPeakResetCommand(Environment *,UDFContext *,UDFValue *);
+   void                           GarbageStatisticsCommand(Environment *,UDFContext *,UDFValue *);
+   void                           SetGarbageSweepIntervalCommand(Environment *,UDFContext *,UDFValue *);
+   void                           GetGarbageSweepIntervalCommand(Environment *,UDFContext *,UDFValue *);
    void                           OptionsCommand(Environment *,UDFContext *,UDFValue *);
    void                           OperatingSystemFunction(Environment *,UDFContext *,UDFValue *);
    void                           ExpandFuncCall(Environment *,UDFContext *,UDFValue *);
@@ -50,6 +50,13 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: The construct index is invalidated when the    */
+/*            list of defmodules is replaced or a defmodule  */
+/*            is deleted.                                    */
+/*                                                           */
+/*            Compressed pretty print forms are expanded     */
+/*            when retrieved.                                */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -70,6 +77,8 @@
 #include "modulbsc.h"
 #include "modulcmp.h"
 #include "modulpsr.h"
+#include "modulutl.h"
+#include "pprint.h"
 #include "prntutil.h"
 #include "router.h"
 #include "utility.h"
@@ -116,6 +125,8 @@ static void DeallocateDefmoduleData(
    size_t space;
 #endif
 
+   InvalidateConstructIndex(theEnv);
+
 #if (BLOAD || BLOAD_ONLY || BLOAD_AND_BSAVE) && (! RUN_TIME)
    for (i = 0; i < DefmoduleData(theEnv)->BNumberOfDefmodules; i++)
      {
@@ -492,6 +503,8 @@ void SetListOfDefmodules(
   Environment *theEnv,
   Defmodule *defmodulePtr)
   {
+   InvalidateConstructIndex(theEnv);
+
    DefmoduleData(theEnv)->ListOfDefmodules = defmodulePtr;
    DefmoduleData(theEnv)->LastDefmodule = DefmoduleData(theEnv)->ListOfDefmodules;
 
@@ -537,7 +550,7 @@ const char *DefmoduleName(
 const char *DefmodulePPForm(
   Defmodule *defmodulePtr)
   {
-   return defmodulePtr->header.ppForm;
+   return ExpandPPForm(defmodulePtr->header.env,defmodulePtr->header.ppForm);
   }
 
 #if (! RUN_TIME)
@@ -585,6 +598,13 @@ static void ReturnDefmodule(
    if (! environmentClear)
      { SetCurrentModule(theEnv,theDefmodule); }
 
+   /*=============================================*/
+   /* The construct index may refer to the lists  */
+   /* of constructs belonging to this module.     */
+   /*=============================================*/
+
+   InvalidateConstructIndex(theEnv);
+
    /*============================================*/
    /* Call the free functions for the constructs */
    /* belonging to this module.                  */
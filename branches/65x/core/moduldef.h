@@ -50,6 +50,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added construct index to the defmodule data.   */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_moduldef
@@ -204,6 +206,16 @@ struct moduleStackItem
 
 #define DEFMODULE_DATA 4
 
+#ifndef CONSTRUCT_INDEX_SIZE
+#define CONSTRUCT_INDEX_SIZE 1021
+#endif
+
+struct constructIndexEntry
+  {
+   ConstructHeader *theConstruct;
+   struct constructIndexEntry *next;
+  };
+
 struct defmoduleData
   {
    struct moduleItem *LastModuleItem;
@@ -217,6 +229,10 @@ struct defmoduleData
    struct moduleItem *ListOfModuleItems;
    long ModuleChangeIndex;
    bool MainModuleRedefinable;
+   struct constructIndexEntry **ConstructIndex;
+   unsigned long ConstructIndexSize;
+   unsigned long ConstructIndexCount;
+   bool ConstructIndexValid;
 #if (! RUN_TIME) && (! BLOAD_ONLY)
    struct portConstructItem *ListOfPortConstructItems;
    long NumberOfDefmodules;
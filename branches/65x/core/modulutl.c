@@ -34,6 +34,9 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added a hashed index of construct names by     */
+/*            module for FindNamedConstructInModule.         */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -58,6 +61,9 @@
                                               Defmodule *,
                                               struct moduleItem *,CLIPSLexeme *,
                                               int *,int,Defmodule *);
+   static void                RebuildConstructIndex(Environment *);
+   static void                ResizeConstructIndex(Environment *,unsigned long);
+   static unsigned long       ConstructIndexHash(struct defmoduleItemHeader *,CLIPSLexeme *,unsigned long);
 
 /********************************************************************/
 /* FindModuleSeparator: Finds the :: separator which delineates the */
@@ -763,6 +769,251 @@ long DoForAllModules(
    return(moduleCount);
   }
   
+/********************************************************/
+/* FindIndexedConstruct: Returns the construct with the */
+/*   specified name in a module's list of constructs of */
+/*   one type, using the construct index rather than    */
+/*   searching the list. The index is rebuilt from the  */
+/*   lists of all modules if it has been invalidated.   */
+/********************************************************/
+ConstructHeader *FindIndexedConstruct(
+  Environment *theEnv,
+  struct defmoduleItemHeader *theModuleItem,
+  CLIPSLexeme *constructName)
+  {
+   struct constructIndexEntry *theEntry;
+
+   if (! DefmoduleData(theEnv)->ConstructIndexValid)
+     { RebuildConstructIndex(theEnv); }
+
+   if (DefmoduleData(theEnv)->ConstructIndex == NULL)
+     { return NULL; }
+
+   for (theEntry = DefmoduleData(theEnv)->ConstructIndex[ConstructIndexHash(theModuleItem,constructName,
+                                                                            DefmoduleData(theEnv)->ConstructIndexSize)];
+        theEntry != NULL;
+        theEntry = theEntry->next)
+     {
+      if ((theEntry->theConstruct->name == constructName) &&
+          (theEntry->theConstruct->whichModule == theModuleItem))
+        { return theEntry->theConstruct; }
+     }
+
+   return NULL;
+  }
+
+/********************************************************/
+/* AddConstructToIndex: Adds a construct that has been  */
+/*   added to its module's list to the construct index. */
+/*   Entries are appended to their bucket so that the   */
+/*   earliest of several same-named constructs is found */
+/*   first, as it would be when searching the list.     */
+/********************************************************/
+void AddConstructToIndex(
+  Environment *theEnv,
+  ConstructHeader *theConstruct)
+  {
+   struct constructIndexEntry *newEntry, *lastEntry;
+   unsigned long theBucket;
+
+   if (! DefmoduleData(theEnv)->ConstructIndexValid)
+     { return; }
+
+   if (DefmoduleData(theEnv)->ConstructIndexCount >= DefmoduleData(theEnv)->ConstructIndexSize)
+     {
+      ResizeConstructIndex(theEnv,(DefmoduleData(theEnv)->ConstructIndexSize == 0) ?
+                                  CONSTRUCT_INDEX_SIZE :
+                                  (DefmoduleData(theEnv)->ConstructIndexSize * 2) + 1);
+     }
+
+   newEntry = get_struct(theEnv,constructIndexEntry);
+   newEntry->theConstruct = theConstruct;
+   newEntry->next = NULL;
+
+   theBucket = ConstructIndexHash(theConstruct->whichModule,theConstruct->name,
+                                  DefmoduleData(theEnv)->ConstructIndexSize);
+   lastEntry = DefmoduleData(theEnv)->ConstructIndex[theBucket];
+   if (lastEntry == NULL)
+     { DefmoduleData(theEnv)->ConstructIndex[theBucket] = newEntry; }
+   else
+     {
+      while (lastEntry->next != NULL)
+        { lastEntry = lastEntry->next; }
+      lastEntry->next = newEntry;
+     }
+
+   DefmoduleData(theEnv)->ConstructIndexCount++;
+  }
+
+/**********************************************************/
+/* RemoveConstructFromIndex: Removes a construct that has */
+/*   been removed from its module's list from the index.  */
+/**********************************************************/
+void RemoveConstructFromIndex(
+  Environment *theEnv,
+  ConstructHeader *theConstruct)
+  {
+   struct constructIndexEntry *theEntry, *lastEntry = NULL;
+   unsigned long theBucket;
+
+   if ((! DefmoduleData(theEnv)->ConstructIndexValid) ||
+       (DefmoduleData(theEnv)->ConstructIndex == NULL))
+     { return; }
+
+   theBucket = ConstructIndexHash(theConstruct->whichModule,theConstruct->name,
+                                  DefmoduleData(theEnv)->ConstructIndexSize);
+
+   for (theEntry = DefmoduleData(theEnv)->ConstructIndex[theBucket];
+        theEntry != NULL;
+        lastEntry = theEntry, theEntry = theEntry->next)
+     {
+      if (theEntry->theConstruct == theConstruct)
+        {
+         if (lastEntry == NULL)
+           { DefmoduleData(theEnv)->ConstructIndex[theBucket] = theEntry->next; }
+         else
+           { lastEntry->next = theEntry->next; }
+
+         rtn_struct(theEnv,constructIndexEntry,theEntry);
+         DefmoduleData(theEnv)->ConstructIndexCount--;
+         return;
+        }
+     }
+  }
+
+/************************************************************/
+/* InvalidateConstructIndex: Discards the construct index.  */
+/*   Called whenever module construct lists are replaced or */
+/*   deallocated without going through AddConstructToIndex  */
+/*   and RemoveConstructFromIndex (such as when a binary    */
+/*   image is loaded or cleared, or a module is deleted).   */
+/*   The index is rebuilt by the next lookup.               */
+/************************************************************/
+void InvalidateConstructIndex(
+  Environment *theEnv)
+  {
+   struct constructIndexEntry *theEntry, *nextEntry;
+   unsigned long i;
+
+   DefmoduleData(theEnv)->ConstructIndexValid = false;
+
+   if (DefmoduleData(theEnv)->ConstructIndex == NULL)
+     { return; }
+
+   for (i = 0; i < DefmoduleData(theEnv)->ConstructIndexSize; i++)
+     {
+      for (theEntry = DefmoduleData(theEnv)->ConstructIndex[i];
+           theEntry != NULL;
+           theEntry = nextEntry)
+        {
+         nextEntry = theEntry->next;
+         rtn_struct(theEnv,constructIndexEntry,theEntry);
+        }
+     }
+
+   genfree(theEnv,DefmoduleData(theEnv)->ConstructIndex,
+           sizeof(struct constructIndexEntry *) * DefmoduleData(theEnv)->ConstructIndexSize);
+   DefmoduleData(theEnv)->ConstructIndex = NULL;
+   DefmoduleData(theEnv)->ConstructIndexSize = 0;
+   DefmoduleData(theEnv)->ConstructIndexCount = 0;
+  }
+
+/******************************************************/
+/* RebuildConstructIndex: Indexes the constructs in   */
+/*   the construct lists of every module.             */
+/******************************************************/
+static void RebuildConstructIndex(
+  Environment *theEnv)
+  {
+   Defmodule *theModule;
+   struct moduleItem *theItem;
+   struct defmoduleItemHeader *theHeader;
+   ConstructHeader *theConstruct;
+
+   InvalidateConstructIndex(theEnv);
+   DefmoduleData(theEnv)->ConstructIndexValid = true;
+
+   for (theModule = GetNextDefmodule(theEnv,NULL);
+        theModule != NULL;
+        theModule = GetNextDefmodule(theEnv,theModule))
+     {
+      if (theModule->itemsArray == NULL) continue;
+
+      for (theItem = DefmoduleData(theEnv)->ListOfModuleItems;
+           theItem != NULL;
+           theItem = theItem->next)
+        {
+         theHeader = theModule->itemsArray[theItem->moduleIndex];
+         if (theHeader == NULL) continue;
+
+         for (theConstruct = theHeader->firstItem;
+              theConstruct != NULL;
+              theConstruct = theConstruct->next)
+           { AddConstructToIndex(theEnv,theConstruct); }
+        }
+     }
+  }
+
+/****************************************************/
+/* ResizeConstructIndex: Rehashes the entries of    */
+/*   the construct index into a new bucket array.   */
+/****************************************************/
+static void ResizeConstructIndex(
+  Environment *theEnv,
+  unsigned long newSize)
+  {
+   struct constructIndexEntry **newIndex, *theEntry, *nextEntry, *lastEntry;
+   unsigned long i, theBucket;
+
+   newIndex = (struct constructIndexEntry **)
+              genalloc(theEnv,sizeof(struct constructIndexEntry *) * newSize);
+   for (i = 0; i < newSize; i++)
+     { newIndex[i] = NULL; }
+
+   for (i = 0; i < DefmoduleData(theEnv)->ConstructIndexSize; i++)
+     {
+      for (theEntry = DefmoduleData(theEnv)->ConstructIndex[i];
+           theEntry != NULL;
+           theEntry = nextEntry)
+        {
+         nextEntry = theEntry->next;
+         theEntry->next = NULL;
+         theBucket = ConstructIndexHash(theEntry->theConstruct->whichModule,
+                                        theEntry->theConstruct->name,newSize);
+         lastEntry = newIndex[theBucket];
+         if (lastEntry == NULL)
+           { newIndex[theBucket] = theEntry; }
+         else
+           {
+            while (lastEntry->next != NULL)
+              { lastEntry = lastEntry->next; }
+            lastEntry->next = theEntry;
+           }
+        }
+     }
+
+   if (DefmoduleData(theEnv)->ConstructIndex != NULL)
+     {
+      genfree(theEnv,DefmoduleData(theEnv)->ConstructIndex,
+              sizeof(struct constructIndexEntry *) * DefmoduleData(theEnv)->ConstructIndexSize);
+     }
+
+   DefmoduleData(theEnv)->ConstructIndex = newIndex;
+   DefmoduleData(theEnv)->ConstructIndexSize = newSize;
+  }
+
+/*************************************************/
+/* ConstructIndexHash: Computes the bucket of a  */
+/*   construct name within a module's list.      */
+/*************************************************/
+static unsigned long ConstructIndexHash(
+  struct defmoduleItemHeader *theModuleItem,
+  CLIPSLexeme *constructName,
+  unsigned long theSize)
+  {
+   return (unsigned long) ((constructName->bucket + (((size_t) theModuleItem) / sizeof(void *))) % theSize);
+  }
+
 #if (! RUN_TIME) && (! BLOAD_ONLY)
 
 /****************************************/
@@ -814,6 +1065,11 @@ void RemoveConstructFromModule(
 
    if (theConstruct == theConstruct->whichModule->lastItem)
      { theConstruct->whichModule->lastItem = lastConstruct; }
+   /*=================================*/
+   /* Remove it from the name index.  */
+   /*=================================*/
+
+   RemoveConstructFromIndex(theEnv,theConstruct);
   }
 
 /*********************************************************/
@@ -33,6 +33,8 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added construct index functions.               */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_modulutl
@@ -68,6 +70,10 @@ typedef void PrintItemFunction(Environment *,const char *,void *);
                                                   void (*)(Defmodule *,void *),
                                                   int,void *);
    bool                           ConstructExported(Environment *,const char *,CLIPSLexeme *,CLIPSLexeme *);
+   ConstructHeader               *FindIndexedConstruct(Environment *,struct defmoduleItemHeader *,CLIPSLexeme *);
+   void                           AddConstructToIndex(Environment *,ConstructHeader *);
+   void                           RemoveConstructFromIndex(Environment *,ConstructHeader *);
+   void                           InvalidateConstructIndex(Environment *);
 
 #if (! RUN_TIME) && (! BLOAD_ONLY)
    void                           RemoveConstructFromModule(Environment *,ConstructHeader *);
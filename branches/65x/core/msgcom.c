@@ -54,6 +54,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Compressed pretty print forms are expanded     */
+/*            when retrieved.                                */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -88,6 +91,7 @@
 #include "msgpass.h"
 #include "memalloc.h"
 #include "prccode.h"
+#include "pprint.h"
 #include "prntutil.h"
 #include "router.h"
 #if DEBUGGING_FUNCTIONS
@@ -615,7 +619,7 @@ void PPDefmessageHandlerCommand(
       return;
      }
    if (hnd->header.ppForm != NULL)
-     PrintInChunks(theEnv,WDISPLAY,hnd->header.ppForm);
+     PrintInChunks(theEnv,WDISPLAY,ExpandPPForm(theEnv,hnd->header.ppForm));
   }
 
 /*****************************************************************************
@@ -697,7 +701,7 @@ const char *DefmessageHandlerPPForm(
   Defclass *theDefclass,
   int theIndex)
   {
-   return theDefclass->handlers[theIndex-1].header.ppForm;
+   return ExpandPPForm(theDefclass->header.env,theDefclass->handlers[theIndex-1].header.ppForm);
   }
 
 /*******************************************************************
@@ -53,6 +53,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added the slot accessor cache.                 */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_msgcom
@@ -66,6 +68,23 @@
 
 #define MESSAGE_HANDLER_DATA 32
 
+/***************************************************
+  The slot accessor cache records, for a class and
+  message name, the default get- or put- handler of
+  a slot when it is the only handler which would be
+  executed for the message (or NULL when it is not)
+  so that the message can access the slot directly.
+ ***************************************************/
+
+#define SLOT_ACCESSOR_CACHE_SIZE 251
+
+struct slotAccessorCache
+  {
+   Defclass *cls;
+   CLIPSLexeme *message;
+   DefmessageHandler *hnd;
+  };
+
 struct messageHandlerData
   {
    EntityRecord HandlerGetInfo;
@@ -84,6 +103,7 @@ struct messageHandlerData
    HANDLER_LINK *TopOfCore;
    HANDLER_LINK *NextInCore;
    HANDLER_LINK *OldCore;
+   struct slotAccessorCache SlotAccessorCache[SLOT_ACCESSOR_CACHE_SIZE];
   };
 
 #define MessageHandlerData(theEnv) ((struct messageHandlerData *) GetEnvironmentData(theEnv,MESSAGE_HANDLER_DATA))
@@ -44,6 +44,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: The slot accessor cache is cleared when        */
+/*            handlers or class ids change.                  */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -335,6 +338,7 @@ DefmessageHandler *InsertHandlerHeader(
    cls->handlers = nhnd;
    cls->handlerOrderMap = narr;
    cls->handlerCount++;
+   ClearSlotAccessorCache(theEnv);
    return(&nhnd[cls->handlerCount-1]);
   }
 
@@ -513,6 +517,7 @@ void DeallocateMarkedHandlers(
      }
    if (count == 0)
      return;
+   ClearSlotAccessorCache(theEnv);
    if (count == cls->handlerCount)
      {
       rm(theEnv,cls->handlers,(sizeof(DefmessageHandler) * cls->handlerCount));
@@ -58,6 +58,10 @@
 /*            Added CLIPSBlockStart and CLIPSBlockEnd        */
 /*            functions for garbage collection blocks.       */
 /*                                                           */
+/*      6.50: Messages which only execute the default get-   */
+/*            or put- handler of a slot access the slot      */
+/*            directly.                                      */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -71,12 +75,17 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "argacces.h"
 #include "classcom.h"
 #include "classfun.h"
 #include "commline.h"
 #include "constrct.h"
+#include "cstrnchk.h"
+#if DEFRULE_CONSTRUCT
+#include "engine.h"
+#endif
 #include "envrnmnt.h"
 #include "exprnpsr.h"
 #include "inscom.h"
@@ -103,6 +112,10 @@
    static HANDLER_LINK           *FindApplicableHandlers(Environment *,Defclass *,CLIPSLexeme *);
    static void                    CallHandlers(Environment *,UDFValue *);
    static void                    EarlySlotBindError(Environment *,Instance *,Defclass *,unsigned);
+   static bool                    DirectSlotAccess(Environment *,Instance *,CLIPSLexeme *,UDFValue *);
+   static DefmessageHandler      *FindSlotAccessor(Environment *,Defclass *,CLIPSLexeme *);
+   static bool                    IsSlotAccessor(DefmessageHandler *);
+   static InstanceSlot           *FindReferencedSlot(Environment *,Instance *,HANDLER_SLOT_REFERENCE *);
 
 /* =========================================
    *****************************************
@@ -263,6 +276,24 @@ void SendCommand(
    PerformMessage(theEnv,returnValue,&args,msg);
   }
 
+/***************************************************
+  NAME         : ClearSlotAccessorCache
+  DESCRIPTION  : Removes all entries from the slot
+                 accessor cache
+  INPUTS       : None
+  RETURNS      : Nothing useful
+  SIDE EFFECTS : Cache cleared
+  NOTES        : Must be called whenever handlers
+                 are added or removed or class ids
+                 are assigned or released
+ ***************************************************/
+void ClearSlotAccessorCache(
+  Environment *theEnv)
+  {
+   memset(MessageHandlerData(theEnv)->SlotAccessorCache,0,
+          sizeof(struct slotAccessorCache) * SLOT_ACCESSOR_CACHE_SIZE);
+  }
+
 /***************************************************
   NAME         : GetNthMessageArgument
   DESCRIPTION  : Returns the address of the nth
@@ -1076,6 +1107,14 @@ static bool PerformMessage(
       return false;
      }
 
+   /* ==================================================
+      A message which would only execute the default get-
+      or put- handler of a slot accesses the slot directly
+      rather than building and calling the handler frame
+      ================================================== */
+   if ((ins != NULL) ? DirectSlotAccess(theEnv,ins,mname,returnValue) : false)
+     { goto MessageComplete; }
+
    /* oldCore = MessageHandlerData(theEnv)->TopOfCore; */
 
    if (MessageHandlerData(theEnv)->TopOfCore != NULL)
@@ -1153,6 +1192,7 @@ static bool PerformMessage(
    if (MessageHandlerData(theEnv)->OldCore != NULL)
      { MessageHandlerData(theEnv)->OldCore = MessageHandlerData(theEnv)->OldCore->nxtInStack; }
 
+MessageComplete:
    ProcedureFunctionData(theEnv)->ReturnFlag = false;
 
    if (ins != NULL)
@@ -1388,6 +1428,280 @@ static void CallHandlers(
   }
 
 
+/********************************************************
+  NAME         : DirectSlotAccess
+  DESCRIPTION  : Performs a message directly when the
+                 only handler which would be executed
+                 for it is a default get- or put-
+                 handler for a slot
+  INPUTS       : 1) The instance
+                 2) The message name
+                 3) Caller's result buffer
+  RETURNS      : True if the slot was accessed,
+                 false if the message must be
+                 dispatched to its handlers
+  SIDE EFFECTS : Slot read or written and caller's
+                 result buffer set
+  NOTES        : The message arguments must already
+                 be on the ProcParamArray. Any case
+                 which could produce an error or
+                 trace output (or which requires
+                 constraint checking) is left to the
+                 handler so that its behavior is
+                 unchanged.
+ ********************************************************/
+static bool DirectSlotAccess(
+  Environment *theEnv,
+  Instance *ins,
+  CLIPSLexeme *mname,
+  UDFValue *returnValue)
+  {
+   DefmessageHandler *hnd;
+   InstanceSlot *sp;
+   UDFValue *args;
+   UDFValue theSetVal;
+
+#if DEBUGGING_FUNCTIONS
+   if (MessageHandlerData(theEnv)->WatchMessages)
+     { return false; }
+#endif
+#if PROFILING_FUNCTIONS
+   if (ProfileFunctionData(theEnv)->ProfileConstructs)
+     { return false; }
+#endif
+
+   hnd = FindSlotAccessor(theEnv,ins->cls,mname);
+   if (hnd == NULL)
+     { return false; }
+
+#if DEBUGGING_FUNCTIONS
+   if (hnd->trace)
+     { return false; }
+#endif
+
+   sp = FindReferencedSlot(theEnv,ins,(HANDLER_SLOT_REFERENCE *) hnd->actions->bitMapValue->contents);
+   if (sp == NULL)
+     { return false; }
+
+   args = ProceduralPrimitiveData(theEnv)->ProcParamArray;
+
+   /* =========================================
+      A get- handler takes no arguments and
+      returns the value of the slot
+      ========================================= */
+   if (hnd->actions->type == HANDLER_GET)
+     {
+      if (ProceduralPrimitiveData(theEnv)->ProcParamArraySize != 1)
+        { return false; }
+
+      returnValue->value = sp->value;
+      if (sp->type == MULTIFIELD_TYPE)
+        {
+         returnValue->begin = 0;
+         returnValue->range = sp->multifieldValue->length;
+        }
+      return true;
+     }
+
+   /* ==============================================
+      A put- handler groups its arguments into a
+      multifield value. For a single-field slot the
+      one argument can be stored directly. No
+      arguments (which resets the slot) or a value
+      which violates the slot's constraints is left
+      to the handler.
+      ============================================== */
+   if (sp->desc->initializeOnly && (! ins->initializeInProgress))
+     { return false; }
+
+#if DEFRULE_CONSTRUCT
+   if (EngineData(theEnv)->JoinOperationInProgress && sp->desc->reactive &&
+       (ins->cls->reactive || sp->desc->shared))
+     { return false; }
+#endif
+
+   if ((ProceduralPrimitiveData(theEnv)->ProcParamArraySize < 2) ||
+       GetDynamicConstraintChecking(theEnv))
+     { return false; }
+
+   if (sp->desc->multiple)
+     { GrabProcWildargs(theEnv,&theSetVal,2); }
+   else
+     {
+      if ((ProceduralPrimitiveData(theEnv)->ProcParamArraySize != 2) ||
+          ((args[1].header->type == MULTIFIELD_TYPE) && (args[1].range != 1)))
+        { return false; }
+
+      theSetVal.value = args[1].value;
+      theSetVal.begin = args[1].begin;
+      theSetVal.range = args[1].range;
+     }
+
+   if (DirectPutSlotValue(theEnv,ins,sp,&theSetVal,returnValue) == false)
+     {
+      returnValue->value = FalseSymbol(theEnv);
+      SetEvaluationError(theEnv,true);
+     }
+
+   return true;
+  }
+
+/********************************************************
+  NAME         : FindSlotAccessor
+  DESCRIPTION  : Determines if the only handler which
+                 would be executed for a message sent
+                 to an instance of a class is a default
+                 get- or put- handler for a slot
+  INPUTS       : 1) The class
+                 2) The message name
+  RETURNS      : The handler, or NULL if the message
+                 must be dispatched normally
+  SIDE EFFECTS : Slot accessor cache entry set
+  NOTES        : Only the most specific primary
+                 handler is considered since a slot
+                 accessor never calls the handlers it
+                 shadows
+ ********************************************************/
+static DefmessageHandler *FindSlotAccessor(
+  Environment *theEnv,
+  Defclass *cls,
+  CLIPSLexeme *mname)
+  {
+   struct slotAccessorCache *theEntry;
+   Defclass *superclass;
+   DefmessageHandler *hnd, *primary = NULL;
+   long i;
+   int j, e;
+
+   theEntry = &MessageHandlerData(theEnv)->SlotAccessorCache[((cls->id * 31UL) + mname->bucket) % SLOT_ACCESSOR_CACHE_SIZE];
+
+   if ((theEntry->cls == cls) && (theEntry->message == mname))
+     { return theEntry->hnd; }
+
+   /* ===============================================
+      Search the class precedence list for handlers
+      of the message. Any around, before, or after
+      handler requires that the message be dispatched
+      normally.
+      =============================================== */
+   for (i = 0 ; i < cls->allSuperclasses.classCount ; i++)
+     {
+      superclass = cls->allSuperclasses.classArray[i];
+      j = FindHandlerNameGroup(superclass,mname);
+      if (j == -1)
+        { continue; }
+
+      e = ((int) superclass->handlerCount) - 1;
+      for ( ; j <= e ; j++)
+        {
+         hnd = &superclass->handlers[superclass->handlerOrderMap[j]];
+         if (hnd->header.name != mname)
+           { break; }
+
+         if (hnd->type != MPRIMARY)
+           {
+            primary = NULL;
+            goto StoreEntry;
+           }
+
+         if (primary == NULL)
+           { primary = hnd; }
+        }
+     }
+
+   if ((primary != NULL) && (! IsSlotAccessor(primary)))
+     { primary = NULL; }
+
+StoreEntry:
+   theEntry->cls = cls;
+   theEntry->message = mname;
+   theEntry->hnd = primary;
+
+   return primary;
+  }
+
+/********************************************************
+  NAME         : IsSlotAccessor
+  DESCRIPTION  : Determines if a handler has the form
+                 of a default slot accessor:
+
+                 (defmessage-handler <class> get-<slot> ()
+                    ?self:<slot>)
+
+                 (defmessage-handler <class> put-<slot> ($?value)
+                    (bind ?self:<slot> ?value))
+  INPUTS       : The handler
+  RETURNS      : True if the handler is a slot
+                 accessor, false otherwise
+  SIDE EFFECTS : None
+  NOTES        : A handler of this form defined by the
+                 user is equivalent to the default
+                 handler, so it can be treated the same
+ ********************************************************/
+static bool IsSlotAccessor(
+  DefmessageHandler *hnd)
+  {
+   Expression *theArg;
+
+   if ((hnd->actions == NULL) || (hnd->actions->nextArg != NULL))
+     { return false; }
+
+   if (hnd->actions->type == HANDLER_GET)
+     { return ((hnd->minParams == 1) && (hnd->maxParams == 1)); }
+
+   if (hnd->actions->type != HANDLER_PUT)
+     { return false; }
+
+   theArg = hnd->actions->argList;
+   if ((theArg == NULL) || (theArg->nextArg != NULL) ||
+       (theArg->type != PROC_WILD_PARAM) ||
+       (*((int *) theArg->bitMapValue->contents) != 2))
+     { return false; }
+
+   return ((hnd->minParams == 1) && (hnd->maxParams == -1));
+  }
+
+/********************************************************
+  NAME         : FindReferencedSlot
+  DESCRIPTION  : Finds the slot of an instance for a
+                 static slot reference in a handler
+  INPUTS       : 1) The instance
+                 2) The slot reference
+  RETURNS      : The instance slot, or NULL if the
+                 reference does not apply to the
+                 instance
+  SIDE EFFECTS : None
+  NOTES        : Uses the same checks as
+                 HandlerSlotGetFunction
+ ********************************************************/
+static InstanceSlot *FindReferencedSlot(
+  Environment *theEnv,
+  Instance *ins,
+  HANDLER_SLOT_REFERENCE *theReference)
+  {
+   Defclass *theDefclass;
+   unsigned instanceSlotIndex;
+   InstanceSlot *sp;
+
+   theDefclass = DefclassData(theEnv)->ClassIDMap[theReference->classID];
+
+   if (ins->cls == theDefclass)
+     { return ins->slotAddresses[ins->cls->slotNameMap[theReference->slotID] - 1]; }
+
+   if (theReference->slotID > ins->cls->maxSlotNameID)
+     { return NULL; }
+
+   instanceSlotIndex = ins->cls->slotNameMap[theReference->slotID];
+   if (instanceSlotIndex == 0)
+     { return NULL; }
+
+   sp = ins->slotAddresses[instanceSlotIndex - 1];
+   if (sp->desc->cls != theDefclass)
+     { return NULL; }
+
+   return sp;
+  }
+
 /********************************************************
   NAME         : EarlySlotBindError
   DESCRIPTION  : Prints out an error message when
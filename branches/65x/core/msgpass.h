@@ -50,6 +50,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added the slot accessor cache.                 */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_msgpass
@@ -75,6 +77,7 @@ typedef struct messageHandlerLink
    void             DestroyHandlerLinks(Environment *,HANDLER_LINK *);
    void             SendCommand(Environment *,UDFContext *,UDFValue *);
    UDFValue      *GetNthMessageArgument(Environment *,int);
+   void             ClearSlotAccessorCache(Environment *);
 
    bool             NextHandlerAvailable(Environment *);
    void             NextHandlerAvailableFunction(Environment *,UDFContext *,UDFValue *);
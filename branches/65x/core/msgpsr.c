@@ -46,6 +46,9 @@
 /*                                                           */
 /*            Static constraint checking is always enabled.  */
 /*                                                           */
+/*      6.50: The slot accessor cache is cleared when        */
+/*            handlers or class ids change.                  */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -281,6 +284,7 @@ bool ParseDefmessageHandler(
 
    if (hnd != NULL)
      {
+      ClearSlotAccessorCache(theEnv);
       ExpressionDeinstall(theEnv,hnd->actions);
       ReturnPackedExpression(theEnv,hnd->actions);
       if (hnd->header.ppForm != NULL)
@@ -54,6 +54,13 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Deallocated multifields discard their member$  */
+/*            position index.                                */
+/*                                                           */
+/*            Multifields are counted per garbage frame and  */
+/*            reclaimed multifields are added to the garbage */
+/*            statistics.                                    */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -65,6 +72,9 @@
 #include "evaluatn.h"
 #include "exprnops.h"
 #include "memalloc.h"
+#if MULTIFIELD_FUNCTIONS
+#include "multifun.h"
+#endif
 #if OBJECT_SYSTEM
 #include "object.h"
 #endif
@@ -110,6 +120,10 @@ void ReturnMultifield(
 
    if (theSegment == NULL) return;
 
+#if MULTIFIELD_FUNCTIONS
+   ForgetMemberIndex(theEnv,theSegment);
+#endif
+
    if (theSegment->length == 0) newSize = 1;
    else newSize = theSegment->length;
 
@@ -315,6 +329,7 @@ Multifield *CreateMultifield(
    theSegment->next = UtilityData(theEnv)->CurrentGarbageFrame->ListOfMultifields;
    UtilityData(theEnv)->CurrentGarbageFrame->ListOfMultifields = theSegment;
    UtilityData(theEnv)->CurrentGarbageFrame->dirty = true;
+   UtilityData(theEnv)->CurrentGarbageFrame->ephemeralCount++;
    if (UtilityData(theEnv)->CurrentGarbageFrame->LastMultifield == NULL)
      { UtilityData(theEnv)->CurrentGarbageFrame->LastMultifield = theSegment; }
 
@@ -351,6 +366,7 @@ void AddToMultifieldList(
    theSegment->next = UtilityData(theEnv)->CurrentGarbageFrame->ListOfMultifields;
    UtilityData(theEnv)->CurrentGarbageFrame->ListOfMultifields = theSegment;
    UtilityData(theEnv)->CurrentGarbageFrame->dirty = true;
+   UtilityData(theEnv)->CurrentGarbageFrame->ephemeralCount++;
    if (UtilityData(theEnv)->CurrentGarbageFrame->LastMultifield == NULL)
      { UtilityData(theEnv)->CurrentGarbageFrame->LastMultifield = theSegment; }
   }
@@ -363,6 +379,7 @@ void FlushMultifields(
   {
    Multifield *theSegment, *nextPtr, *lastPtr = NULL;
    unsigned long newSize;
+   unsigned long removed = 0;
 
    theSegment = UtilityData(theEnv)->CurrentGarbageFrame->ListOfMultifields;
    while (theSegment != NULL)
@@ -370,9 +387,13 @@ void FlushMultifields(
       nextPtr = theSegment->next;
       if (theSegment->busyCount == 0)
         {
+#if MULTIFIELD_FUNCTIONS
+         ForgetMemberIndex(theEnv,theSegment);
+#endif
          if (theSegment->length == 0) newSize = 1;
          else newSize = theSegment->length;
          rtn_var_struct(theEnv,multifield,sizeof(struct clipsValue) * (newSize - 1),theSegment);
+         removed++;
          if (lastPtr == NULL) UtilityData(theEnv)->CurrentGarbageFrame->ListOfMultifields = nextPtr;
          else lastPtr->next = nextPtr;
 
@@ -390,6 +411,8 @@ void FlushMultifields(
 
       theSegment = nextPtr;
      }
+
+   UtilityData(theEnv)->GarbageStats.multifieldsReclaimed += removed;
   }
 
 /********************/
@@ -71,6 +71,10 @@
 /*                                                           */
 /*      6.50: Fact ?var:slot references in progn$/foreach.   */
 /*                                                           */
+/*            Block copies in insert$, replace$, and delete$ */
+/*            and a position index for member$ searches of   */
+/*            large, installed multifields.                  */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -123,6 +127,9 @@ typedef struct fieldVarStack
    static struct expr            *ForeachParser(Environment *,struct expr *,const char *);
    static void                    ReplaceMvPrognFieldVars(Environment *,CLIPSLexeme *,struct expr *,int);
 #endif /* (! BLOAD_ONLY) && (! RUN_TIME) */
+   static bool                    FindDOInMemberIndex(Environment *,UDFValue *,UDFValue *,long *,long *,bool *);
+   static bool                    BuildMemberIndex(Environment *,Multifield *);
+   static void                    DeallocateMultiFunctionData(Environment *);
 #endif /* MULTIFIELD_FUNCTIONS */
    static void                    MVRangeError(Environment *,long,long,long,const char *);
 #endif /* MULTIFIELD_FUNCTIONS || OBJECT_SYSTEM */
@@ -135,9 +142,29 @@ typedef struct fieldVarStack
 
 #define MULTIFUN_DATA 10
 
+#define MEMBER_INDEX_THRESHOLD 256
+
+struct memberIndexEntry
+  {
+   void *value;
+   long first;
+  };
+
+struct memberIndex
+  {
+   Multifield *owner;
+   unsigned long tableSize;
+   struct memberIndexEntry *table;
+   long *nextPosition;
+   long length;
+  };
+
 struct multiFunctionData
   {
    FIELD_VAR_STACK *FieldVarStack;
+   long MemberIndexThreshold;
+   Multifield *MemberIndexCandidate;
+   struct memberIndex MemberIndex;
   };
 
 #define MultiFunctionData(theEnv) ((struct multiFunctionData *) GetEnvironmentData(theEnv,MULTIFUN_DATA))
@@ -149,7 +176,8 @@ struct multiFunctionData
 void MultifieldFunctionDefinitions(
   Environment *theEnv)
   {
-   AllocateEnvironmentData(theEnv,MULTIFUN_DATA,sizeof(struct multiFunctionData),NULL);
+   AllocateEnvironmentData(theEnv,MULTIFUN_DATA,sizeof(struct multiFunctionData),DeallocateMultiFunctionData);
+   MultiFunctionData(theEnv)->MemberIndexThreshold = MEMBER_INDEX_THRESHOLD;
 
 #if ! RUN_TIME
    AddUDF(theEnv,"first$","m",1,1,"m",FirstFunction,"FirstFunction",NULL);
@@ -179,6 +207,16 @@ void MultifieldFunctionDefinitions(
 #endif
   }
 
+/*************************************************/
+/* DeallocateMultiFunctionData: Deallocates the  */
+/*    environment data for multifield functions. */
+/*************************************************/
+static void DeallocateMultiFunctionData(
+  Environment *theEnv)
+  {
+   ForgetMemberIndex(theEnv,NULL);
+  }
+
 /****************************************/
 /* DeleteFunction: H/L access routine   */
 /*   for the delete$ function.          */
@@ -728,6 +766,7 @@ void MemberFunction(
   {
    UDFValue item1, item2;
    long j, k;
+   bool found;
 
    returnValue->lexemeValue = FalseSymbol(theEnv);
 
@@ -735,7 +774,10 @@ void MemberFunction(
 
    if (! UDFNextArgument(context,MULTIFIELD_BIT,&item2)) return;
 
-   if (FindDOsInSegment(&item1,1,&item2,&j,&k,NULL,0))
+   if (! FindDOInMemberIndex(theEnv,&item1,&item2,&j,&k,&found))
+     { found = FindDOsInSegment(&item1,1,&item2,&j,&k,NULL,0); }
+
+   if (found)
      {
       if (j == k)
         {
@@ -802,6 +844,231 @@ bool FindDOsInSegment(
    return false;
   }
 
+/******************************************************************/
+/* FindDOInMemberIndex: Searches for a value (or a sequence of    */
+/*   values) in a multifield segment using a position index. The  */
+/*   index is only built for installed multifields (which are not */
+/*   modified while installed) at least as long as the index      */
+/*   threshold, and only once the same multifield has been        */
+/*   searched twice in succession. Returns true if the index was  */
+/*   used (with the result of the search stored in found), or     */
+/*   false if a linear search must be performed instead.          */
+/******************************************************************/
+static bool FindDOInMemberIndex(
+  Environment *theEnv,
+  UDFValue *searchDO,
+  UDFValue *value,
+  long *si,
+  long *ei,
+  bool *found)
+  {
+   struct memberIndex *theIndex = &MultiFunctionData(theEnv)->MemberIndex;
+   Multifield *theMultifield = value->multifieldValue;
+   void *firstValue;
+   unsigned long bucket;
+   long pos, slen, k, segmentEnd;
+
+   if ((MultiFunctionData(theEnv)->MemberIndexThreshold <= 0) ||
+       (theMultifield->length < MultiFunctionData(theEnv)->MemberIndexThreshold) ||
+       (theMultifield->busyCount == 0))
+     { return false; }
+
+   /*========================================================*/
+   /* Build the index on the second consecutive search of a  */
+   /* multifield so that one-off searches don't pay for it.  */
+   /*========================================================*/
+
+   if (theIndex->owner != theMultifield)
+     {
+      if (MultiFunctionData(theEnv)->MemberIndexCandidate != theMultifield)
+        {
+         MultiFunctionData(theEnv)->MemberIndexCandidate = theMultifield;
+         return false;
+        }
+
+      if (! BuildMemberIndex(theEnv,theMultifield))
+        { return false; }
+     }
+
+   /*===========================================*/
+   /* Determine the first value to look up and  */
+   /* the length of the sequence to be matched. */
+   /*===========================================*/
+
+   if (searchDO->header->type == MULTIFIELD_TYPE)
+     {
+      slen = searchDO->range;
+      if (slen == 0)
+        { return false; }
+      firstValue = searchDO->multifieldValue->contents[searchDO->begin].value;
+     }
+   else
+     {
+      slen = 1;
+      firstValue = searchDO->value;
+     }
+
+   /*=============================================*/
+   /* Walk the positions of the first value which */
+   /* fall within the segment being searched.     */
+   /*=============================================*/
+
+   bucket = (((unsigned long) firstValue) >> 3) & (theIndex->tableSize - 1);
+   while ((theIndex->table[bucket].value != NULL) &&
+          (theIndex->table[bucket].value != firstValue))
+     { bucket = (bucket + 1) & (theIndex->tableSize - 1); }
+
+   *found = false;
+
+   if (theIndex->table[bucket].value == NULL)
+     { return true; }
+
+   segmentEnd = value->begin + value->range;
+
+   for (pos = theIndex->table[bucket].first;
+        pos != -1;
+        pos = theIndex->nextPosition[pos])
+     {
+      if (pos < value->begin) continue;
+      if ((pos + slen) > segmentEnd) break;
+
+      for (k = 1 ; k < slen ; k++)
+        {
+         if (searchDO->multifieldValue->contents[searchDO->begin + k].value !=
+             theMultifield->contents[pos + k].value)
+           { break; }
+        }
+
+      if (k >= slen)
+        {
+         *si = pos - value->begin + 1;
+         *ei = *si + slen - 1;
+         *found = true;
+         return true;
+        }
+     }
+
+   return true;
+  }
+
+/**************************************************/
+/* BuildMemberIndex: Creates the position index   */
+/*   for a multifield, replacing any prior index. */
+/**************************************************/
+static bool BuildMemberIndex(
+  Environment *theEnv,
+  Multifield *theMultifield)
+  {
+   struct memberIndex *theIndex = &MultiFunctionData(theEnv)->MemberIndex;
+   unsigned long tableSize, bucket;
+   long i;
+   void *theValue;
+
+   ForgetMemberIndex(theEnv,NULL);
+
+   tableSize = 16;
+   while (tableSize < (unsigned long) (theMultifield->length * 2))
+     { tableSize *= 2; }
+
+   theIndex->table = (struct memberIndexEntry *)
+                     genalloc(theEnv,sizeof(struct memberIndexEntry) * tableSize);
+   theIndex->nextPosition = (long *) genalloc(theEnv,sizeof(long) * (size_t) theMultifield->length);
+   theIndex->tableSize = tableSize;
+   theIndex->length = theMultifield->length;
+
+   for (bucket = 0 ; bucket < tableSize ; bucket++)
+     {
+      theIndex->table[bucket].value = NULL;
+      theIndex->table[bucket].first = -1;
+     }
+
+   /*=========================================================*/
+   /* Positions are linked in reverse so that each chain ends */
+   /* up in ascending order, beginning with the first match.  */
+   /*=========================================================*/
+
+   for (i = theMultifield->length - 1 ; i >= 0 ; i--)
+     {
+      theValue = theMultifield->contents[i].value;
+      bucket = (((unsigned long) theValue) >> 3) & (tableSize - 1);
+      while ((theIndex->table[bucket].value != NULL) &&
+             (theIndex->table[bucket].value != theValue))
+        { bucket = (bucket + 1) & (tableSize - 1); }
+
+      theIndex->table[bucket].value = theValue;
+      theIndex->nextPosition[i] = theIndex->table[bucket].first;
+      theIndex->table[bucket].first = i;
+     }
+
+   theIndex->owner = theMultifield;
+   MultiFunctionData(theEnv)->MemberIndexCandidate = NULL;
+
+   return true;
+  }
+
+/*****************************************************/
+/* ForgetMemberIndex: Discards the member$ index if  */
+/*   it belongs to the specified multifield (or      */
+/*   unconditionally if the multifield is NULL).     */
+/*   Called whenever a multifield is deallocated.    */
+/*****************************************************/
+void ForgetMemberIndex(
+  Environment *theEnv,
+  Multifield *theMultifield)
+  {
+   struct memberIndex *theIndex = &MultiFunctionData(theEnv)->MemberIndex;
+
+   if (MultiFunctionData(theEnv)->MemberIndexCandidate == theMultifield)
+     { MultiFunctionData(theEnv)->MemberIndexCandidate = NULL; }
+
+   if (theIndex->owner == NULL)
+     { return; }
+
+   if ((theMultifield != NULL) && (theIndex->owner != theMultifield))
+     { return; }
+
+   genfree(theEnv,theIndex->table,sizeof(struct memberIndexEntry) * theIndex->tableSize);
+   genfree(theEnv,theIndex->nextPosition,sizeof(long) * (size_t) theIndex->length);
+
+   theIndex->owner = NULL;
+   theIndex->table = NULL;
+   theIndex->nextPosition = NULL;
+   theIndex->tableSize = 0;
+   theIndex->length = 0;
+  }
+
+/**************************************************/
+/* SetMemberIndexThreshold: Sets the minimum      */
+/*   multifield length for which member$ uses a   */
+/*   position index. A value of 0 disables the    */
+/*   index. Returns the previous threshold.       */
+/**************************************************/
+long SetMemberIndexThreshold(
+  Environment *theEnv,
+  long threshold)
+  {
+   long ov = MultiFunctionData(theEnv)->MemberIndexThreshold;
+
+   if (threshold < 0) threshold = 0;
+
+   MultiFunctionData(theEnv)->MemberIndexThreshold = threshold;
+   if (threshold == 0)
+     { ForgetMemberIndex(theEnv,NULL); }
+
+   return ov;
+  }
+
+/**************************************************/
+/* GetMemberIndexThreshold: Returns the minimum   */
+/*   multifield length for which member$ uses a   */
+/*   position index.                              */
+/**************************************************/
+long GetMemberIndexThreshold(
+  Environment *theEnv)
+  {
+   return MultiFunctionData(theEnv)->MemberIndexThreshold;
+  }
+
 /*****************/
 /* MVRangeCheck: */
 /*****************/
@@ -1268,9 +1535,8 @@ bool ReplaceMultiValueField(
   UDFValue *field,
   const char *funcName)
   {
-   long i,j,k;
-   CLIPSValue *deptr;
-   CLIPSValue *septr;
+   long i;
+   CLIPSValue *contents;
    long srclen,dstlen;
 
    srclen = ((src != NULL) ? src->range : 0);
@@ -1290,34 +1556,24 @@ bool ReplaceMultiValueField(
    dst->begin = 0;
    dst->value = CreateMultifield(theEnv,dstlen);
    dst->range = dstlen;
-   for (i = 0 , j = src->begin ; j < rb ; i++ , j++)
-	 {
-	  deptr = &dst->multifieldValue->contents[i];
-	  septr = &src->multifieldValue->contents[j];
-	  deptr->value = septr->value;
-	 }
+   contents = dst->multifieldValue->contents;
+
+   /*=================================================*/
+   /* Copy the fields before the replaced range, then */
+   /* the new field(s), then the fields following the */
+   /* range as contiguous blocks.                     */
+   /*=================================================*/
+
+   i = rb - src->begin;
+   GenCopyMemory(CLIPSValue,i,contents,&src->multifieldValue->contents[src->begin]);
    if (field->header->type != MULTIFIELD_TYPE)
-	 {
-	  deptr = &dst->multifieldValue->contents[i++];
-	  deptr->value = field->value;
-	 }
+	 { contents[i++].value = field->value; }
    else
 	 {
-	  for (k = field->begin ; k < (field->begin + field->range) ; k++ , i++)
-		{
-		 deptr = &dst->multifieldValue->contents[i];
-		 septr = &field->multifieldValue->contents[k];
-		 deptr->value = septr->value;
-		}
-	 }
-   while (j < re)
-	 j++;
-   for (j++ ; i < dstlen ; i++ , j++)
-	 {
-	  deptr = &dst->multifieldValue->contents[i];
-	  septr = &src->multifieldValue->contents[j];
-	  deptr->value = septr->value;
+	  GenCopyMemory(CLIPSValue,field->range,&contents[i],&field->multifieldValue->contents[field->begin]);
+	  i += field->range;
 	 }
+   GenCopyMemory(CLIPSValue,dstlen - i,&contents[i],&src->multifieldValue->contents[re + 1]);
    return true;
   }
 
@@ -1344,8 +1600,8 @@ bool InsertMultiValueField(
   UDFValue *field,
   const char *funcName)
   {
-   long i,j,k;
-   CLIPSValue *deptr, *septr;
+   long i;
+   CLIPSValue *contents;
    long srclen,dstlen;
 
    srclen = (long) ((src != NULL) ? src->range : 0);
@@ -1368,42 +1624,33 @@ bool InsertMultiValueField(
         {
          dst->value = CreateMultifield(theEnv,0L);
          dst->range = 1;
-         deptr = &dst->multifieldValue->contents[0];
-         deptr->value = field->value;
+         dst->multifieldValue->contents[0].value = field->value;
         }
       return true;
      }
    dstlen = (field->header->type == MULTIFIELD_TYPE) ? field->range + srclen : srclen + 1;
    dst->value = CreateMultifield(theEnv,dstlen);
    dst->range = dstlen;
+   contents = dst->multifieldValue->contents;
    theIndex--;
-   for (i = 0 , j = src->begin ; i < theIndex ; i++ , j++)
-     {
-      deptr = &dst->multifieldValue->contents[i];
-      septr = &src->multifieldValue->contents[j];
-      deptr->value = septr->value;
-     }
+
+   /*===============================================*/
+   /* Copy the fields before the insertion point,   */
+   /* then the new field(s), then the remainder of  */
+   /* the source segment as contiguous blocks.      */
+   /*===============================================*/
+
+   GenCopyMemory(CLIPSValue,theIndex,contents,&src->multifieldValue->contents[src->begin]);
+   i = theIndex;
    if (field->header->type != MULTIFIELD_TYPE)
-     {
-      deptr = &dst->multifieldValue->contents[theIndex];
-      deptr->value = field->value;
-      i++;
-     }
+     { contents[i++].value = field->value; }
    else
      {
-      for (k = field->begin ; k < (field->begin + field->range) ; k++ , i++)
-        {
-         deptr = &dst->multifieldValue->contents[i];
-         septr = &field->multifieldValue->contents[k];
-         deptr->value = septr->value;
-        }
-     }
-   for ( ; j < (src->begin + src->range) ; i++ , j++)
-     {
-      deptr = &dst->multifieldValue->contents[i];
-      septr = &src->multifieldValue->contents[j];
-      deptr->value = septr->value;
+      GenCopyMemory(CLIPSValue,field->range,&contents[i],&field->multifieldValue->contents[field->begin]);
+      i += field->range;
      }
+   GenCopyMemory(CLIPSValue,srclen - theIndex,&contents[i],
+                 &src->multifieldValue->contents[src->begin + theIndex]);
    return true;
   }
 
@@ -1471,8 +1718,7 @@ bool DeleteMultiValueField(
   long re,
   const char *funcName)
   {
-   long i,j;
-   CLIPSValue *deptr, *septr;
+   CLIPSValue *contents;
    long srclen, dstlen;
 
    srclen = (long) ((src != NULL) ? src->range : 0);
@@ -1495,20 +1741,10 @@ bool DeleteMultiValueField(
    dstlen = srclen-(re-rb+1);
    dst->range = dstlen;
    dst->value = CreateMultifield(theEnv,dstlen);
-   for (i = 0 , j = src->begin ; j < rb ; i++ , j++)
-     {
-      deptr = &dst->multifieldValue->contents[i];
-      septr = &src->multifieldValue->contents[j];
-      deptr->value = septr->value;
-     }
-   while (j < re)
-     j++;
-   for (j++ ; i < (dst->begin + dst->range) ; j++ , i++)
-     {
-      deptr = &dst->multifieldValue->contents[i];
-      septr = &src->multifieldValue->contents[j];
-      deptr->value = septr->value;
-     }
+   contents = dst->multifieldValue->contents;
+   GenCopyMemory(CLIPSValue,rb - src->begin,contents,&src->multifieldValue->contents[src->begin]);
+   GenCopyMemory(CLIPSValue,dstlen - (rb - src->begin),&contents[rb - src->begin],
+                 &src->multifieldValue->contents[re + 1]);
    return true;
   }
 
@@ -82,6 +82,9 @@
    void                    GetMvPrognIndex(Environment *,UDFContext *,UDFValue *);
    bool                    FindDOsInSegment(UDFValue *,int,UDFValue *,
                                             long *,long *,long *,int);
+   void                    ForgetMemberIndex(Environment *,Multifield *);
+   long                    SetMemberIndexThreshold(Environment *,long);
+   long                    GetMemberIndexThreshold(Environment *);
 #endif
    bool                    ReplaceMultiValueField(Environment *,UDFValue *,
                                                   UDFValue *,
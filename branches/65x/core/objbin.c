@@ -35,6 +35,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: The slot accessor cache is cleared when        */
+/*            handlers or class ids change.                  */
+/*                                                           */
 /*************************************************************/
 
 /* =========================================
@@ -1075,6 +1078,7 @@ static void BloadStorageObjects(
       space = (sizeof(Defclass) * ObjectBinaryData(theEnv)->ClassCount);
       ObjectBinaryData(theEnv)->DefclassArray = (Defclass *) genalloc(theEnv,space);
       DefclassData(theEnv)->ClassIDMap = (Defclass **) gm2(theEnv,(sizeof(Defclass *) * DefclassData(theEnv)->MaxClassID));
+      ClearSlotAccessorCache(theEnv);
      }
    if (ObjectBinaryData(theEnv)->LinkCount != 0L)
      {
@@ -1390,6 +1394,7 @@ static void ClearBloadObjects(
       DefclassData(theEnv)->ClassIDMap = NULL;
       DefclassData(theEnv)->MaxClassID = 0;
       DefclassData(theEnv)->AvailClassID = 0;
+      ClearSlotAccessorCache(theEnv);
       for (i = 0L ; i < ObjectBinaryData(theEnv)->ClassCount ; i++)
         {
          UnmarkConstructHeader(theEnv,&ObjectBinaryData(theEnv)->DefclassArray[i].header);
@@ -26,6 +26,9 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added the queued object match action to        */
+/*            instances.                                     */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_object
@@ -197,6 +200,7 @@ struct instance
                  *prvList,*nxtList;
    InstanceSlot **slotAddresses,
                  *slots;
+   struct objectMatchAction *matchAction;
   };
 
 struct defmessageHandler
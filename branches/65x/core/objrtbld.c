@@ -52,6 +52,12 @@
 /*                                                           */
 /*            Removed initial-object support.                */
 /*                                                           */
+/*      6.50: Object patterns do not supply a match estimate */
+/*            for cost-based join ordering.                  */
+/*                                                           */
+/*            Per-class terminal pattern node lists are      */
+/*            released when an object pattern is detached.   */
+/*                                                           */
 /*************************************************************/
 /* =========================================
    *****************************************
@@ -233,6 +239,7 @@ void SetupObjectPatternStuff(
    newPtr->genComparePNValuesFunction = ObjectPNVariableComparison;
    newPtr->returnUserDataFunction = DeleteClassBitMap;
    newPtr->copyUserDataFunction = CopyClassBitMap;
+   newPtr->estimateMatchesFunction = NULL;
 
    newPtr->markIRPatternFunction = MarkObjectPtnIncrementalReset;
    newPtr->incrementalResetFunction = ObjectIncrementalReset;
@@ -1057,6 +1064,13 @@ static void DetachObjectPattern(
    if (alphaPtr->slotbmp != NULL)
      { DecrementBitMapReferenceCount(theEnv,alphaPtr->slotbmp); }
 
+   /*=======================================*/
+   /* Discard the per-class terminal lists, */
+   /* since they may refer to this pattern. */
+   /*=======================================*/
+
+   ReleaseClassTerminalLists(theEnv);
+
    /*=========================================*/
    /* Only continue deleting this pattern if  */
    /* this is the last alpha memory attached. */
@@ -43,6 +43,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Per-class terminal pattern node lists are      */
+/*            released with the object rete data.            */
+/*                                                           */
 /*************************************************************/
 /* =========================================
    *****************************************
@@ -253,6 +256,8 @@ static void DeallocateObjectReteData(
   {
    OBJECT_PATTERN_NODE *theNetwork;
 
+   ReleaseClassTerminalLists(theEnv);
+
 #if BLOAD || BLOAD_AND_BSAVE
    if (Bloaded(theEnv)) return;
 #endif
@@ -43,6 +43,11 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added per-class terminal pattern node lists.   */
+/*                                                           */
+/*            Added the bottom and last retract action of    */
+/*            the object match action queue.                 */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_objrtfnx
@@ -196,8 +201,12 @@ struct objectReteData
    struct entityRecord JNSimpleCompareInfo2;
    struct entityRecord JNSimpleCompareInfo3;
    OBJECT_MATCH_ACTION *ObjectMatchActionQueue;
+   OBJECT_MATCH_ACTION *ObjectMatchActionQueueBottom;
+   OBJECT_MATCH_ACTION *ObjectMatchActionLastRetract;
    OBJECT_PATTERN_NODE *ObjectPatternNetworkPointer;
    OBJECT_ALPHA_NODE *ObjectPatternNetworkTerminalPointer;
+   CLASS_TERMINAL_LISTS **ClassTerminalLists;
+   unsigned ClassTerminalListsSize;
    bool DelayObjectPatternMatching;
    unsigned long long CurrentObjectMatchTimeTag;
    long long UseEntityTimeTag;
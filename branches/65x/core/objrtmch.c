@@ -56,6 +56,20 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Object pattern matching visits only the        */
+/*            terminal pattern nodes applicable to the       */
+/*            object's class (and changed slots) using per-  */
+/*            class lists built on demand.                   */
+/*                                                           */
+/*            Queued object match actions are referenced by  */
+/*            their instance so that events are merged       */
+/*            without searching the queue. The queue is      */
+/*            grouped by class before it is processed.       */
+/*                                                           */
+/*            Logical dependencies are no longer detached    */
+/*            while an instance's pattern matches are        */
+/*            retracted.                                     */
+/*                                                           */
 /**************************************************************/
 /* =========================================
    *****************************************
@@ -94,8 +108,14 @@
    static void                    QueueObjectMatchAction(Environment *,int,Instance *,int);
    static SLOT_BITMAP            *QueueModifySlotMap(Environment *,SLOT_BITMAP *,int);
    static void                    ReturnObjectMatchAction(Environment *,OBJECT_MATCH_ACTION *);
+   static void                    LinkObjectMatchAction(Environment *,OBJECT_MATCH_ACTION *,OBJECT_MATCH_ACTION *);
+   static void                    UnlinkObjectMatchAction(Environment *,OBJECT_MATCH_ACTION *);
    static void                    ProcessObjectMatchQueue(Environment *);
+   static void                    GroupObjectMatchActions(Environment *);
    static void                    MarkObjectPatternNetwork(Environment *,SLOT_BITMAP *);
+   static void                    MarkObjectTerminal(Environment *,OBJECT_ALPHA_NODE *);
+   static CLASS_TERMINAL_LISTS   *GetClassTerminalLists(Environment *,unsigned);
+   static CLASS_TERMINAL_LISTS   *BuildClassTerminalLists(Environment *,unsigned);
    static bool                    CompareSlotBitMaps(SLOT_BITMAP *,SLOT_BITMAP *);
    static void                    ObjectPatternMatch(Environment *,int,OBJECT_PATTERN_NODE *,struct multifieldMarker *);
    static void                    ProcessPatternNode(Environment *,int,OBJECT_PATTERN_NODE *,struct multifieldMarker *);
@@ -250,9 +270,66 @@ void SetObjectNetworkTerminalPointer(
   Environment *theEnv,
   OBJECT_ALPHA_NODE *value)
   {
+   ReleaseClassTerminalLists(theEnv);
    ObjectReteData(theEnv)->ObjectPatternNetworkTerminalPointer = value;
   }
 
+/*******************************************************
+  NAME         : ReleaseClassTerminalLists
+  DESCRIPTION  : Deallocates the per-class lists of
+                 terminal pattern nodes used to find
+                 the patterns applicable to an object
+  INPUTS       : None
+  RETURNS      : Nothing useful
+  SIDE EFFECTS : Lists deallocated (they are rebuilt
+                 on demand by the next object match)
+  NOTES        : Must be called whenever terminal
+                 pattern nodes are added or removed
+ *******************************************************/
+void ReleaseClassTerminalLists(
+  Environment *theEnv)
+  {
+   CLASS_TERMINAL_LISTS *theLists;
+   unsigned i;
+   unsigned short slotID;
+
+   if (ObjectReteData(theEnv)->ClassTerminalLists == NULL)
+     return;
+
+   for (i = 0 ; i < ObjectReteData(theEnv)->ClassTerminalListsSize ; i++)
+     {
+      theLists = ObjectReteData(theEnv)->ClassTerminalLists[i];
+      if (theLists == NULL)
+        continue;
+
+      if (theLists->allSlots.terminals != NULL)
+        {
+         genfree(theEnv,theLists->allSlots.terminals,
+                 sizeof(OBJECT_ALPHA_NODE *) * theLists->allSlots.count);
+        }
+
+      if (theLists->slotLists != NULL)
+        {
+         for (slotID = 0 ; slotID < theLists->slotListCount ; slotID++)
+           {
+            if (theLists->slotLists[slotID].terminals != NULL)
+              {
+               genfree(theEnv,theLists->slotLists[slotID].terminals,
+                       sizeof(OBJECT_ALPHA_NODE *) * theLists->slotLists[slotID].count);
+              }
+           }
+         genfree(theEnv,theLists->slotLists,sizeof(OBJECT_TERMINAL_LIST) * theLists->slotListCount);
+        }
+
+      rtn_struct(theEnv,classTerminalLists,theLists);
+     }
+
+   genfree(theEnv,ObjectReteData(theEnv)->ClassTerminalLists,
+           sizeof(CLASS_TERMINAL_LISTS *) * ObjectReteData(theEnv)->ClassTerminalListsSize);
+   ObjectReteData(theEnv)->ClassTerminalLists = NULL;
+   ObjectReteData(theEnv)->ClassTerminalListsSize = 0;
+  }
+
 /************************************************************************
   NAME         : ObjectNetworkAction
   DESCRIPTION  : Main driver for pattern-matching on objects
@@ -421,83 +498,80 @@ static void QueueObjectMatchAction(
   Instance *ins,
   int slotNameID)
   {
-   OBJECT_MATCH_ACTION *prv,*cur,*newMatch;
-   OBJECT_MATCH_ACTION *prvRetract = NULL; /* DR0873 */
-
-   prv = NULL;
-   cur = ObjectReteData(theEnv)->ObjectMatchActionQueue;
-   while (cur != NULL)
+   OBJECT_MATCH_ACTION *cur,*newMatch;
+
+   /* ===========================================================
+      An instance has at most one event on the queue, which the
+      instance references directly. Here are the possibilities
+      for that event as compared with the new event:
+
+      Assert/Retract  -->  Delete assert event
+                           Ignore retract event
+      Assert/Modify   -->  Ignore modify event
+      Modify/Modify   -->  Merge new modify event
+      Modify/Retract  -->  Delete modify event
+                           Queue the retract event
+      =========================================================== */
+   cur = ins->matchAction;
+   if (cur != NULL)
      {
-      /* ===========================================================
-         Here are the possibilities for the first Rete event already
-         on the queue as compared with the new event for an object:
-
-         Assert/Retract  -->  Delete assert event
-                              Ignore retract event
-         Assert/Modify   -->  Ignore modify event
-         Modify/Modify   -->  Merge new modify event
-         Modify/Retract  -->  Delete modify event
-                              Queue the retract event
-         =========================================================== */
-      if (cur->ins == ins)
+      /* ===================================================
+         An action for initially asserting the newly created
+         object to all applicable patterns
+         =================================================== */
+      if (cur->type == OBJECT_ASSERT)
         {
-         /* ===================================================
-            An action for initially asserting the newly created
-            object to all applicable patterns
-            =================================================== */
-         if (cur->type == OBJECT_ASSERT)
+         if (type == OBJECT_RETRACT)
            {
-            if (type == OBJECT_RETRACT)
-              {
-               /* ===================================================
-                  If we are retracting the entire object, then we can
-                  remove the assert action (and all modifies as well)
-                  and ignore the retract action
-                  (basically the object came and went before the Rete
-                  network had a chance to see it)
-                  =================================================== */
-               if (prv == NULL)
-                 ObjectReteData(theEnv)->ObjectMatchActionQueue = cur->nxt;
-               else
-                 prv->nxt = cur->nxt;
-               cur->ins->busy--;
-               ReturnObjectMatchAction(theEnv,cur);
-              }
-
-            /* =================================================
-               If this is a modify action, then we can ignore it
-               since the assert action will encompass it
-               ================================================= */
+            /* ===================================================
+               If we are retracting the entire object, then we can
+               remove the assert action (and all modifies as well)
+               and ignore the retract action
+               (basically the object came and went before the Rete
+               network had a chance to see it)
+               =================================================== */
+            UnlinkObjectMatchAction(theEnv,cur);
+            cur->ins->matchAction = NULL;
+            cur->ins->busy--;
+            ReturnObjectMatchAction(theEnv,cur);
            }
 
-         /* ===================================================
-            If the object is being deleted after a slot modify,
-            drop the modify event and replace with the retract
-            =================================================== */
-         else if (type == OBJECT_RETRACT)
+         /* =================================================
+            If this is a modify action, then we can ignore it
+            since the assert action will encompass it
+            ================================================= */
+        }
+
+      /* ===================================================
+         If the object is being deleted after a slot modify,
+         drop the modify event and replace with the retract.
+         The event moves to the end of the retract events
+         so that all retracts are still processed first.
+         =================================================== */
+      else if (type == OBJECT_RETRACT)
+        {
+         if (cur->type != OBJECT_RETRACT)
            {
-            cur->type = OBJECT_RETRACT;
-            if (cur->slotNameIDs != NULL)
-              {
-               rm(theEnv,cur->slotNameIDs,SlotBitMapSize(cur->slotNameIDs));
-               cur->slotNameIDs = NULL;
-              }
+            UnlinkObjectMatchAction(theEnv,cur);
+            LinkObjectMatchAction(theEnv,cur,ObjectReteData(theEnv)->ObjectMatchActionLastRetract);
+            ObjectReteData(theEnv)->ObjectMatchActionLastRetract = cur;
+           }
+         cur->type = OBJECT_RETRACT;
+         if (cur->slotNameIDs != NULL)
+           {
+            rm(theEnv,cur->slotNameIDs,SlotBitMapSize(cur->slotNameIDs));
+            cur->slotNameIDs = NULL;
            }
-
-         /* ====================================================
-            If a modify event for this slot is already on the
-            queue, ignore this one. Otherwise, merge the slot id
-            ==================================================== */
-         else
-            cur->slotNameIDs = QueueModifySlotMap(theEnv,cur->slotNameIDs,slotNameID);
-
-         return;
         }
 
-      if (cur->type == OBJECT_RETRACT) /* DR0873 */
-        { prvRetract = cur; }          /* DR0873 */
-      prv = cur;
-      cur = cur->nxt;
+      /* ====================================================
+         If a modify event for this slot is already on the
+         queue, ignore this one. Otherwise, merge the slot id
+         ==================================================== */
+      else
+         cur->slotNameIDs = QueueModifySlotMap(theEnv,cur->slotNameIDs,slotNameID);
+
+      return;
      }
 
    /* ================================================
@@ -506,11 +580,11 @@ static void QueueObjectMatchAction(
       ================================================ */
    newMatch = get_struct(theEnv,objectMatchAction);
    newMatch->type = type;
-   newMatch->nxt = NULL; /* If we get here, cur should be NULL */
    newMatch->slotNameIDs = (type != OBJECT_MODIFY) ? NULL :
                        QueueModifySlotMap(theEnv,NULL,slotNameID);
    newMatch->ins = ins;
    newMatch->ins->busy++;
+   ins->matchAction = newMatch;
 
    /* DR0873 Begin */
    /* Retract operations must be processed before assert and   */
@@ -519,24 +593,80 @@ static void QueueObjectMatchAction(
 
    if (type == OBJECT_RETRACT)
      {
-      if (prvRetract == NULL)
-        {
-         newMatch->nxt = ObjectReteData(theEnv)->ObjectMatchActionQueue;
-         ObjectReteData(theEnv)->ObjectMatchActionQueue = newMatch;
-        }
-      else
-        {
-         newMatch->nxt = prvRetract->nxt;
-         prvRetract->nxt = newMatch;
-        }
+      LinkObjectMatchAction(theEnv,newMatch,ObjectReteData(theEnv)->ObjectMatchActionLastRetract);
+      ObjectReteData(theEnv)->ObjectMatchActionLastRetract = newMatch;
      }
    else
    /* DR0873 End */
 
-   if (prv == NULL)
-     ObjectReteData(theEnv)->ObjectMatchActionQueue = newMatch;
+     LinkObjectMatchAction(theEnv,newMatch,ObjectReteData(theEnv)->ObjectMatchActionQueueBottom);
+  }
+
+/***************************************************
+  NAME         : LinkObjectMatchAction
+  DESCRIPTION  : Inserts an object match action
+                 into the queue
+  INPUTS       : 1) The match action
+                 2) The queued action after which
+                    the action is inserted (NULL
+                    to insert it at the front)
+  RETURNS      : Nothing useful
+  SIDE EFFECTS : Queue updated
+  NOTES        : None
+ ***************************************************/
+static void LinkObjectMatchAction(
+  Environment *theEnv,
+  OBJECT_MATCH_ACTION *theAction,
+  OBJECT_MATCH_ACTION *prvAction)
+  {
+   theAction->prv = prvAction;
+   if (prvAction == NULL)
+     {
+      theAction->nxt = ObjectReteData(theEnv)->ObjectMatchActionQueue;
+      ObjectReteData(theEnv)->ObjectMatchActionQueue = theAction;
+     }
+   else
+     {
+      theAction->nxt = prvAction->nxt;
+      prvAction->nxt = theAction;
+     }
+
+   if (theAction->nxt == NULL)
+     ObjectReteData(theEnv)->ObjectMatchActionQueueBottom = theAction;
    else
-     prv->nxt = newMatch;
+     theAction->nxt->prv = theAction;
+  }
+
+/***************************************************
+  NAME         : UnlinkObjectMatchAction
+  DESCRIPTION  : Removes an object match action
+                 from the queue
+  INPUTS       : The queued match action
+  RETURNS      : Nothing useful
+  SIDE EFFECTS : Queue updated
+  NOTES        : The action is not deallocated
+ ***************************************************/
+static void UnlinkObjectMatchAction(
+  Environment *theEnv,
+  OBJECT_MATCH_ACTION *theAction)
+  {
+   if (theAction == ObjectReteData(theEnv)->ObjectMatchActionLastRetract)
+     ObjectReteData(theEnv)->ObjectMatchActionLastRetract =
+        (theAction->prv == NULL) ? NULL :
+        ((theAction->prv->type == OBJECT_RETRACT) ? theAction->prv : NULL);
+
+   if (theAction->prv == NULL)
+     ObjectReteData(theEnv)->ObjectMatchActionQueue = theAction->nxt;
+   else
+     theAction->prv->nxt = theAction->nxt;
+
+   if (theAction->nxt == NULL)
+     ObjectReteData(theEnv)->ObjectMatchActionQueueBottom = theAction->prv;
+   else
+     theAction->nxt->prv = theAction->prv;
+
+   theAction->prv = NULL;
+   theAction->nxt = NULL;
   }
 
 /****************************************************
@@ -616,11 +746,15 @@ static void ProcessObjectMatchQueue(
   {
    OBJECT_MATCH_ACTION *cur;
 
+   if (ObjectReteData(theEnv)->DelayObjectPatternMatching == false)
+     GroupObjectMatchActions(theEnv);
+
    while ((ObjectReteData(theEnv)->ObjectMatchActionQueue != NULL) &&
           (ObjectReteData(theEnv)->DelayObjectPatternMatching == false))
      {
       cur = ObjectReteData(theEnv)->ObjectMatchActionQueue;
-      ObjectReteData(theEnv)->ObjectMatchActionQueue = cur->nxt;
+      UnlinkObjectMatchAction(theEnv,cur);
+      cur->ins->matchAction = NULL;
 
       switch(cur->type)
         {
@@ -638,15 +772,108 @@ static void ProcessObjectMatchQueue(
      }
   }
 
+/***************************************************
+  NAME         : GroupObjectMatchActions
+  DESCRIPTION  : Reorders the queued object match
+                 actions so that the actions for
+                 instances of the same class are
+                 processed together
+  INPUTS       : None
+  RETURNS      : Nothing useful
+  SIDE EFFECTS : Queue reordered
+  NOTES        : The retract actions are grouped
+                 separately and remain ahead of
+                 the assert and modify actions.
+                 Classes are ordered by their first
+                 action on the queue and the actions
+                 for a class keep their relative
+                 order.
+ ***************************************************/
+static void GroupObjectMatchActions(
+  Environment *theEnv)
+  {
+   OBJECT_MATCH_ACTION **heads,**tails,*cur,*nxt,*last,*theAction;
+   unsigned short *classOrder;
+   unsigned classCount,i,id,maxid;
+   size_t space;
+   bool retracts;
+
+   cur = ObjectReteData(theEnv)->ObjectMatchActionQueue;
+   if ((cur == NULL) ? true : (cur->nxt == NULL))
+     return;
+
+   maxid = DefclassData(theEnv)->MaxClassID;
+   space = sizeof(OBJECT_MATCH_ACTION *) * maxid;
+   heads = (OBJECT_MATCH_ACTION **) genalloc(theEnv,space);
+   tails = (OBJECT_MATCH_ACTION **) genalloc(theEnv,space);
+   classOrder = (unsigned short *) genalloc(theEnv,sizeof(unsigned short) * maxid);
+   for (i = 0 ; i < maxid ; i++)
+     heads[i] = NULL;
+
+   ObjectReteData(theEnv)->ObjectMatchActionQueue = NULL;
+   ObjectReteData(theEnv)->ObjectMatchActionQueueBottom = NULL;
+   ObjectReteData(theEnv)->ObjectMatchActionLastRetract = NULL;
+   last = NULL;
+
+   /* ============================================
+      The retract actions are at the front of the
+      queue: distribute each run of actions (first
+      the retracts, then the asserts and modifies)
+      into per-class lists and then relink them
+      ============================================ */
+   while (cur != NULL)
+     {
+      retracts = (cur->type == OBJECT_RETRACT);
+      classCount = 0;
+      while ((cur != NULL) ? ((cur->type == OBJECT_RETRACT) == retracts) : false)
+        {
+         nxt = cur->nxt;
+         id = cur->ins->cls->id;
+         cur->nxt = NULL;
+         if (heads[id] == NULL)
+           {
+            heads[id] = cur;
+            classOrder[classCount++] = (unsigned short) id;
+           }
+         else
+           tails[id]->nxt = cur;
+         tails[id] = cur;
+         cur = nxt;
+        }
+
+      for (i = 0 ; i < classCount ; i++)
+        {
+         id = classOrder[i];
+         theAction = heads[id];
+         while (theAction != NULL)
+           {
+            nxt = theAction->nxt;
+            LinkObjectMatchAction(theEnv,theAction,last);
+            last = theAction;
+            theAction = nxt;
+           }
+         heads[id] = NULL;
+        }
+
+      if (retracts)
+        ObjectReteData(theEnv)->ObjectMatchActionLastRetract = last;
+     }
+
+   genfree(theEnv,heads,space);
+   genfree(theEnv,tails,space);
+   genfree(theEnv,classOrder,sizeof(unsigned short) * maxid);
+  }
+
 /******************************************************
   NAME         : MarkObjectPatternNetwork
-  DESCRIPTION  : Iterates through all terminal
-                 pattern nodes checking class and
-                 slot bitmaps.  If a pattern is
-                 applicable to the object/slot change,
-                 then all the nodes belonging to
-                 the pattern are marked as needing
-                 to be examined by the pattern matcher.
+  DESCRIPTION  : Iterates through the terminal
+                 pattern nodes applicable to the
+                 object's class (or, for a slot
+                 change, to the class and the slots
+                 changed).  All the nodes belonging
+                 to these patterns are marked as
+                 needing to be examined by the
+                 pattern matcher.
   INPUTS       : The bitmap of ids of the slots being
                  changed (NULL if this is an assert for the
                   for the entire object)
@@ -659,79 +886,248 @@ static void MarkObjectPatternNetwork(
   Environment *theEnv,
   SLOT_BITMAP *slotNameIDs)
   {
-   OBJECT_ALPHA_NODE *alphaPtr;
-   OBJECT_PATTERN_NODE *upper;
-   CLASS_BITMAP *clsset;
-   unsigned id;
+   CLASS_TERMINAL_LISTS *classLists;
+   OBJECT_TERMINAL_LIST *theList;
+   unsigned long i;
+   unsigned short slotID;
 
    ResetObjectMatchTimeTags(theEnv);
    ObjectReteData(theEnv)->CurrentObjectMatchTimeTag++;
-   alphaPtr = ObjectNetworkTerminalPointer(theEnv);
-   id = ObjectReteData(theEnv)->CurrentPatternObject->cls->id;
-   while (alphaPtr != NULL)
+   classLists = GetClassTerminalLists(theEnv,ObjectReteData(theEnv)->CurrentPatternObject->cls->id);
+
+   /* ===================================================
+      If we are doing an assert, then we need to
+      check all patterns which satsify the class bitmap
+      (The retraction has already been done in this case)
+      =================================================== */
+   if (slotNameIDs == NULL)
      {
-      /* =============================================================
-         If an incremental reset is in progress, make sure that the
-         pattern has been marked for initialization before proceeding.
-         ============================================================= */
-#if (! RUN_TIME) && (! BLOAD_ONLY)
-      if (EngineData(theEnv)->IncrementalResetInProgress &&
-          (alphaPtr->header.initialize == false))
+      for (i = 0 ; i < classLists->allSlots.count ; i++)
+        { MarkObjectTerminal(theEnv,classLists->allSlots.terminals[i]); }
+      return;
+     }
+
+   /* ===================================================
+      If we are doing a slot modify, then we need to
+      check only the subset of patterns which satisfy the
+      class bitmap AND actually match on the slots in
+      question. A pattern matching on several of the
+      modified slots appears in more than one slot list,
+      but is marked only once.
+      =================================================== */
+   for (slotID = 0 ;
+        (slotID <= slotNameIDs->maxid) && (slotID < classLists->slotListCount) ;
+        slotID++)
+     {
+      if (! TestBitMap(slotNameIDs->map,slotID))
+        { continue; }
+
+      theList = &classLists->slotLists[slotID];
+      for (i = 0 ; i < theList->count ; i++)
         {
-         alphaPtr = alphaPtr->nxtTerminal;
-         continue;
+         if (theList->terminals[i]->matchTimeTag != ObjectReteData(theEnv)->CurrentObjectMatchTimeTag)
+           { MarkObjectTerminal(theEnv,theList->terminals[i]); }
         }
+     }
+  }
+
+/***************************************************
+  NAME         : MarkObjectTerminal
+  DESCRIPTION  : Marks a terminal pattern node and
+                 the pattern nodes above it as
+                 applicable to the current object
+  INPUTS       : The terminal pattern node
+  RETURNS      : Nothing useful
+  SIDE EFFECTS : Match time tags set
+  NOTES        : Patterns not yet initialized by
+                 an incremental reset are skipped
+ ***************************************************/
+static void MarkObjectTerminal(
+  Environment *theEnv,
+  OBJECT_ALPHA_NODE *alphaPtr)
+  {
+   OBJECT_PATTERN_NODE *upper;
+
+   /* =============================================================
+      If an incremental reset is in progress, make sure that the
+      pattern has been marked for initialization before proceeding.
+      ============================================================= */
+#if (! RUN_TIME) && (! BLOAD_ONLY)
+   if (EngineData(theEnv)->IncrementalResetInProgress &&
+       (alphaPtr->header.initialize == false))
+     return;
 #endif
 
-      /* ============================================
-         Check the class bitmap to see if the pattern
-         pattern is applicable to the object at all
-         ============================================ */
+   alphaPtr->matchTimeTag = ObjectReteData(theEnv)->CurrentObjectMatchTimeTag;
+   for (upper = alphaPtr->patternNode ; upper != NULL ; upper = upper->lastLevel)
+     {
+      if (upper->matchTimeTag == ObjectReteData(theEnv)->CurrentObjectMatchTimeTag)
+        break;
+      else
+        upper->matchTimeTag = ObjectReteData(theEnv)->CurrentObjectMatchTimeTag;
+     }
+  }
+
+/*****************************************************
+  NAME         : GetClassTerminalLists
+  DESCRIPTION  : Returns the terminal pattern nodes
+                 applicable to a class, building
+                 them from the terminal list of the
+                 object pattern network if necessary
+  INPUTS       : The class id
+  RETURNS      : The terminal lists for the class
+  SIDE EFFECTS : Lists allocated and cached
+  NOTES        : The cached lists are released by
+                 ReleaseClassTerminalLists whenever
+                 terminal nodes are added or removed
+ *****************************************************/
+static CLASS_TERMINAL_LISTS *GetClassTerminalLists(
+  Environment *theEnv,
+  unsigned id)
+  {
+   CLASS_TERMINAL_LISTS **newArray;
+   unsigned newSize, i;
+
+   if (id >= ObjectReteData(theEnv)->ClassTerminalListsSize)
+     {
+      newSize = id + 1;
+      newArray = (CLASS_TERMINAL_LISTS **) genalloc(theEnv,sizeof(CLASS_TERMINAL_LISTS *) * newSize);
+      for (i = 0 ; i < ObjectReteData(theEnv)->ClassTerminalListsSize ; i++)
+        { newArray[i] = ObjectReteData(theEnv)->ClassTerminalLists[i]; }
+      for ( ; i < newSize ; i++)
+        { newArray[i] = NULL; }
+
+      if (ObjectReteData(theEnv)->ClassTerminalLists != NULL)
+        {
+         genfree(theEnv,ObjectReteData(theEnv)->ClassTerminalLists,
+                 sizeof(CLASS_TERMINAL_LISTS *) * ObjectReteData(theEnv)->ClassTerminalListsSize);
+        }
+
+      ObjectReteData(theEnv)->ClassTerminalLists = newArray;
+      ObjectReteData(theEnv)->ClassTerminalListsSize = newSize;
+     }
+
+   if (ObjectReteData(theEnv)->ClassTerminalLists[id] == NULL)
+     { ObjectReteData(theEnv)->ClassTerminalLists[id] = BuildClassTerminalLists(theEnv,id); }
+
+   return ObjectReteData(theEnv)->ClassTerminalLists[id];
+  }
+
+/*****************************************************
+  NAME         : BuildClassTerminalLists
+  DESCRIPTION  : Collects the terminal pattern nodes
+                 whose class bitmaps include a class,
+                 both as a whole and grouped by the
+                 slots on which they match
+  INPUTS       : The class id
+  RETURNS      : The terminal lists for the class
+  SIDE EFFECTS : Lists allocated
+  NOTES        : None
+ *****************************************************/
+static CLASS_TERMINAL_LISTS *BuildClassTerminalLists(
+  Environment *theEnv,
+  unsigned id)
+  {
+   CLASS_TERMINAL_LISTS *theLists;
+   OBJECT_ALPHA_NODE *alphaPtr;
+   CLASS_BITMAP *clsset;
+   SLOT_BITMAP *slotset;
+   unsigned long count = 0, i;
+   unsigned short slotListCount = 0, slotID;
+
+   /* ================================================
+      Count the applicable terminals and determine the
+      largest slot id on which any of them match
+      ================================================ */
+   for (alphaPtr = ObjectNetworkTerminalPointer(theEnv) ;
+        alphaPtr != NULL ;
+        alphaPtr = alphaPtr->nxtTerminal)
+     {
       clsset = (CLASS_BITMAP *) alphaPtr->classbmp->contents;
+      if ((id > (unsigned) clsset->maxid) ? true : (! TestBitMap(clsset->map,id)))
+        { continue; }
+
+      count++;
+      if (alphaPtr->slotbmp != NULL)
+        {
+         slotset = (SLOT_BITMAP *) alphaPtr->slotbmp->contents;
+         if (slotset->maxid >= slotListCount)
+           { slotListCount = (unsigned short) (slotset->maxid + 1); }
+        }
+     }
+
+   theLists = get_struct(theEnv,classTerminalLists);
+   theLists->allSlots.count = 0;
+   theLists->allSlots.terminals = NULL;
+   theLists->slotListCount = slotListCount;
+   theLists->slotLists = NULL;
+
+   if (count == 0)
+     { return theLists; }
 
+   theLists->allSlots.terminals = (OBJECT_ALPHA_NODE **) genalloc(theEnv,sizeof(OBJECT_ALPHA_NODE *) * count);
+   for (alphaPtr = ObjectNetworkTerminalPointer(theEnv) ;
+        alphaPtr != NULL ;
+        alphaPtr = alphaPtr->nxtTerminal)
+     {
+      clsset = (CLASS_BITMAP *) alphaPtr->classbmp->contents;
       if ((id > (unsigned) clsset->maxid) ? false : TestBitMap(clsset->map,id))
+        { theLists->allSlots.terminals[theLists->allSlots.count++] = alphaPtr; }
+     }
+
+   if (slotListCount == 0)
+     { return theLists; }
+
+   /* ==============================================
+      Group the terminals by the slots on which they
+      match: count the members of each slot list,
+      allocate the lists and then fill them in
+      ============================================== */
+   theLists->slotLists = (OBJECT_TERMINAL_LIST *) genalloc(theEnv,sizeof(OBJECT_TERMINAL_LIST) * slotListCount);
+   for (slotID = 0 ; slotID < slotListCount ; slotID++)
+     {
+      theLists->slotLists[slotID].count = 0;
+      theLists->slotLists[slotID].terminals = NULL;
+     }
+
+   for (i = 0 ; i < count ; i++)
+     {
+      if (theLists->allSlots.terminals[i]->slotbmp == NULL)
+        { continue; }
+
+      slotset = (SLOT_BITMAP *) theLists->allSlots.terminals[i]->slotbmp->contents;
+      for (slotID = 0 ; slotID <= slotset->maxid ; slotID++)
         {
-         /* ===================================================
-            If we are doing an assert, then we need to
-            check all patterns which satsify the class bitmap
-            (The retraction has already been done in this case)
-            =================================================== */
-         if (slotNameIDs == NULL)
-           {
-            alphaPtr->matchTimeTag = ObjectReteData(theEnv)->CurrentObjectMatchTimeTag;
-            for (upper = alphaPtr->patternNode ; upper != NULL ; upper = upper->lastLevel)
-              {
-               if (upper->matchTimeTag == ObjectReteData(theEnv)->CurrentObjectMatchTimeTag)
-                 break;
-               else
-                 upper->matchTimeTag = ObjectReteData(theEnv)->CurrentObjectMatchTimeTag;
-              }
-           }
+         if (TestBitMap(slotset->map,slotID))
+           { theLists->slotLists[slotID].count++; }
+        }
+     }
 
-         /* ===================================================
-            If we are doing a slot modify, then we need to
-            check only the subset of patterns which satisfy the
-            class bitmap AND actually match on the slot in
-            question.
-            =================================================== */
-         else if (alphaPtr->slotbmp != NULL)
-           {
-           if (CompareSlotBitMaps(slotNameIDs,
-                  (SLOT_BITMAP *) alphaPtr->slotbmp->contents))
-              {
-               alphaPtr->matchTimeTag = ObjectReteData(theEnv)->CurrentObjectMatchTimeTag;
-               for (upper = alphaPtr->patternNode ; upper != NULL ; upper = upper->lastLevel)
-                 {
-                  if (upper->matchTimeTag == ObjectReteData(theEnv)->CurrentObjectMatchTimeTag)
-                    break;
-                  else
-                    upper->matchTimeTag = ObjectReteData(theEnv)->CurrentObjectMatchTimeTag;
-                 }
-              }
-           }
+   for (slotID = 0 ; slotID < slotListCount ; slotID++)
+     {
+      if (theLists->slotLists[slotID].count != 0)
+        {
+         theLists->slotLists[slotID].terminals = (OBJECT_ALPHA_NODE **)
+            genalloc(theEnv,sizeof(OBJECT_ALPHA_NODE *) * theLists->slotLists[slotID].count);
+         theLists->slotLists[slotID].count = 0;
         }
-      alphaPtr = alphaPtr->nxtTerminal;
      }
+
+   for (i = 0 ; i < count ; i++)
+     {
+      alphaPtr = theLists->allSlots.terminals[i];
+      if (alphaPtr->slotbmp == NULL)
+        { continue; }
+
+      slotset = (SLOT_BITMAP *) alphaPtr->slotbmp->contents;
+      for (slotID = 0 ; slotID <= slotset->maxid ; slotID++)
+        {
+         if (TestBitMap(slotset->map,slotID))
+           { theLists->slotLists[slotID].terminals[theLists->slotLists[slotID].count++] = alphaPtr; }
+        }
+     }
+
+   return theLists;
   }
 
 /***************************************************
@@ -1352,7 +1748,6 @@ static void ObjectRetractAction(
    struct patternMatch *prvMatch,*tmpMatch,
                        *deleteMatch,*lastDeleteMatch;
    OBJECT_ALPHA_NODE *alphaPtr;
-   void *saveDependents;
 
    if (slotNameIDs == NULL)
      {
@@ -1409,20 +1804,14 @@ static void ObjectRetractAction(
         }
 
       /* =============================================
-         We need to preserve any logical dependencies
-         of this object and reattach them after doing
-         the retract.  Otherwise, the Rete network
-         will believe the object is gone and remove
-         the links from the partial matches upon which
-         this object is logically dependent.
+         The logical dependencies of this object are
+         left in place. A dependency is shared by the
+         object and the partial match supporting it,
+         so it is only removed if that partial match
+         is removed by the retract.
          ============================================= */
       if (deleteMatch != NULL)
-        {
-         saveDependents = ins->patternHeader.dependents;
-         ins->patternHeader.dependents = NULL;
-         NetworkRetract(theEnv,deleteMatch);
-         ins->patternHeader.dependents = saveDependents;
-        }
+        { NetworkRetract(theEnv,deleteMatch); }
      }
    ins->reteSynchronized = true;
   }
@@ -52,6 +52,10 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added per-class terminal pattern node lists.   */
+/*                                                           */
+/*            Object match actions are doubly linked.        */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_objrtmch
@@ -123,12 +127,26 @@ struct objectAlphaNode
    long bsaveID;
   };
 
+typedef struct objectTerminalList
+  {
+   unsigned long count;
+   OBJECT_ALPHA_NODE **terminals;
+  } OBJECT_TERMINAL_LIST;
+
+typedef struct classTerminalLists
+  {
+   OBJECT_TERMINAL_LIST allSlots;
+   unsigned short slotListCount;
+   OBJECT_TERMINAL_LIST *slotLists;
+  } CLASS_TERMINAL_LISTS;
+
 typedef struct objectMatchAction
   {
    int type;
    Instance *ins;
    SLOT_BITMAP *slotNameIDs;
    struct objectMatchAction *nxt;
+   struct objectMatchAction *prv;
   } OBJECT_MATCH_ACTION;
 
    void                  ObjectMatchDelay(Environment *,UDFContext *,UDFValue *);
@@ -138,6 +156,7 @@ typedef struct objectMatchAction
    OBJECT_ALPHA_NODE    *ObjectNetworkTerminalPointer(Environment *);
    void                  SetObjectNetworkPointer(Environment *,OBJECT_PATTERN_NODE *);
    void                  SetObjectNetworkTerminalPointer(Environment *,OBJECT_ALPHA_NODE *);
+   void                  ReleaseClassTerminalLists(Environment *);
    void                  ObjectNetworkAction(Environment *,int,Instance *,int);
    void                  ResetObjectMatchTimeTags(Environment *);
 
@@ -41,6 +41,9 @@
 /*            Removed initial-fact and initial-object        */
 /*            support.                                       */
 /*                                                           */
+/*      6.50: Added estimateMatchesFunction to the pattern   */
+/*            parser for cost-based join ordering.           */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_pattern
@@ -96,6 +99,7 @@ struct patternParser
    struct expr *(*genComparePNValuesFunction)(Environment *,struct lhsParseNode *,struct lhsParseNode *);
    void (*returnUserDataFunction)(Environment *,void *);
    void *(*copyUserDataFunction)(Environment *,void *);
+   unsigned long (*estimateMatchesFunction)(Environment *,struct lhsParseNode *);
    void (*markIRPatternFunction)(Environment *,struct patternNodeHeader *,int);
    void (*incrementalResetFunction)(Environment *);
    void (*codeReferenceFunction)(Environment *,void *,FILE *,int,int);
@@ -38,6 +38,11 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: SavePPBuffer determines the length of the      */
+/*            string once.                                   */
+/*                                                           */
+/*            Pretty print forms can be stored compressed.   */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -59,6 +64,33 @@
 /***************************************/
 
    static void                    DeallocatePrettyPrintData(Environment *);
+   static char                   *CompressPPForm(Environment *,const char *,size_t);
+   static void                    AddToPPDictionary(Environment *,const char *,size_t);
+   static unsigned int            PPFormHash(const char *);
+   static size_t                  PPMatchLength(const char *,const char *,size_t);
+
+/*******************************************************/
+/* The compression dictionary is seeded with text that */
+/* commonly appears in pretty print forms. The first   */
+/* pretty print forms compressed are then appended to  */
+/* the dictionary until it is full. Text is never      */
+/* removed from the dictionary, so a compressed form   */
+/* remains valid for the life of the environment.      */
+/*******************************************************/
+
+   static const char *PPDictionarySeed =
+      "(defmodule (deftemplate (deffacts (defglobal ?* (deffunction "
+      "(defgeneric (defmethod (defclass (definstances "
+      "(defmessage-handler (is-a USER)\n   (role concrete)\n"
+      "   (pattern-match reactive)\n   (slot (multislot (default "
+      "(type SYMBOL (type STRING (type INTEGER (type FLOAT (allowed-values "
+      "(send ?self get-(send ?self put-(object (is-a (exists (forall "
+      "(not (test (or (and (eq (neq (= (<> (> (< (+ (- (* (/ "
+      "(str-cat (sym-cat (nth$ (length$ (create$ (member$ "
+      "(if (then\n      (else\n      (while (do\n      (loop-for-count "
+      "(progn$ (return (bind ?\n   (assert (\n   (retract ?"
+      "\n   (modify ?\n   (printout t \" crlf)\n   =>\n"
+      "(defrule \n   (declare (salience ";
 
 /****************************************************/
 /* InitializePrettyPrintData: Allocates environment */
@@ -81,6 +113,16 @@ static void DeallocatePrettyPrintData(
   {
    if (PrettyPrintData(theEnv)->PrettyPrintBuffer != NULL)
      { rm(theEnv,PrettyPrintData(theEnv)->PrettyPrintBuffer,PrettyPrintData(theEnv)->PPBufferMax); }
+
+   if (PrettyPrintData(theEnv)->PPDictionary != NULL)
+     {
+      rm(theEnv,PrettyPrintData(theEnv)->PPDictionary,PP_DICTIONARY_SIZE);
+      rm(theEnv,PrettyPrintData(theEnv)->PPDictionaryHead,sizeof(int) * PP_HASH_SIZE);
+      rm(theEnv,PrettyPrintData(theEnv)->PPDictionaryChain,sizeof(int) * PP_DICTIONARY_SIZE);
+     }
+
+   if (PrettyPrintData(theEnv)->ExpandedPPForm != NULL)
+     { rm(theEnv,PrettyPrintData(theEnv)->ExpandedPPForm,PrettyPrintData(theEnv)->ExpandedPPFormMax); }
   }
 
 /*******************************************************/
@@ -119,7 +161,7 @@ void SavePPBuffer(
   Environment *theEnv,
   const char *str)
   {
-   size_t increment;
+   size_t increment, length;
 
    /*==========================================*/
    /* If the pretty print buffer isn't needed, */
@@ -142,8 +184,12 @@ void SavePPBuffer(
    /* contain the string, then increase its size.    */
    /*================================================*/
 
-   if (strlen(str) + PrettyPrintData(theEnv)->PPBufferPos + 1 >= PrettyPrintData(theEnv)->PPBufferMax)
+   length = strlen(str);
+   if (length + PrettyPrintData(theEnv)->PPBufferPos + 1 >= PrettyPrintData(theEnv)->PPBufferMax)
      {
+      if (increment < (length + 1))
+        { increment = length + 1; }
+
       PrettyPrintData(theEnv)->PrettyPrintBuffer =
          (char *) genrealloc(theEnv,PrettyPrintData(theEnv)->PrettyPrintBuffer,
                                     PrettyPrintData(theEnv)->PPBufferMax,
@@ -163,7 +209,8 @@ void SavePPBuffer(
    /* Save the string to the pretty print buffer. */
    /*=============================================*/
 
-   PrettyPrintData(theEnv)->PrettyPrintBuffer = AppendToString(theEnv,str,PrettyPrintData(theEnv)->PrettyPrintBuffer,&PrettyPrintData(theEnv)->PPBufferPos,&PrettyPrintData(theEnv)->PPBufferMax);
+   memcpy(&PrettyPrintData(theEnv)->PrettyPrintBuffer[PrettyPrintData(theEnv)->PPBufferPos],str,length + 1);
+   PrettyPrintData(theEnv)->PPBufferPos += length;
   }
 
 /***************************************************/
@@ -197,6 +244,9 @@ char *CopyPPBuffer(
 
    if (theBuffer == NULL) return NULL;
 
+   if (PrettyPrintData(theEnv)->CompressPPForms)
+     { return CompressPPForm(theEnv,theBuffer,strlen(theBuffer)); }
+
    length = (1 + strlen(theBuffer)) * (int) sizeof (char);
    newString = (char *) gm2(theEnv,length);
 
@@ -313,3 +363,360 @@ bool GetPPBufferEnabled(
    return PrettyPrintData(theEnv)->PPBufferEnabled;
   }
 
+
+/*****************************************************/
+/* SetCompressPPForms: Sets the flag indicating      */
+/*   whether the pretty print forms of constructs    */
+/*   are stored compressed. Returns the old value.   */
+/*****************************************************/
+bool SetCompressPPForms(
+  Environment *theEnv,
+  bool value)
+  {
+   bool oldValue;
+
+   oldValue = PrettyPrintData(theEnv)->CompressPPForms;
+   PrettyPrintData(theEnv)->CompressPPForms = value;
+   return oldValue;
+  }
+
+/*******************************************************/
+/* GetCompressPPForms: Returns the flag indicating     */
+/*   whether the pretty print forms of constructs are  */
+/*   stored compressed.                                */
+/*******************************************************/
+bool GetCompressPPForms(
+  Environment *theEnv)
+  {
+   return PrettyPrintData(theEnv)->CompressPPForms;
+  }
+
+/************************************************************/
+/* ExpandPPForm: Returns the text of a pretty print form.   */
+/*   An uncompressed form is returned unchanged. A          */
+/*   compressed form is expanded into a buffer which is     */
+/*   reused by the next call, so the text returned must be  */
+/*   used (or copied) before another form is expanded.      */
+/************************************************************/
+const char *ExpandPPForm(
+  Environment *theEnv,
+  const char *ppForm)
+  {
+   const unsigned char *code;
+   const char *theDictionary;
+   char *theText;
+   size_t length = 0, pos, source, i;
+   unsigned int value;
+
+   if ((ppForm == NULL) || (ppForm[0] != PP_FORM_COMPRESSED))
+     { return ppForm; }
+
+   /*===========================================*/
+   /* Determine the length of the expanded text */
+   /* so that the buffer can be sized for it.   */
+   /*===========================================*/
+
+   for (code = (const unsigned char *) &ppForm[1]; *code != EOS; )
+     {
+      if (*code != PP_FORM_COMPRESSED)
+        {
+         length++;
+         code++;
+        }
+      else if (code[1] == PP_FORM_COMPRESSED)
+        {
+         length++;
+         code += 2;
+        }
+      else
+        {
+         length += (code[1] < 128) ? (code[1] + 2U) : (code[1] - 124U);
+         code += 4;
+        }
+     }
+
+   if (PrettyPrintData(theEnv)->ExpandedPPFormMax < (length + 1))
+     {
+      if (PrettyPrintData(theEnv)->ExpandedPPForm != NULL)
+        { rm(theEnv,PrettyPrintData(theEnv)->ExpandedPPForm,PrettyPrintData(theEnv)->ExpandedPPFormMax); }
+      PrettyPrintData(theEnv)->ExpandedPPFormMax = length + 1;
+      PrettyPrintData(theEnv)->ExpandedPPForm = (char *) gm2(theEnv,length + 1);
+     }
+
+   /*=====================================*/
+   /* Copy the literal characters and the */
+   /* text referenced by the copy codes.  */
+   /*=====================================*/
+
+   theText = PrettyPrintData(theEnv)->ExpandedPPForm;
+   theDictionary = PrettyPrintData(theEnv)->PPDictionary;
+
+   for (code = (const unsigned char *) &ppForm[1], pos = 0; *code != EOS; )
+     {
+      if (*code != PP_FORM_COMPRESSED)
+        {
+         theText[pos++] = (char) *code;
+         code++;
+         continue;
+        }
+
+      if (code[1] == PP_FORM_COMPRESSED)
+        {
+         theText[pos++] = PP_FORM_COMPRESSED;
+         code += 2;
+         continue;
+        }
+
+      value = ((code[2] - 1U) * 255U) + (code[3] - 1U);
+
+      if (code[1] < 128)
+        {
+         source = pos - value;
+         for (i = 0; i < (code[1] + 2U); i++)
+           { theText[pos++] = theText[source++]; }
+        }
+      else
+        {
+         memcpy(&theText[pos],&theDictionary[value],code[1] - 124U);
+         pos += code[1] - 124U;
+        }
+
+      code += 4;
+     }
+
+   theText[pos] = EOS;
+
+   return theText;
+  }
+
+/************************************************************/
+/* CompressPPForm: Creates a compressed copy of a pretty    */
+/*   print form. Repeated text is replaced with a copy code */
+/*   referring to the longest match found either earlier in */
+/*   the form or in the environment's dictionary.           */
+/************************************************************/
+static char *CompressPPForm(
+  Environment *theEnv,
+  const char *theText,
+  size_t length)
+  {
+   int *head, *chain;
+   int candidate, depth;
+   const char *theDictionary;
+   size_t dictionaryLength, pos = 0, out = 1, bestLength, matchLength, limit, bufferSize, i;
+   size_t bestPosition = 0;
+   bool bestInDictionary = false;
+   unsigned int hashValue;
+   char *buffer, *newString;
+
+   if (PrettyPrintData(theEnv)->PPDictionary == NULL)
+     { AddToPPDictionary(theEnv,PPDictionarySeed,strlen(PPDictionarySeed)); }
+
+   theDictionary = PrettyPrintData(theEnv)->PPDictionary;
+   dictionaryLength = PrettyPrintData(theEnv)->PPDictionaryLength;
+
+   /*=============================================*/
+   /* The worst case is that every character of   */
+   /* the form is an escaped PP_FORM_COMPRESSED.  */
+   /*=============================================*/
+
+   bufferSize = (length * 2) + 2;
+   buffer = (char *) genalloc(theEnv,bufferSize);
+   head = (int *) genalloc(theEnv,sizeof(int) * PP_HASH_SIZE);
+   chain = (int *) genalloc(theEnv,sizeof(int) * (length + 1));
+
+   for (i = 0; i < PP_HASH_SIZE; i++)
+     { head[i] = -1; }
+
+   buffer[0] = PP_FORM_COMPRESSED;
+
+   while (pos < length)
+     {
+      bestLength = 0;
+
+      if ((length - pos) >= PP_MINIMUM_MATCH)
+        {
+         limit = length - pos;
+         if (limit > PP_MAXIMUM_MATCH)
+           { limit = PP_MAXIMUM_MATCH; }
+
+         hashValue = PPFormHash(&theText[pos]);
+
+         /*====================================*/
+         /* Look for a match in the earlier    */
+         /* text of the form being compressed. */
+         /*====================================*/
+
+         for (candidate = head[hashValue], depth = 0;
+              (candidate >= 0) && (depth < PP_CHAIN_DEPTH) &&
+              ((pos - (size_t) candidate) <= PP_MAXIMUM_DISTANCE);
+              candidate = chain[candidate], depth++)
+           {
+            matchLength = PPMatchLength(&theText[candidate],&theText[pos],limit);
+            if (matchLength > bestLength)
+              {
+               bestLength = matchLength;
+               bestPosition = pos - (size_t) candidate;
+               bestInDictionary = false;
+              }
+           }
+
+         /*======================================*/
+         /* Look for a longer match in the text  */
+         /* of the dictionary.                   */
+         /*======================================*/
+
+         for (candidate = PrettyPrintData(theEnv)->PPDictionaryHead[hashValue], depth = 0;
+              (candidate >= 0) && (depth < PP_CHAIN_DEPTH);
+              candidate = PrettyPrintData(theEnv)->PPDictionaryChain[candidate], depth++)
+           {
+            matchLength = dictionaryLength - (size_t) candidate;
+            if (matchLength > limit)
+              { matchLength = limit; }
+            matchLength = PPMatchLength(&theDictionary[candidate],&theText[pos],matchLength);
+            if (matchLength > bestLength)
+              {
+               bestLength = matchLength;
+               bestPosition = (size_t) candidate;
+               bestInDictionary = true;
+              }
+           }
+        }
+
+      /*==========================================*/
+      /* Write a copy code for a match, otherwise */
+      /* write the next character as a literal.   */
+      /*==========================================*/
+
+      if (bestLength >= PP_MINIMUM_MATCH)
+        {
+         buffer[out++] = PP_FORM_COMPRESSED;
+         if (bestInDictionary)
+           { buffer[out++] = (char) (bestLength + 124); }
+         else
+           { buffer[out++] = (char) (bestLength - 2); }
+         buffer[out++] = (char) ((bestPosition / 255) + 1);
+         buffer[out++] = (char) ((bestPosition % 255) + 1);
+        }
+      else
+        {
+         bestLength = 1;
+         if (theText[pos] == PP_FORM_COMPRESSED)
+           { buffer[out++] = PP_FORM_COMPRESSED; }
+         buffer[out++] = theText[pos];
+        }
+
+      /*====================================*/
+      /* Add the positions of the text just */
+      /* encoded to the hash chains.        */
+      /*====================================*/
+
+      for (i = pos; i < (pos + bestLength); i++)
+        {
+         if ((length - i) < PP_MINIMUM_MATCH)
+           { break; }
+         hashValue = PPFormHash(&theText[i]);
+         chain[i] = head[hashValue];
+         head[hashValue] = (int) i;
+        }
+
+      pos += bestLength;
+     }
+
+   buffer[out++] = EOS;
+
+   newString = (char *) gm2(theEnv,out);
+   memcpy(newString,buffer,out);
+
+   genfree(theEnv,buffer,bufferSize);
+   genfree(theEnv,head,sizeof(int) * PP_HASH_SIZE);
+   genfree(theEnv,chain,sizeof(int) * (length + 1));
+
+   AddToPPDictionary(theEnv,theText,length);
+
+   return newString;
+  }
+
+/*********************************************************/
+/* AddToPPDictionary: Appends text to the compression    */
+/*   dictionary (allocating it if necessary) until it is */
+/*   full and adds the new positions to its hash chains. */
+/*********************************************************/
+static void AddToPPDictionary(
+  Environment *theEnv,
+  const char *theText,
+  size_t length)
+  {
+   size_t oldLength, newLength, i;
+   unsigned int hashValue;
+   struct prettyPrintData *thePPData = PrettyPrintData(theEnv);
+
+   if (thePPData->PPDictionary == NULL)
+     {
+      thePPData->PPDictionary = (char *) gm2(theEnv,PP_DICTIONARY_SIZE);
+      thePPData->PPDictionaryHead = (int *) gm2(theEnv,sizeof(int) * PP_HASH_SIZE);
+      thePPData->PPDictionaryChain = (int *) gm2(theEnv,sizeof(int) * PP_DICTIONARY_SIZE);
+      thePPData->PPDictionaryLength = 0;
+      for (i = 0; i < PP_HASH_SIZE; i++)
+        { thePPData->PPDictionaryHead[i] = -1; }
+     }
+
+   oldLength = thePPData->PPDictionaryLength;
+   if (oldLength >= PP_DICTIONARY_SIZE)
+     { return; }
+
+   if (length > (PP_DICTIONARY_SIZE - oldLength))
+     { length = PP_DICTIONARY_SIZE - oldLength; }
+
+   memcpy(&thePPData->PPDictionary[oldLength],theText,length);
+   newLength = oldLength + length;
+   thePPData->PPDictionaryLength = newLength;
+
+   /*==================================================*/
+   /* Positions near the old end of the dictionary     */
+   /* couldn't be hashed until more text was appended. */
+   /*==================================================*/
+
+   i = (oldLength < PP_MINIMUM_MATCH) ? 0 : (oldLength - (PP_MINIMUM_MATCH - 1));
+
+   for ( ; (i + PP_MINIMUM_MATCH) <= newLength; i++)
+     {
+      hashValue = PPFormHash(&thePPData->PPDictionary[i]);
+      thePPData->PPDictionaryChain[i] = thePPData->PPDictionaryHead[hashValue];
+      thePPData->PPDictionaryHead[hashValue] = (int) i;
+     }
+  }
+
+/**************************************************/
+/* PPFormHash: Computes the hash value of the     */
+/*   PP_MINIMUM_MATCH characters beginning at the */
+/*   specified location.                          */
+/**************************************************/
+static unsigned int PPFormHash(
+  const char *theText)
+  {
+   const unsigned char *s = (const unsigned char *) theText;
+   unsigned int value;
+
+   value = ((unsigned int) s[0] << 24) | ((unsigned int) s[1] << 16) |
+           ((unsigned int) s[2] << 8) | (unsigned int) s[3];
+
+   return ((value * 2654435761U) >> 20) & (PP_HASH_SIZE - 1);
+  }
+
+/*************************************************/
+/* PPMatchLength: Returns the number of matching */
+/*   characters (up to limit) at two locations.  */
+/*************************************************/
+static size_t PPMatchLength(
+  const char *source,
+  const char *theText,
+  size_t limit)
+  {
+   size_t i;
+
+   for (i = 0; (i < limit) && (source[i] == theText[i]); i++)
+     { /* Do Nothing */ }
+
+   return i;
+  }
@@ -33,6 +33,8 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Pretty print forms can be stored compressed.   */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_pprint
@@ -41,6 +43,25 @@
 
 #define _H_pprint
 
+/***********************************************************/
+/* A compressed pretty print form begins with the          */
+/* PP_FORM_COMPRESSED character. It is followed by literal */
+/* characters and by four character copy codes (beginning  */
+/* with PP_FORM_COMPRESSED) referring either to earlier    */
+/* text in the same form or to text in the environment's   */
+/* compression dictionary. None of the characters in a     */
+/* compressed form are EOS, so compressed forms can be     */
+/* freed in the same manner as uncompressed forms.         */
+/***********************************************************/
+
+#define PP_FORM_COMPRESSED       '\001'
+#define PP_DICTIONARY_SIZE        32768
+#define PP_HASH_SIZE               4096
+#define PP_MINIMUM_MATCH              4
+#define PP_MAXIMUM_MATCH            129
+#define PP_MAXIMUM_DISTANCE       65024
+#define PP_CHAIN_DEPTH                8
+
 #define PRETTY_PRINT_DATA 52
 
 struct prettyPrintData
@@ -53,6 +74,13 @@ struct prettyPrintData
    size_t PPBackupOnce;
    size_t PPBackupTwice;
    char *PrettyPrintBuffer;
+   bool CompressPPForms;
+   char *PPDictionary;
+   size_t PPDictionaryLength;
+   int *PPDictionaryHead;
+   int *PPDictionaryChain;
+   char *ExpandedPPForm;
+   size_t ExpandedPPFormMax;
   };
 
 #define PrettyPrintData(theEnv) ((struct prettyPrintData *) GetEnvironmentData(theEnv,PRETTY_PRINT_DATA))
@@ -72,6 +100,9 @@ struct prettyPrintData
    bool                           GetPPBufferStatus(Environment *);
    bool                           SetPPBufferEnabled(Environment *,bool);
    bool                           GetPPBufferEnabled(Environment *);
+   bool                           SetCompressPPForms(Environment *,bool);
+   bool                           GetCompressPPForms(Environment *);
+   const char                    *ExpandPPForm(Environment *,const char *);
 
 #endif
 
@@ -58,6 +58,10 @@
 /*            an alternate variable handling function         */
 /*            generates an error.                             */
 /*                                                            */
+/*      6.50: Local variable frames for procedural code are   */
+/*            taken from a reusable per-environment stack     */
+/*            rather than allocated on every call.            */
+/*                                                            */
 /**************************************************************/
 
 /* =========================================
@@ -104,6 +108,8 @@ typedef struct
    unsigned second     : 15;
   } PACKED_PROC_VAR;
 
+#define LOCAL_VAR_STACK_SIZE 256
+
 /***************************************/
 /* LOCAL INTERNAL FUNCTION DEFINITIONS */
 /***************************************/
@@ -115,6 +121,7 @@ typedef struct
    static bool                    RtnProcWild(Environment *,void *,UDFValue *);
    static void                    DeallocateProceduralPrimitiveData(Environment *);
    static void                    ReleaseProcParameters(Environment *);
+   static void                    GrowLocalVarStack(Environment *,size_t);
 
 #if (! BLOAD_ONLY) && (! RUN_TIME)
    static int                     FindProcParameter(CLIPSLexeme *,Expression *,CLIPSLexeme *);
@@ -226,6 +233,12 @@ static void DeallocateProceduralPrimitiveData(
   {
    ReturnMultifield(theEnv,ProceduralPrimitiveData(theEnv)->NoParamValue);
    ReleaseProcParameters(theEnv);
+
+   if (ProceduralPrimitiveData(theEnv)->LocalVarStack != NULL)
+     {
+      genfree(theEnv,ProceduralPrimitiveData(theEnv)->LocalVarStack,
+              sizeof(UDFValue) * ProceduralPrimitiveData(theEnv)->LocalVarStackSize);
+     }
   }
 
 #if (! BLOAD_ONLY) && (! RUN_TIME)
@@ -825,6 +838,38 @@ static void ReleaseProcParameters(
      }
   }
 
+/******************************************************************
+  NAME         : GrowLocalVarStack
+  DESCRIPTION  : Enlarges the stack from which local variable
+                 frames for procedural code are taken
+  INPUTS       : The number of local variables needed by the
+                 frame which did not fit
+  RETURNS      : Nothing useful
+  SIDE EFFECTS : Old stack deallocated and new one allocated
+  NOTES        : Assumes no frames are in use
+ ******************************************************************/
+static void GrowLocalVarStack(
+  Environment *theEnv,
+  size_t lvarcnt)
+  {
+   size_t newSize;
+
+   newSize = ProceduralPrimitiveData(theEnv)->LocalVarStackSize * 2;
+   if (newSize < LOCAL_VAR_STACK_SIZE)
+     { newSize = LOCAL_VAR_STACK_SIZE; }
+   if (newSize < lvarcnt)
+     { newSize = lvarcnt; }
+
+   if (ProceduralPrimitiveData(theEnv)->LocalVarStack != NULL)
+     {
+      genfree(theEnv,ProceduralPrimitiveData(theEnv)->LocalVarStack,
+              sizeof(UDFValue) * ProceduralPrimitiveData(theEnv)->LocalVarStackSize);
+     }
+
+   ProceduralPrimitiveData(theEnv)->LocalVarStack = (UDFValue *) genalloc(theEnv,sizeof(UDFValue) * newSize);
+   ProceduralPrimitiveData(theEnv)->LocalVarStackSize = newSize;
+  }
+
 #if DEFGENERIC_CONSTRUCT
 
 /***********************************************************
@@ -879,9 +924,10 @@ Expression *GetProcParamExpressions(
                     the currently executing body for error
                     messages (can be NULL).
   RETURNS      : Nothing useful
-  SIDE EFFECTS : Allocates and deallocates space for
+  SIDE EFFECTS : Reserves and releases space for
                  local variable array.
-  NOTES        : None
+  NOTES        : The space is taken from the local
+                 variable stack when it fits.
  ***********************************************************/
 void EvaluateProcActions(
   Environment *theEnv,
@@ -896,15 +942,44 @@ void EvaluateProcActions(
    Defmodule *oldModule;
    Expression *oldActions;
    struct trackedMemory *theTM;
+   bool fromStack;
 
    oldLocalVarArray = ProceduralPrimitiveData(theEnv)->LocalVarArray;
-   ProceduralPrimitiveData(theEnv)->LocalVarArray = (lvarcnt == 0) ? NULL :
-                   (UDFValue *) gm2(theEnv,(sizeof(UDFValue) * lvarcnt));
+   theTM = NULL;
+   fromStack = false;
 
-   if (lvarcnt != 0)
-     { theTM = AddTrackedMemory(theEnv,ProceduralPrimitiveData(theEnv)->LocalVarArray,sizeof(UDFValue) * lvarcnt); }
+   if (lvarcnt == 0)
+     { ProceduralPrimitiveData(theEnv)->LocalVarArray = NULL; }
    else
-     { theTM = NULL; }
+     {
+      /* ================================================
+         The local variable frame is normally taken from
+         the top of a stack which is reused across calls.
+         The stack can only be reallocated when no frames
+         are in use since the frames of the callers are
+         referenced directly. A frame which does not fit
+         (such as in deep recursion) is allocated on its
+         own as tracked memory.
+         ================================================ */
+
+      if ((ProceduralPrimitiveData(theEnv)->LocalVarStackTop == 0) &&
+          (ProceduralPrimitiveData(theEnv)->LocalVarStackSize < (size_t) lvarcnt))
+        { GrowLocalVarStack(theEnv,(size_t) lvarcnt); }
+
+      if ((ProceduralPrimitiveData(theEnv)->LocalVarStackTop + (size_t) lvarcnt) <=
+          ProceduralPrimitiveData(theEnv)->LocalVarStackSize)
+        {
+         ProceduralPrimitiveData(theEnv)->LocalVarArray =
+            &ProceduralPrimitiveData(theEnv)->LocalVarStack[ProceduralPrimitiveData(theEnv)->LocalVarStackTop];
+         ProceduralPrimitiveData(theEnv)->LocalVarStackTop += (size_t) lvarcnt;
+         fromStack = true;
+        }
+      else
+        {
+         ProceduralPrimitiveData(theEnv)->LocalVarArray = (UDFValue *) gm2(theEnv,(sizeof(UDFValue) * lvarcnt));
+         theTM = AddTrackedMemory(theEnv,ProceduralPrimitiveData(theEnv)->LocalVarArray,sizeof(UDFValue) * lvarcnt);
+        }
+     }
 
    for (i = 0 ; i < lvarcnt ; i++)
      ProceduralPrimitiveData(theEnv)->LocalVarArray[i].supplementalInfo = FalseSymbol(theEnv);
@@ -940,11 +1015,17 @@ void EvaluateProcActions(
 
    if (lvarcnt != 0)
      {
-      RemoveTrackedMemory(theEnv,theTM);
       for (i = 0 ; i < lvarcnt ; i++)
         if (ProceduralPrimitiveData(theEnv)->LocalVarArray[i].supplementalInfo == TrueSymbol(theEnv))
           DecrementUDFValueReferenceCount(theEnv,&ProceduralPrimitiveData(theEnv)->LocalVarArray[i]);
-      rm(theEnv,ProceduralPrimitiveData(theEnv)->LocalVarArray,(sizeof(UDFValue) * lvarcnt));
+
+      if (fromStack)
+        { ProceduralPrimitiveData(theEnv)->LocalVarStackTop -= (size_t) lvarcnt; }
+      else
+        {
+         RemoveTrackedMemory(theEnv,theTM);
+         rm(theEnv,ProceduralPrimitiveData(theEnv)->LocalVarArray,(sizeof(UDFValue) * lvarcnt));
+        }
      }
 
    ProceduralPrimitiveData(theEnv)->LocalVarArray = oldLocalVarArray;
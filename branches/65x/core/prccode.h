@@ -51,6 +51,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added local variable stack fields.             */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_prccode
@@ -93,6 +95,9 @@ struct proceduralPrimitiveData
    PROC_PARAM_STACK *pstack;
    UDFValue *WildcardValue;
    UDFValue *LocalVarArray;
+   UDFValue *LocalVarStack;
+   size_t LocalVarStackSize;
+   size_t LocalVarStackTop;
    void (*ProcUnboundErrFunc)(Environment *);
    EntityRecord ProcParameterInfo;
    EntityRecord ProcWildInfo;
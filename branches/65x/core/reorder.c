@@ -55,6 +55,10 @@
 /*                                                           */
 /*            Removed initial-fact support.                  */
 /*                                                           */
+/*      6.50: Added optional cost-based ordering of the      */
+/*            pattern CEs of each disjunct                   */
+/*            (OrderJoinsByCost).                            */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -63,6 +67,7 @@
 
 #include <stdio.h>
 
+#include "crstrtgy.h"
 #include "cstrnutl.h"
 #include "envrnmnt.h"
 #include "extnfunc.h"
@@ -93,6 +98,23 @@ struct groupReference
     struct groupReference *next;
    };
 
+struct patternVariable
+   {
+    CLIPSLexeme *name;
+    bool reference;
+    struct patternVariable *next;
+   };
+
+struct joinCandidate
+   {
+    struct lhsParseNode *thePattern;
+    double estimate;
+    struct patternVariable *variables;
+    bool placed;
+   };
+
+#define JOIN_CONSTANT_SELECTIVITY 4.0
+
 /***************************************/
 /* LOCAL INTERNAL FUNCTION DEFINITIONS */
 /***************************************/
@@ -114,6 +136,15 @@ struct groupReference
    static void                    PropagateNandDepth(struct lhsParseNode *,int,int);
    static void                    MarkExistsNands(struct lhsParseNode *);
    static int                     PropagateWhichCE(struct lhsParseNode *,int);
+   static bool                    IsJoinCandidate(struct lhsParseNode *);
+   static struct lhsParseNode    *OrderJoinRun(Environment *,struct lhsParseNode *,unsigned,
+                                               struct patternVariable *,struct lhsParseNode **);
+   static struct patternVariable *CollectPatternVariables(Environment *,struct lhsParseNode *,bool,
+                                                          struct patternVariable *);
+   static void                    ReturnPatternVariables(Environment *,struct patternVariable *);
+   static unsigned                CountConstantTests(struct lhsParseNode *);
+   static bool                    JoinDependsOn(struct joinCandidate *,struct joinCandidate *);
+   static bool                    SharesVariable(struct patternVariable *,struct patternVariable *);
    /*
    static void                    PrintNodes(void *,const char *,struct lhsParseNode *);
    */
@@ -219,6 +250,8 @@ struct lhsParseNode *ReorderPatterns(
    /* analyzing the rule are not numbered so that there is no   */
    /* confusion when an error message refers to a CE. Also      */
    /* propagate field and slot values throughout each pattern.  */
+   /* If join reordering is enabled, the patterns of each       */
+   /* disjunct are first ordered by their estimated matches.    */
    /*===========================================================*/
 
    if (newLHS->pnType == OR_CE_NODE) theLHS = newLHS->right;
@@ -227,7 +260,12 @@ struct lhsParseNode *ReorderPatterns(
    for (;
         theLHS != NULL;
         theLHS = theLHS->bottom)
-     { AssignPatternIndices(theLHS->right,1,1,0); }
+     {
+      if (DefruleData(theEnv)->JoinReorderingFlag)
+        { theLHS->right = OrderJoinsByCost(theEnv,theLHS->right); }
+
+      AssignPatternIndices(theLHS->right,1,1,0);
+     }
 
    /*===========================*/
    /* Return the processed LHS. */
@@ -1860,6 +1898,416 @@ static int PropagateWhichCE(
    return whichCE;
   }
 
+/*************************************************************/
+/* OrderJoinsByCost: Reorders the top level pattern CEs of a */
+/*   disjunct so that patterns expected to have the fewest   */
+/*   matches are joined first. Only runs of adjacent, non-   */
+/*   negated pattern CEs sharing the same logical status are */
+/*   reordered. Not/exists CEs, not/and groups, and test CEs */
+/*   which could not be attached to a preceding pattern CE   */
+/*   remain in place and end a run. A test CE which follows  */
+/*   a pattern CE has already been attached to that pattern  */
+/*   as part of its network test, so it moves along with the */
+/*   pattern. Within a run, a pattern whose expressions      */
+/*   (including any attached test CE) reference a variable   */
+/*   bound by an earlier pattern is never moved ahead of     */
+/*   that pattern. Patterns sharing a variable with those    */
+/*   already placed are preferred over those which would     */
+/*   produce a cross product.                                */
+/*************************************************************/
+struct lhsParseNode *OrderJoinsByCost(
+  Environment *theEnv,
+  struct lhsParseNode *theLHS)
+  {
+   struct lhsParseNode *rv = theLHS, *lastNode = NULL, *runEnd, *nextNode, *tmpNode;
+   struct patternVariable *priorVariables = NULL;
+   unsigned runLength;
+
+   /*=========================================================*/
+   /* The mea strategy orders activations using the time tag  */
+   /* of the entity matching the first pattern, so the first  */
+   /* pattern is left in place if that strategy is in effect. */
+   /*=========================================================*/
+
+   if ((theLHS != NULL) && (GetStrategy(theEnv) == MEA_STRATEGY))
+     {
+      if (IsJoinCandidate(theLHS))
+        { priorVariables = CollectPatternVariables(theEnv,theLHS,false,priorVariables); }
+      lastNode = theLHS;
+      theLHS = theLHS->bottom;
+     }
+
+   while (theLHS != NULL)
+     {
+      /*=====================================================*/
+      /* CEs which can't be reordered are left in place. The */
+      /* variables of positive patterns are remembered so    */
+      /* that later patterns can be joined on them.          */
+      /*=====================================================*/
+
+      if (! IsJoinCandidate(theLHS))
+        {
+         if ((theLHS->pnType == PATTERN_CE_NODE) &&
+             (! theLHS->negated) && (! theLHS->exists) &&
+             (theLHS->beginNandDepth == 1))
+           { priorVariables = CollectPatternVariables(theEnv,theLHS,false,priorVariables); }
+
+         lastNode = theLHS;
+         theLHS = theLHS->bottom;
+         continue;
+        }
+
+      /*=================================================*/
+      /* Find the end of the run of patterns which can   */
+      /* be reordered with respect to one another.       */
+      /*=================================================*/
+
+      for (runEnd = theLHS, runLength = 1;
+           (runEnd->bottom != NULL) &&
+           IsJoinCandidate(runEnd->bottom) &&
+           (runEnd->bottom->logical == theLHS->logical);
+           runEnd = runEnd->bottom, runLength++)
+        { /* Do Nothing */ }
+
+      nextNode = runEnd->bottom;
+
+      if (runLength > 1)
+        {
+         runEnd->bottom = NULL;
+         theLHS = OrderJoinRun(theEnv,theLHS,runLength,priorVariables,&runEnd);
+         runEnd->bottom = nextNode;
+
+         if (lastNode == NULL)
+           { rv = theLHS; }
+         else
+           { lastNode->bottom = theLHS; }
+        }
+
+      for (tmpNode = theLHS; tmpNode != nextNode; tmpNode = tmpNode->bottom)
+        { priorVariables = CollectPatternVariables(theEnv,tmpNode,false,priorVariables); }
+
+      lastNode = runEnd;
+      theLHS = nextNode;
+     }
+
+   ReturnPatternVariables(theEnv,priorVariables);
+
+   return rv;
+  }
+
+/******************************************************/
+/* IsJoinCandidate: Determines if a CE can be moved   */
+/*   by the cost-based ordering of a rule's patterns. */
+/******************************************************/
+static bool IsJoinCandidate(
+  struct lhsParseNode *theLHS)
+  {
+   if ((theLHS->pnType != PATTERN_CE_NODE) ||
+       (! theLHS->userCE) ||
+       theLHS->negated ||
+       theLHS->exists ||
+       theLHS->existsNand ||
+       (theLHS->beginNandDepth != 1) ||
+       (theLHS->endNandDepth != 1))
+     { return false; }
+
+   if ((theLHS->patternType == NULL) ||
+       (theLHS->patternType->estimateMatchesFunction == NULL))
+     { return false; }
+
+   return true;
+  }
+
+/****************************************************************/
+/* OrderJoinRun: Greedily orders a run of pattern CEs. At each  */
+/*   step the pattern chosen (from those whose dependencies     */
+/*   have been placed) is the one producing the fewest partial  */
+/*   matches. A pattern sharing a variable with those already   */
+/*   placed is assumed to produce no more partial matches than  */
+/*   the smaller of its own estimate and the current estimate;  */
+/*   any other pattern produces the cross product of the two.   */
+/*   Ties prefer connected patterns and then original order.    */
+/****************************************************************/
+static struct lhsParseNode *OrderJoinRun(
+  Environment *theEnv,
+  struct lhsParseNode *theLHS,
+  unsigned runLength,
+  struct patternVariable *priorVariables,
+  struct lhsParseNode **runEnd)
+  {
+   struct joinCandidate *candidates;
+   struct lhsParseNode *rv = NULL, *lastNode = NULL;
+   unsigned i, j, k, constants;
+   long best;
+   bool eligible, connected, bestConnected = false;
+   double currentSize = 1.0, cost, bestCost = 0.0;
+
+   candidates = (struct joinCandidate *)
+                genalloc(theEnv,sizeof(struct joinCandidate) * runLength);
+
+   /*====================================================*/
+   /* Estimate the number of matches for each pattern.   */
+   /* Each constant test in the pattern is assumed to    */
+   /* reduce the number of matches by a constant factor. */
+   /*====================================================*/
+
+   for (i = 0; i < runLength; i++, theLHS = theLHS->bottom)
+     {
+      candidates[i].thePattern = theLHS;
+      candidates[i].placed = false;
+      candidates[i].estimate = (double)
+         (*theLHS->patternType->estimateMatchesFunction)(theEnv,theLHS) + 1.0;
+
+      for (constants = CountConstantTests(theLHS->right); constants > 0; constants--)
+        { candidates[i].estimate /= JOIN_CONSTANT_SELECTIVITY; }
+
+      candidates[i].variables = CollectPatternVariables(theEnv,theLHS,false,NULL);
+     }
+
+   /*=================================*/
+   /* Place the patterns one by one.  */
+   /*=================================*/
+
+   for (k = 0; k < runLength; k++)
+     {
+      best = -1;
+
+      for (j = 0; j < runLength; j++)
+        {
+         if (candidates[j].placed) continue;
+
+         /*===============================================*/
+         /* A pattern can't be placed before an unplaced  */
+         /* pattern that originally preceded it and binds */
+         /* a variable its expressions reference.         */
+         /*===============================================*/
+
+         for (i = 0, eligible = true; (i < j) && eligible; i++)
+           {
+            if ((! candidates[i].placed) &&
+                JoinDependsOn(&candidates[j],&candidates[i]))
+              { eligible = false; }
+           }
+
+         if (! eligible) continue;
+
+         /*=============================================*/
+         /* Determine if the pattern shares a variable  */
+         /* with a pattern that has already been placed */
+         /* (or that precedes the run).                 */
+         /*=============================================*/
+
+         connected = SharesVariable(candidates[j].variables,priorVariables);
+         for (i = 0; (i < runLength) && (! connected); i++)
+           {
+            if (candidates[i].placed &&
+                SharesVariable(candidates[j].variables,candidates[i].variables))
+              { connected = true; }
+           }
+
+         if (connected)
+           { cost = (currentSize < candidates[j].estimate) ? currentSize : candidates[j].estimate; }
+         else
+           { cost = currentSize * candidates[j].estimate; }
+
+         if ((best == -1) ||
+             (cost < bestCost) ||
+             ((cost == bestCost) && connected && (! bestConnected)))
+           {
+            best = (long) j;
+            bestCost = cost;
+            bestConnected = connected;
+           }
+        }
+
+      candidates[best].placed = true;
+      currentSize = bestCost;
+
+      if (lastNode == NULL)
+        { rv = candidates[best].thePattern; }
+      else
+        { lastNode->bottom = candidates[best].thePattern; }
+
+      lastNode = candidates[best].thePattern;
+     }
+
+   lastNode->bottom = NULL;
+   *runEnd = lastNode;
+
+   for (i = 0; i < runLength; i++)
+     { ReturnPatternVariables(theEnv,candidates[i].variables); }
+
+   genfree(theEnv,candidates,sizeof(struct joinCandidate) * runLength);
+
+   return rv;
+  }
+
+/****************************************************************/
+/* CollectPatternVariables: Adds the variables referenced in a  */
+/*   pattern CE to a list. A variable can only be bound by the  */
+/*   field or slot in which it appears by itself (or as the     */
+/*   first term of a & connective constraint, which the parser  */
+/*   moves into the field). All other occurrences, including    */
+/*   those within connective constraints and predicate or       */
+/*   return value constraints, are marked as references. The    */
+/*   variable to which the pattern is bound is included as a    */
+/*   variable bound by the pattern.                             */
+/****************************************************************/
+static struct patternVariable *CollectPatternVariables(
+  Environment *theEnv,
+  struct lhsParseNode *theField,
+  bool reference,
+  struct patternVariable *theList)
+  {
+   struct patternVariable *newVariable;
+
+   if ((theField != NULL) &&
+       (theField->pnType == PATTERN_CE_NODE))
+     {
+      if (theField->value != NULL)
+        {
+         newVariable = get_struct(theEnv,patternVariable);
+         newVariable->name = theField->lexemeValue;
+         newVariable->reference = false;
+         newVariable->next = theList;
+         theList = newVariable;
+        }
+
+      theList = CollectPatternVariables(theEnv,theField->expression,true,theList);
+      return CollectPatternVariables(theEnv,theField->right,false,theList);
+     }
+
+   for (; theField != NULL; theField = theField->right)
+     {
+      if ((theField->pnType == SF_VARIABLE_NODE) ||
+          (theField->pnType == MF_VARIABLE_NODE))
+        {
+         newVariable = get_struct(theEnv,patternVariable);
+         newVariable->name = theField->lexemeValue;
+         newVariable->reference = reference;
+         newVariable->next = theList;
+         theList = newVariable;
+        }
+
+      /*==================================================*/
+      /* The fields of a multifield slot can bind         */
+      /* variables, but the variables in the connective   */
+      /* constraints attached to a field or slot can't.   */
+      /*==================================================*/
+
+      if (theField->multifieldSlot)
+        { theList = CollectPatternVariables(theEnv,theField->bottom,reference,theList); }
+      else
+        { theList = CollectPatternVariables(theEnv,theField->bottom,true,theList); }
+
+      theList = CollectPatternVariables(theEnv,theField->expression,true,theList);
+      theList = CollectPatternVariables(theEnv,theField->secondaryExpression,true,theList);
+     }
+
+   return theList;
+  }
+
+/***********************************************************/
+/* ReturnPatternVariables: Returns a list of variables     */
+/*   created by CollectPatternVariables to the memory      */
+/*   manager.                                              */
+/***********************************************************/
+static void ReturnPatternVariables(
+  Environment *theEnv,
+  struct patternVariable *theList)
+  {
+   struct patternVariable *nextVariable;
+
+   while (theList != NULL)
+     {
+      nextVariable = theList->next;
+      rtn_struct(theEnv,patternVariable,theList);
+      theList = nextVariable;
+     }
+  }
+
+/*************************************************************/
+/* CountConstantTests: Counts the fields of a pattern which  */
+/*   are restricted to a constant value (with no | or ~      */
+/*   connective constraints).                                */
+/*************************************************************/
+static unsigned CountConstantTests(
+  struct lhsParseNode *theField)
+  {
+   struct lhsParseNode *andField;
+   unsigned count = 0;
+
+   for (; theField != NULL; theField = theField->right)
+     {
+      if (theField->multifieldSlot)
+        {
+         count += CountConstantTests(theField->bottom);
+         continue;
+        }
+
+      if ((theField->bottom == NULL) || (theField->bottom->bottom != NULL))
+        { continue; }
+
+      for (andField = theField->bottom; andField != NULL; andField = andField->right)
+        {
+         if ((! andField->negated) && ConstantNode(andField))
+           {
+            count++;
+            break;
+           }
+        }
+     }
+
+   return count;
+  }
+
+/**********************************************************/
+/* JoinDependsOn: Determines if the constraints or the    */
+/*   attached test CE of one pattern reference a variable */
+/*   bound by another pattern.                            */
+/**********************************************************/
+static bool JoinDependsOn(
+  struct joinCandidate *thePattern,
+  struct joinCandidate *otherPattern)
+  {
+   struct patternVariable *theReference, *binding;
+
+   for (theReference = thePattern->variables; theReference != NULL; theReference = theReference->next)
+     {
+      if (! theReference->reference) continue;
+
+      for (binding = otherPattern->variables; binding != NULL; binding = binding->next)
+        {
+         if ((! binding->reference) && (binding->name == theReference->name))
+           { return true; }
+        }
+     }
+
+   return false;
+  }
+
+/********************************************************/
+/* SharesVariable: Determines if two lists of variables */
+/*   have a variable in common.                         */
+/********************************************************/
+static bool SharesVariable(
+  struct patternVariable *list1,
+  struct patternVariable *list2)
+  {
+   struct patternVariable *theVariable;
+
+   for (; list1 != NULL; list1 = list1->next)
+     {
+      for (theVariable = list2; theVariable != NULL; theVariable = theVariable->next)
+        {
+         if (theVariable->name == list1->name)
+           { return true; }
+        }
+     }
+
+   return false;
+  }
+
 /********************/
 /* IsExistsSubjoin: */
 /********************/
@@ -145,6 +145,7 @@ struct lhsParseNode
   };
 
    struct lhsParseNode           *ReorderPatterns(Environment *,struct lhsParseNode *,bool *);
+   struct lhsParseNode           *OrderJoinsByCost(Environment *,struct lhsParseNode *);
    struct lhsParseNode           *CopyLHSParseNodes(Environment *,struct lhsParseNode *);
    void                           CopyLHSParseNode(Environment *,struct lhsParseNode *,struct lhsParseNode *,bool);
    struct lhsParseNode           *GetLHSParseNode(Environment *);
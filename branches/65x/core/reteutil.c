@@ -56,6 +56,10 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: The alphaMatch of an alpha memory partial      */
+/*            match is allocated in the same block as the    */
+/*            partial match.                                 */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -137,6 +141,8 @@ struct partialMatch *CopyPartialMatch(
 
    linker = get_var_struct(theEnv,partialMatch,sizeof(struct genericMatch) *
                                         (list->bcount - 1));
+   UpdateSubsystemMemory(theEnv,BETA_MEMORY,(long) (sizeof(struct partialMatch) +
+                                                    (sizeof(struct genericMatch) * (list->bcount - 1))));
 
    InitializePMLinks(linker);
    linker->betaMemory = true;
@@ -159,6 +165,7 @@ struct partialMatch *CreateEmptyPartialMatch(
    struct partialMatch *linker;
 
    linker = get_struct(theEnv,partialMatch);
+   UpdateSubsystemMemory(theEnv,BETA_MEMORY,(long) sizeof(struct partialMatch));
 
    InitializePMLinks(linker);
    linker->betaMemory = true;
@@ -594,6 +601,8 @@ struct partialMatch *MergePartialMatches(
    /*=================================*/
 
    linker = get_var_struct(theEnv,partialMatch,sizeof(struct genericMatch) * lhsBind->bcount);
+   UpdateSubsystemMemory(theEnv,BETA_MEMORY,(long) (sizeof(struct partialMatch) +
+                                                    (sizeof(struct genericMatch) * lhsBind->bcount)));
 
    /*============================================*/
    /* Set the flags to their appropriate values. */
@@ -672,16 +681,20 @@ struct partialMatch *CreateAlphaMatch(
 
    /*==================================================*/
    /* Create the alpha match and intialize its values. */
+   /* The alphaMatch is allocated in the same block as */
+   /* the partial match since they are always returned */
+   /* to the pool of free memory together.             */
    /*==================================================*/
 
-   theMatch = get_struct(theEnv,partialMatch);
+   theMatch = get_var_struct(theEnv,partialMatch,sizeof(struct alphaMatch));
+   UpdateSubsystemMemory(theEnv,ALPHA_MEMORY,(long) (sizeof(struct partialMatch) + sizeof(struct alphaMatch)));
    InitializePMLinks(theMatch);
    theMatch->betaMemory = false;
    theMatch->busy = false;
    theMatch->bcount = 1;
    theMatch->hashValue = hashOffset;
 
-   afbtemp = get_struct(theEnv,alphaMatch);
+   afbtemp = (struct alphaMatch *) (((char *) theMatch) + sizeof(struct partialMatch));
    afbtemp->next = NULL;
    afbtemp->matchingItem = (struct patternEntity *) theEntity;
 
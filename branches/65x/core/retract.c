@@ -39,6 +39,9 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Alpha memory partial matches are returned      */
+/*            along with their alphaMatch as a single block. */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -561,15 +564,20 @@ void ReturnPartialMatch(
    /*======================================================*/
    /* If we're dealing with an alpha memory partial match, */
    /* then return the multifield markers associated with   */
-   /* the partial match (if any) along with the alphaMatch */
-   /* data structure.                                      */
+   /* the partial match (if any). The alphaMatch data      */
+   /* structure is part of the partial match's memory.     */
    /*======================================================*/
 
    if (waste->betaMemory == false)
      {
       if (waste->binds[0].gm.theMatch->markers != NULL)
         { ReturnMarkers(theEnv,waste->binds[0].gm.theMatch->markers); }
-      rm(theEnv,waste->binds[0].gm.theMatch,(int) sizeof(struct alphaMatch));
+      UpdateSubsystemMemory(theEnv,ALPHA_MEMORY,- (long) (sizeof(struct partialMatch) + sizeof(struct alphaMatch)));
+     }
+   else
+     {
+      UpdateSubsystemMemory(theEnv,BETA_MEMORY,- (long) (sizeof(struct partialMatch) +
+                                                         (sizeof(struct genericMatch) * (size_t) (waste->bcount - 1))));
      }
 
    /*=================================================*/
@@ -584,9 +592,14 @@ void ReturnPartialMatch(
    /* Return the partial match to the pool of free memory. */
    /*======================================================*/
 
-   rtn_var_struct(theEnv,partialMatch,(int) sizeof(struct genericMatch *) *
-                  (waste->bcount - 1),
-                  waste);
+   if (waste->betaMemory == false)
+     { rtn_var_struct(theEnv,partialMatch,sizeof(struct alphaMatch),waste); }
+   else
+     {
+      rtn_var_struct(theEnv,partialMatch,(int) sizeof(struct genericMatch *) *
+                     (waste->bcount - 1),
+                     waste);
+     }
   }
 
 /***************************************************************/
@@ -600,15 +613,20 @@ void DestroyPartialMatch(
    /*======================================================*/
    /* If we're dealing with an alpha memory partial match, */
    /* then return the multifield markers associated with   */
-   /* the partial match (if any) along with the alphaMatch */
-   /* data structure.                                      */
+   /* the partial match (if any). The alphaMatch data      */
+   /* structure is part of the partial match's memory.     */
    /*======================================================*/
 
    if (waste->betaMemory == false)
      {
       if (waste->binds[0].gm.theMatch->markers != NULL)
         { ReturnMarkers(theEnv,waste->binds[0].gm.theMatch->markers); }
-      rm(theEnv,waste->binds[0].gm.theMatch,(int) sizeof(struct alphaMatch));
+      UpdateSubsystemMemory(theEnv,ALPHA_MEMORY,- (long) (sizeof(struct partialMatch) + sizeof(struct alphaMatch)));
+     }
+   else
+     {
+      UpdateSubsystemMemory(theEnv,BETA_MEMORY,- (long) (sizeof(struct partialMatch) +
+                                                         (sizeof(struct genericMatch) * (size_t) (waste->bcount - 1))));
      }
 
    /*=================================================*/
@@ -623,9 +641,14 @@ void DestroyPartialMatch(
    /* Return the partial match to the pool of free memory. */
    /*======================================================*/
 
-   rtn_var_struct(theEnv,partialMatch,(int) sizeof(struct genericMatch *) *
-                  (waste->bcount - 1),
-                  waste);
+   if (waste->betaMemory == false)
+     { rtn_var_struct(theEnv,partialMatch,sizeof(struct alphaMatch),waste); }
+   else
+     {
+      rtn_var_struct(theEnv,partialMatch,(int) sizeof(struct genericMatch *) *
+                     (waste->bcount - 1),
+                     waste);
+     }
   }
 
 /******************************************************/
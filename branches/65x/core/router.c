@@ -57,6 +57,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added a cache of the routers which handle      */
+/*            print requests for each logical name.          */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -74,6 +77,7 @@
 #include "prntutil.h"
 #include "scanner.h"
 #include "strngrtr.h"
+#include "symbol.h"
 #include "sysdep.h"
 
 #include "router.h"
@@ -83,6 +87,7 @@
 /***************************************/
 
    static bool                    QueryRouter(Environment *,const char *,struct router *);
+   static struct router          *FindPrintRouter(Environment *,const char *);
    static void                    DeallocateRouterData(Environment *);
 
 /*********************************************************/
@@ -95,6 +100,7 @@ void InitializeDefaultRouters(
 
    RouterData(theEnv)->CommandBufferInputCount = 0;
    RouterData(theEnv)->AwaitingInput = true;
+   RouterData(theEnv)->RouterCacheGeneration = 1;
 
    InitializeFileRouter(theEnv);
    InitializeStringRouter(theEnv);
@@ -142,20 +148,16 @@ void PrintString(
       return;
      }
 
-   /*==============================================*/
-   /* Search through the list of routers until one */
-   /* is found that will handle the print request. */
-   /*==============================================*/
+   /*==========================================*/
+   /* Find the router which will handle the    */
+   /* print request and pass the string to it. */
+   /*==========================================*/
 
-   currentPtr = RouterData(theEnv)->ListOfRouters;
-   while (currentPtr != NULL)
+   currentPtr = FindPrintRouter(theEnv,logicalName);
+   if (currentPtr != NULL)
      {
-      if ((currentPtr->printCallback != NULL) ? QueryRouter(theEnv,logicalName,currentPtr) : false)
-        {
-         (*currentPtr->printCallback)(theEnv,logicalName,str,currentPtr->context);
-         return;
-        }
-      currentPtr = currentPtr->next;
+      (*currentPtr->printCallback)(theEnv,logicalName,str,currentPtr->context);
+      return;
      }
 
    /*=====================================================*/
@@ -166,6 +168,87 @@ void PrintString(
      { UnrecognizedRouterMessage(theEnv,logicalName); }
   }
 
+/*******************************************************/
+/* FindPrintRouter: Returns the first active router    */
+/*   with a print function which recognizes a logical  */
+/*   name, or NULL if there is none. The router found  */
+/*   for a name is cached so that subsequent requests  */
+/*   don't need to query each router in the list.      */
+/*******************************************************/
+static struct router *FindPrintRouter(
+  Environment *theEnv,
+  const char *logicalName)
+  {
+   struct router *currentPtr;
+   struct routerCacheEntry *theEntry = NULL;
+
+   /*============================================*/
+   /* Names too long for the cache are looked up */
+   /* each time they're used.                    */
+   /*============================================*/
+
+   if (strlen(logicalName) < ROUTER_CACHE_NAME_LENGTH)
+     {
+      theEntry = &RouterData(theEnv)->PrintRouterCache[HashSymbol(logicalName,ROUTER_CACHE_SIZE)];
+      if ((theEntry->generation == RouterData(theEnv)->RouterCacheGeneration) &&
+          (strcmp(theEntry->logicalName,logicalName) == 0))
+        { return theEntry->theRouter; }
+     }
+
+   /*==============================================*/
+   /* Search through the list of routers until one */
+   /* is found that will handle the print request. */
+   /*==============================================*/
+
+   for (currentPtr = RouterData(theEnv)->ListOfRouters;
+        currentPtr != NULL;
+        currentPtr = currentPtr->next)
+     {
+      if ((currentPtr->printCallback != NULL) ? QueryRouter(theEnv,logicalName,currentPtr) : false)
+        { break; }
+     }
+
+   /*===============================================*/
+   /* Only names recognized by a router are cached. */
+   /*===============================================*/
+
+   if ((currentPtr != NULL) && (theEntry != NULL))
+     {
+      theEntry->generation = RouterData(theEnv)->RouterCacheGeneration;
+      theEntry->theRouter = currentPtr;
+      genstrcpy(theEntry->logicalName,logicalName);
+     }
+
+   return currentPtr;
+  }
+
+/*********************************************************/
+/* InvalidateRouterCache: Empties the cache of routers   */
+/*   which handle print requests. Called whenever a      */
+/*   router is added, deleted, activated, or deactivated */
+/*   and by any router whose query function changes the  */
+/*   logical names it recognizes.                        */
+/*********************************************************/
+void InvalidateRouterCache(
+  Environment *theEnv)
+  {
+   int i;
+
+   RouterData(theEnv)->RouterCacheGeneration++;
+
+   /*=================================================*/
+   /* If the generation wraps around, clear the cache */
+   /* so that old entries can't become valid again.   */
+   /*=================================================*/
+
+   if (RouterData(theEnv)->RouterCacheGeneration == 0)
+     {
+      for (i = 0; i < ROUTER_CACHE_SIZE; i++)
+        { RouterData(theEnv)->PrintRouterCache[i].generation = 0; }
+      RouterData(theEnv)->RouterCacheGeneration = 1;
+     }
+  }
+
 /***********************************************/
 /* GetcRouter: Generic get character function. */
 /***********************************************/
@@ -416,6 +499,8 @@ bool AddRouter(
    newPtr->ungetcCallback = ungetcFunction;
    newPtr->next = NULL;
 
+   InvalidateRouterCache(theEnv);
+
    if (RouterData(theEnv)->ListOfRouters == NULL)
      {
       RouterData(theEnv)->ListOfRouters = newPtr;
@@ -460,6 +545,7 @@ bool DeleteRouter(
      {
       if (strcmp(currentPtr->name,routerName) == 0)
         {
+         InvalidateRouterCache(theEnv);
          genfree(theEnv,(void *) currentPtr->name,strlen(currentPtr->name) + 1);
          if (lastPtr == NULL)
            {
@@ -487,6 +573,9 @@ bool QueryRouters(
   {
    struct router *currentPtr;
 
+   if (FindPrintRouter(theEnv,logicalName) != NULL)
+     { return true; }
+
    currentPtr = RouterData(theEnv)->ListOfRouters;
    while (currentPtr != NULL)
      {
@@ -546,6 +635,7 @@ bool DeactivateRouter(
       if (strcmp(currentPtr->name,routerName) == 0)
         {
          currentPtr->active = false;
+         InvalidateRouterCache(theEnv);
          return true;
         }
       currentPtr = currentPtr->next;
@@ -570,6 +660,7 @@ bool ActivateRouter(
       if (strcmp(currentPtr->name,routerName) == 0)
         {
          currentPtr->active = true;
+         InvalidateRouterCache(theEnv);
          return true;
         }
       currentPtr = currentPtr->next;
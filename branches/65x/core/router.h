@@ -58,6 +58,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added a cache of the routers which handle      */
+/*            print requests for each logical name.          */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_router
@@ -86,6 +89,9 @@ typedef int RouterUngetcFunction(Environment *,const char *,int,void *);
 
 #define ROUTER_DATA 46
 
+#define ROUTER_CACHE_SIZE 16
+#define ROUTER_CACHE_NAME_LENGTH 32
+
 struct router
   {
    const char *name;
@@ -100,6 +106,21 @@ struct router
    Router *next;
   };
 
+/******************************************************/
+/* The router which handles print requests for a      */
+/* logical name is cached by name. An entry is valid  */
+/* only if its generation matches the current cache   */
+/* generation, so incrementing the generation empties */
+/* the cache.                                         */
+/******************************************************/
+
+struct routerCacheEntry
+  {
+   unsigned long generation;
+   Router *theRouter;
+   char logicalName[ROUTER_CACHE_NAME_LENGTH];
+  };
+
 struct routerData
   {
    size_t CommandBufferInputCount;
@@ -112,6 +133,8 @@ struct routerData
    FILE *FastLoadFilePtr;
    FILE *FastSaveFilePtr;
    bool Abort;
+   unsigned long RouterCacheGeneration;
+   struct routerCacheEntry PrintRouterCache[ROUTER_CACHE_SIZE];
   };
 
 #define RouterData(theEnv) ((struct routerData *) GetEnvironmentData(theEnv,ROUTER_DATA))
@@ -138,5 +161,6 @@ struct routerData
    void                           PrintNRouter(Environment *,const char *,const char *,unsigned long);
    size_t                         InputBufferCount(Environment *);
    Router                        *FindRouter(Environment *,const char *);
+   void                           InvalidateRouterCache(Environment *);
 
 #endif /* _H_router */
@@ -0,0 +1,1744 @@
+   /*******************************************************/
+   /*      "C" Language Integrated Production System      */
+   /*                                                     */
+   /*             CLIPS Version 6.50  11/01/16            */
+   /*                                                     */
+   /*                RESET SNAPSHOT MODULE                */
+   /*******************************************************/
+
+/*************************************************************/
+/* Purpose: Captures the state of working memory, the        */
+/*   pattern and join networks, and the agenda at the end of */
+/*   a reset so that subsequent resets can restore the state */
+/*   without asserting the deffacts and matching them again. */
+/*                                                           */
+/*   The snapshot is taken by the first reset after the      */
+/*   set-reset-snapshot command enables snapshots. Later     */
+/*   resets still remove the facts and instances and reset   */
+/*   the defglobals, but the network priming and deffacts    */
+/*   reset functions are replaced by copying the snapshot.   */
+/*   Since the deffacts are not evaluated again, function    */
+/*   calls and global variable references in the deffacts    */
+/*   return the values from the reset that was captured.     */
+/*                                                           */
+/*   Adding or removing a defrule, deffacts, deftemplate, or */
+/*   definstances, or clearing the environment, discards the */
+/*   snapshot. A full reset is performed if facts or         */
+/*   activations are being watched, if the settings which    */
+/*   affect the outcome of a reset have changed, or if the   */
+/*   reset produced anything the snapshot can't represent    */
+/*   (instances, logical support, or fact and instance       */
+/*   address slot values).                                   */
+/*                                                           */
+/*   No snapshot is taken if a pattern or join network test, */
+/*   or a salience evaluated on activation, references a     */
+/*   defglobal or calls a deffunction or generic function,   */
+/*   since these can give a different result on the next     */
+/*   reset. The same applies to a deffacts which asserts a   */
+/*   value computed by a function call or taken from a       */
+/*   defglobal (including slot values supplied by a          */
+/*   default-dynamic attribute). Snapshots are also not used */
+/*   while a reset function added by a user would run after  */
+/*   the snapshot is restored.                               */
+/*                                                           */
+/* Principal Programmer(s):                                  */
+/*      Gary D. Riley                                        */
+/*                                                           */
+/* Contributing Programmer(s):                               */
+/*                                                           */
+/* Revision History:                                         */
+/*                                                           */
+/*      6.50: Added reset snapshots.                         */
+/*                                                           */
+/*            Snapshots aren't restored while a binary trace */
+/*            of facts or activations is in progress.        */
+/*                                                           */
+/*            No snapshot is taken if a network test         */
+/*            references a defglobal or calls a deffunction  */
+/*            or generic function.                           */
+/*                                                           */
+/*            Snapshots aren't used while user reset         */
+/*            functions would run after the restore.         */
+/*                                                           */
+/*            No snapshot is taken if a deffacts asserts a   */
+/*            value computed by a function call or taken     */
+/*            from a defglobal.                              */
+/*                                                           */
+/*************************************************************/
+
+#include "setup.h"
+
+#if DEFRULE_CONSTRUCT && DEFTEMPLATE_CONSTRUCT
+
+#include <string.h>
+
+#include "agenda.h"
+#include "argacces.h"
+#include "bintrace.h"
+#include "constrct.h"
+#include "constrnt.h"
+#include "dffctdef.h"
+#include "crstrtgy.h"
+#include "engine.h"
+#include "envrnmnt.h"
+#include "extnfunc.h"
+#include "factbld.h"
+#include "facthsh.h"
+#include "factmngr.h"
+#include "memalloc.h"
+#include "moduldef.h"
+#include "multifld.h"
+#include "reteutil.h"
+#include "ruledef.h"
+#include "tmpltdef.h"
+#include "utility.h"
+#if OBJECT_SYSTEM
+#include "inscom.h"
+#endif
+
+#include "rsetsnap.h"
+
+/****************************************************/
+/* The address table maps the data structures found */
+/* while capturing a snapshot to their ordinals.    */
+/****************************************************/
+
+struct snapshotAddress
+  {
+   void *address;
+   unsigned long ordinal;
+  };
+
+struct snapshotAddressTable
+  {
+   struct snapshotAddress *entries;
+   unsigned long size;
+  };
+
+/******************************************************/
+/* The reset functions which are allowed to run after */
+/* a snapshot has been restored. Each of them either  */
+/* checks whether a snapshot was restored or has no   */
+/* effect on the state held by the snapshot.          */
+/******************************************************/
+
+struct snapshotResetFunction
+  {
+   const char *name;
+   int priority;
+  };
+
+static struct snapshotResetFunction SnapshotResetFunctions[] =
+  {
+   { "reset-snapshot", 11 },
+   { "defrule", 10 },
+   { "deffacts", 0 },
+   { "definstances", 0 },
+   { "bind", 0 },
+   { "reset-snapshot", -10000 },
+   { NULL, 0 }
+  };
+
+/***************************************/
+/* LOCAL INTERNAL FUNCTION DEFINITIONS */
+/***************************************/
+
+   static void                    DeallocateResetSnapshotData(Environment *);
+   static void                    RestoreResetSnapshot(Environment *,void *);
+   static void                    CaptureResetSnapshot(Environment *,void *);
+#if (! RUN_TIME)
+   static void                    ClearResetSnapshot(Environment *,void *);
+   static bool                    ClearResetSnapshotReady(Environment *,void *);
+#endif
+   static bool                    SnapshotAllowed(Environment *);
+   static bool                    KnownResetFunction(struct voidCallFunctionItem *);
+   static bool                    SnapshotRestorable(Environment *,struct resetSnapshot *);
+   static struct resetSnapshot   *CreateSnapshot(Environment *);
+   static bool                    CountSnapshot(Environment *,struct resetSnapshot *,struct joinNode **,unsigned long);
+   static bool                    CapturableFact(Fact *);
+   static bool                    CapturableValue(CLIPSValue *);
+   static unsigned long           CollectJoins(Environment *,struct joinNode **);
+   static void                    CollectRuleJoins(struct joinNode *,struct joinNode **,unsigned long *);
+   static bool                    NetworkUsesChangingValues(Environment *,struct joinNode **,unsigned long);
+   static bool                    FactNetworkUsesChangingValues(struct factPatternNode *);
+   static bool                    ExpressionUsesChangingValues(struct expr *);
+#if DEFFACTS_CONSTRUCT
+   static bool                    DeffactsUseChangingValues(Environment *);
+   static bool                    AssertListUsesChangingValues(struct expr *,void *,void *);
+#endif
+   static void                    AddSnapshotAddress(struct snapshotAddressTable *,void *,unsigned long);
+   static unsigned long           SnapshotOrdinal(struct snapshotAddressTable *,void *,bool *);
+   static Fact                   *CopySnapshotFact(Environment *,Fact *);
+   static MultifieldMarker       *CopySnapshotMarkers(Environment *,MultifieldMarker *);
+   static void                    ReturnSnapshotMarkers(Environment *,MultifieldMarker *);
+   static void                    ReturnSnapshot(Environment *,struct resetSnapshot *,bool);
+   static void                    RestoreSnapshot(Environment *,struct resetSnapshot *);
+   static void                    SetBetaMemorySize(Environment *,struct betaMemory *,unsigned long);
+
+/*****************************************************/
+/* InitializeResetSnapshot: Initializes the reset    */
+/*   snapshot data and the set-reset-snapshot and    */
+/*   get-reset-snapshot commands. The snapshot is    */
+/*   restored just before the network is primed (at  */
+/*   priority 10) and captured after every other     */
+/*   reset function has been called.                 */
+/*****************************************************/
+void InitializeResetSnapshot(
+  Environment *theEnv)
+  {
+   AllocateEnvironmentData(theEnv,RESET_SNAPSHOT_DATA,sizeof(struct resetSnapshotData),DeallocateResetSnapshotData);
+
+   ResetSnapshotData(theEnv)->SnapshotEnabled = false;
+   ResetSnapshotData(theEnv)->SnapshotRestored = false;
+   ResetSnapshotData(theEnv)->Snapshot = NULL;
+
+   AddResetFunction(theEnv,"reset-snapshot",RestoreResetSnapshot,11,NULL);
+   AddResetFunction(theEnv,"reset-snapshot",CaptureResetSnapshot,-10000,NULL);
+#if (! RUN_TIME)
+   AddClearReadyFunction(theEnv,"reset-snapshot",ClearResetSnapshotReady,0,NULL);
+   AddClearFunction(theEnv,"reset-snapshot",ClearResetSnapshot,0,NULL);
+
+   AddUDF(theEnv,"get-reset-snapshot","b",0,0,NULL,GetResetSnapshotCommand,"GetResetSnapshotCommand",NULL);
+   AddUDF(theEnv,"set-reset-snapshot","b",1,1,NULL,SetResetSnapshotCommand,"SetResetSnapshotCommand",NULL);
+#endif
+  }
+
+/**************************************************/
+/* DeallocateResetSnapshotData: Deallocates the   */
+/*   environment data for reset snapshots. Atomic */
+/*   values are not released since the symbol     */
+/*   tables have already been deallocated.        */
+/**************************************************/
+static void DeallocateResetSnapshotData(
+  Environment *theEnv)
+  {
+   if (ResetSnapshotData(theEnv)->Snapshot != NULL)
+     { ReturnSnapshot(theEnv,ResetSnapshotData(theEnv)->Snapshot,false); }
+  }
+
+/*********************************************/
+/* GetResetSnapshot: C access routine for    */
+/*   the get-reset-snapshot command.         */
+/*********************************************/
+bool GetResetSnapshot(
+  Environment *theEnv)
+  {
+   return ResetSnapshotData(theEnv)->SnapshotEnabled;
+  }
+
+/*************************************************/
+/* SetResetSnapshot: C access routine for the    */
+/*   set-reset-snapshot command. Disabling reset */
+/*   snapshots discards the current snapshot.    */
+/*************************************************/
+bool SetResetSnapshot(
+  Environment *theEnv,
+  bool value)
+  {
+   bool ov;
+
+   ov = ResetSnapshotData(theEnv)->SnapshotEnabled;
+
+   ResetSnapshotData(theEnv)->SnapshotEnabled = value;
+
+   if (! value)
+     { DiscardResetSnapshot(theEnv); }
+
+   return ov;
+  }
+
+/*************************************************/
+/* DiscardResetSnapshot: Discards the snapshot   */
+/*   (if any) so that the next reset is a full   */
+/*   reset. Called whenever a construct that can */
+/*   affect the outcome of a reset is changed.   */
+/*************************************************/
+void DiscardResetSnapshot(
+  Environment *theEnv)
+  {
+   struct resetSnapshot *theSnapshot;
+
+   theSnapshot = ResetSnapshotData(theEnv)->Snapshot;
+   if (theSnapshot == NULL) return;
+
+   ResetSnapshotData(theEnv)->Snapshot = NULL;
+   ReturnSnapshot(theEnv,theSnapshot,true);
+  }
+
+/*****************************************************/
+/* ResetSnapshotRestored: Returns true if the reset  */
+/*   in progress restored a snapshot, in which case  */
+/*   the network priming and deffacts reset routines */
+/*   have nothing to do.                             */
+/*****************************************************/
+bool ResetSnapshotRestored(
+  Environment *theEnv)
+  {
+   return ResetSnapshotData(theEnv)->SnapshotRestored;
+  }
+
+/*************************************************/
+/* SetResetSnapshotCommand: H/L access routine   */
+/*   for the set-reset-snapshot command.         */
+/*************************************************/
+void SetResetSnapshotCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   UDFValue theArg;
+
+   returnValue->lexemeValue = CreateBoolean(theEnv,GetResetSnapshot(theEnv));
+
+   /*====================================================*/
+   /* The symbol FALSE disables reset snapshots. Any     */
+   /* other value enables them for the following resets. */
+   /*====================================================*/
+
+   if (! UDFFirstArgument(context,ANY_TYPE_BITS,&theArg))
+     { return; }
+
+   if (theArg.value == FalseSymbol(theEnv))
+     { SetResetSnapshot(theEnv,false); }
+   else
+     { SetResetSnapshot(theEnv,true); }
+  }
+
+/*************************************************/
+/* GetResetSnapshotCommand: H/L access routine   */
+/*   for the get-reset-snapshot command.         */
+/*************************************************/
+void GetResetSnapshotCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   returnValue->lexemeValue = CreateBoolean(theEnv,GetResetSnapshot(theEnv));
+  }
+
+#if (! RUN_TIME)
+
+/*********************************************************/
+/* ClearResetSnapshotReady: Discards the snapshot before */
+/*   a clear or a bload removes the constructs it uses.  */
+/*********************************************************/
+static bool ClearResetSnapshotReady(
+  Environment *theEnv,
+  void *context)
+  {
+   DiscardResetSnapshot(theEnv);
+   return true;
+  }
+
+/********************************************************/
+/* ClearResetSnapshot: Reset snapshot clear routine for */
+/*   use with the clear command.                        */
+/********************************************************/
+static void ClearResetSnapshot(
+  Environment *theEnv,
+  void *context)
+  {
+   DiscardResetSnapshot(theEnv);
+  }
+
+#endif
+
+/**********************************************************/
+/* RestoreResetSnapshot: Reset snapshot reset routine     */
+/*   called after the facts and instances are removed and */
+/*   before the network is primed. If the snapshot can be */
+/*   used, it is copied into the empty network.           */
+/**********************************************************/
+static void RestoreResetSnapshot(
+  Environment *theEnv,
+  void *context)
+  {
+   struct resetSnapshot *theSnapshot;
+
+   ResetSnapshotData(theEnv)->SnapshotRestored = false;
+
+   theSnapshot = ResetSnapshotData(theEnv)->Snapshot;
+   if (theSnapshot == NULL) return;
+
+   if ((! SnapshotAllowed(theEnv)) ||
+       (! SnapshotRestorable(theEnv,theSnapshot)))
+     {
+      DiscardResetSnapshot(theEnv);
+      return;
+     }
+
+   RestoreSnapshot(theEnv,theSnapshot);
+
+   ResetSnapshotData(theEnv)->SnapshotRestored = true;
+  }
+
+/********************************************************/
+/* CaptureResetSnapshot: Reset snapshot reset routine   */
+/*   called after all other reset routines. Captures a  */
+/*   snapshot if snapshots are enabled and the previous */
+/*   snapshot was discarded or not yet taken.           */
+/********************************************************/
+static void CaptureResetSnapshot(
+  Environment *theEnv,
+  void *context)
+  {
+   struct resetSnapshotData *theData = ResetSnapshotData(theEnv);
+
+   if (theData->SnapshotRestored)
+     {
+      theData->SnapshotRestored = false;
+      return;
+     }
+
+   if ((! theData->SnapshotEnabled) || (theData->Snapshot != NULL))
+     { return; }
+
+   if (GetEvaluationError(theEnv) || (! SnapshotAllowed(theEnv)))
+     { return; }
+
+   theData->Snapshot = CreateSnapshot(theEnv);
+  }
+
+/*******************************************************/
+/* SnapshotAllowed: Determines if the state of the     */
+/*   environment allows a snapshot to be captured or   */
+/*   restored. Facts can't be asserted by deffacts     */
+/*   without calling the assert functions or checking  */
+/*   constraints, so those can't be in use.            */
+/*******************************************************/
+static bool SnapshotAllowed(
+  Environment *theEnv)
+  {
+   struct voidCallFunctionItem *theItem;
+
+   if ((EngineData(theEnv)->ExecutingRule != NULL) ||
+       EngineData(theEnv)->JoinOperationInProgress)
+     { return false; }
+
+   if (FactData(theEnv)->ListOfAssertFunctions != NULL)
+     { return false; }
+
+   if (GetDynamicConstraintChecking(theEnv))
+     { return false; }
+
+#if OBJECT_SYSTEM
+   if (GetNextInstance(theEnv,NULL) != NULL)
+     { return false; }
+#endif
+
+   /*=====================================================*/
+   /* A reset function added by a user which runs after   */
+   /* the snapshot is restored would be applied a second  */
+   /* time to the state restored from the snapshot (for   */
+   /* example, asserting its facts again).                */
+   /*=====================================================*/
+
+   for (theItem = ConstructData(theEnv)->ListOfResetFunctions;
+        theItem != NULL;
+        theItem = theItem->next)
+     {
+      if ((theItem->priority <= 11) && (! KnownResetFunction(theItem)))
+        { return false; }
+     }
+
+   return true;
+  }
+
+/******************************************************/
+/* KnownResetFunction: Returns true if a reset        */
+/*   function is one of the reset functions which are */
+/*   allowed to run after a snapshot is restored.     */
+/******************************************************/
+static bool KnownResetFunction(
+  struct voidCallFunctionItem *theItem)
+  {
+   int i;
+
+   for (i = 0; SnapshotResetFunctions[i].name != NULL; i++)
+     {
+      if ((strcmp(theItem->name,SnapshotResetFunctions[i].name) == 0) &&
+          (theItem->priority == SnapshotResetFunctions[i].priority))
+        { return true; }
+     }
+
+   return false;
+  }
+
+/*******************************************************/
+/* SnapshotRestorable: Determines if a snapshot can be */
+/*   restored into the network. The reset must have    */
+/*   emptied working memory and the agenda, and none   */
+/*   of the settings which determine the outcome of a  */
+/*   reset can have changed since the capture. Facts   */
+/*   and activations which are being watched require   */
+/*   a full reset so that the trace is displayed.      */
+/*******************************************************/
+static bool SnapshotRestorable(
+  Environment *theEnv,
+  struct resetSnapshot *theSnapshot)
+  {
+   unsigned long i;
+   struct snapshotMemory *theMemory;
+
+   if ((FactData(theEnv)->FactList != NULL) ||
+       (AgendaData(theEnv)->NumberOfActivations != 0))
+     { return false; }
+
+   if ((theSnapshot->strategy != GetStrategy(theEnv)) ||
+       (theSnapshot->salienceEvaluation != GetSalienceEvaluation(theEnv)) ||
+       (theSnapshot->factDuplication != GetFactDuplication(theEnv)))
+     { return false; }
+
+#if DEBUGGING_FUNCTIONS
+   if (EngineData(theEnv)->WatchFocus ||
+       BinaryTraceData(theEnv)->TraceFacts ||
+       BinaryTraceData(theEnv)->TraceActivations)
+     { return false; }
+
+   for (i = 0; i < theSnapshot->factCount; i++)
+     {
+      if (theSnapshot->facts[i].theFact->whichDeftemplate->watch)
+        { return false; }
+     }
+
+   for (i = 0; i < theSnapshot->activationCount; i++)
+     {
+      if (theSnapshot->activations[i].theRule->watchActivation)
+        { return false; }
+     }
+#endif
+
+   /*=================================================*/
+   /* The alpha memories and the beta memories (other */
+   /* than those holding the partial matches used to  */
+   /* prime the network) must be empty.               */
+   /*=================================================*/
+
+   for (i = 0; i < theSnapshot->alphaMemoryCount; i++)
+     {
+      if (theSnapshot->alphaMemories[i].owner->firstHash != NULL)
+        { return false; }
+     }
+
+   for (i = 0; i < theSnapshot->memoryCount; i++)
+     {
+      theMemory = &theSnapshot->memories[i];
+      if (theMemory->theMemory->count != (theMemory->persistent ? 1UL : 0UL))
+        { return false; }
+     }
+
+   return true;
+  }
+
+/***********************************************************/
+/* CreateSnapshot: Captures the facts, alpha memories,     */
+/*   beta memories, and agenda. Returns NULL if the state  */
+/*   contains anything which can't be captured. The data   */
+/*   structures are counted in a first pass, numbered in a */
+/*   second pass, and copied with their pointers converted */
+/*   to ordinals in a third pass.                          */
+/***********************************************************/
+static struct resetSnapshot *CreateSnapshot(
+  Environment *theEnv)
+  {
+   struct resetSnapshot *theSnapshot;
+   struct snapshotAddressTable theTable;
+   struct joinNode **theJoins = NULL;
+   unsigned long joinCount, total, ordinal, i, j, b, m, p, a, f, alphaBase, matchBase, activationBase, bind;
+   void **theObjects;
+   Fact *theFact;
+   struct patternMatch *thePatternMatch;
+   struct alphaMemoryHash *theAlphaMemory;
+   PartialMatch *theMatch;
+   AlphaMatch *theAlphaMatch;
+   struct betaMemory *theMemory;
+   struct joinNode *theJoin;
+   struct snapshotMatch *theRecord;
+   struct snapshotAlphaMemory *theAlphaRecord;
+   Activation *theActivation;
+   Defmodule *theModule;
+   struct focus *theFocus;
+   bool failed = false;
+
+   /*=======================================*/
+   /* Find each join in the network once.   */
+   /*=======================================*/
+
+   joinCount = CollectJoins(theEnv,NULL);
+   if (joinCount > 0)
+     {
+      theJoins = (struct joinNode **) genalloc(theEnv,sizeof(struct joinNode *) * joinCount);
+      CollectJoins(theEnv,theJoins);
+     }
+
+   /*==================================================*/
+   /* The partial matches and activations can only be  */
+   /* reused if the network expressions and deffacts   */
+   /* will give the same results the next time the     */
+   /* network is reset.                                */
+   /*==================================================*/
+
+   if (NetworkUsesChangingValues(theEnv,theJoins,joinCount)
+#if DEFFACTS_CONSTRUCT
+       || DeffactsUseChangingValues(theEnv)
+#endif
+      )
+     {
+      if (theJoins != NULL)
+        { genfree(theEnv,theJoins,sizeof(struct joinNode *) * joinCount); }
+      return NULL;
+     }
+
+   /*=================================*/
+   /* Count the data structures which */
+   /* will be stored in the snapshot. */
+   /*=================================*/
+
+   theSnapshot = get_struct(theEnv,resetSnapshot);
+   memset(theSnapshot,0,sizeof(struct resetSnapshot));
+
+   if (! CountSnapshot(theEnv,theSnapshot,theJoins,joinCount))
+     {
+      if (theJoins != NULL)
+        { genfree(theEnv,theJoins,sizeof(struct joinNode *) * joinCount); }
+      rtn_struct(theEnv,resetSnapshot,theSnapshot);
+      return NULL;
+     }
+
+   theSnapshot->strategy = GetStrategy(theEnv);
+   theSnapshot->salienceEvaluation = GetSalienceEvaluation(theEnv);
+   theSnapshot->factDuplication = GetFactDuplication(theEnv);
+   theSnapshot->nextFactIndex = FactData(theEnv)->NextFactIndex;
+   theSnapshot->currentEntityTimeTag = DefruleData(theEnv)->CurrentEntityTimeTag;
+   theSnapshot->currentTimetag = AgendaData(theEnv)->CurrentTimetag;
+
+   if (theSnapshot->factCount > 0)
+     { theSnapshot->facts = (struct snapshotFact *) genalloc(theEnv,sizeof(struct snapshotFact) * theSnapshot->factCount); }
+   if (theSnapshot->patternMatchCount > 0)
+     { theSnapshot->patternMatches = (struct snapshotPatternMatch *) genalloc(theEnv,sizeof(struct snapshotPatternMatch) * theSnapshot->patternMatchCount); }
+   if (theSnapshot->alphaMemoryCount > 0)
+     { theSnapshot->alphaMemories = (struct snapshotAlphaMemory *) genalloc(theEnv,sizeof(struct snapshotAlphaMemory) * theSnapshot->alphaMemoryCount); }
+   if (theSnapshot->matchCount > 0)
+     {
+      theSnapshot->matches = (struct snapshotMatch *) genalloc(theEnv,sizeof(struct snapshotMatch) * theSnapshot->matchCount);
+      memset(theSnapshot->matches,0,sizeof(struct snapshotMatch) * theSnapshot->matchCount);
+     }
+   if (theSnapshot->bindCount > 0)
+     { theSnapshot->binds = (unsigned long *) genalloc(theEnv,sizeof(unsigned long) * theSnapshot->bindCount); }
+   if (theSnapshot->activationCount > 0)
+     { theSnapshot->activations = (struct snapshotActivation *) genalloc(theEnv,sizeof(struct snapshotActivation) * theSnapshot->activationCount); }
+   if (theSnapshot->memoryCount > 0)
+     { theSnapshot->memories = (struct snapshotMemory *) genalloc(theEnv,sizeof(struct snapshotMemory) * theSnapshot->memoryCount); }
+   if (theSnapshot->focusCount > 0)
+     { theSnapshot->focusStack = (Defmodule **) genalloc(theEnv,sizeof(Defmodule *) * theSnapshot->focusCount); }
+
+   /*==========================================*/
+   /* Number the data structures in the order  */
+   /* they're stored: facts, alpha memories,   */
+   /* partial matches, and then activations.   */
+   /*==========================================*/
+
+   alphaBase = theSnapshot->factCount;
+   matchBase = alphaBase + theSnapshot->alphaMemoryCount;
+   activationBase = matchBase + theSnapshot->matchCount;
+   total = activationBase + theSnapshot->activationCount;
+
+   theTable.size = 16;
+   while (theTable.size < (total * 2))
+     { theTable.size *= 2; }
+   theTable.entries = (struct snapshotAddress *) genalloc(theEnv,sizeof(struct snapshotAddress) * theTable.size);
+   memset(theTable.entries,0,sizeof(struct snapshotAddress) * theTable.size);
+
+   theObjects = (void **) genalloc(theEnv,sizeof(void *) * (total + 1));
+
+   ordinal = 0;
+   for (theFact = FactData(theEnv)->FactList;
+        theFact != NULL;
+        theFact = theFact->nextFact)
+     { theObjects[ordinal++] = theFact; }
+
+   for (i = 0; i < ALPHA_MEMORY_HASH_SIZE; i++)
+     {
+      for (theAlphaMemory = DefruleData(theEnv)->AlphaMemoryTable[i];
+           theAlphaMemory != NULL;
+           theAlphaMemory = theAlphaMemory->next)
+        { theObjects[ordinal++] = theAlphaMemory; }
+     }
+
+   for (i = alphaBase; i < matchBase; i++)
+     {
+      theAlphaMemory = (struct alphaMemoryHash *) theObjects[i];
+      for (theMatch = theAlphaMemory->alphaMemory;
+           theMatch != NULL;
+           theMatch = theMatch->nextInMemory)
+        { theObjects[ordinal++] = theMatch; }
+     }
+
+   /*=================================================*/
+   /* The first join of a rule has a left memory only */
+   /* if it holds an empty partial match that primes  */
+   /* the network, and a join which isn't entered     */
+   /* from the right has a right memory only if it    */
+   /* holds an empty partial match for a join which   */
+   /* has no patterns. These partial matches persist  */
+   /* across resets, so they're reused when restored. */
+   /*=================================================*/
+
+   m = 0;
+   for (j = 0; j < joinCount; j++)
+     {
+      theJoin = theJoins[j];
+      for (p = 0; p < 2; p++)
+        {
+         theMemory = (p == 0) ? theJoin->leftMemory : theJoin->rightMemory;
+         if (theMemory == NULL) continue;
+
+         theSnapshot->memories[m].theMemory = theMemory;
+         theSnapshot->memories[m].size = theMemory->size;
+         theSnapshot->memories[m].count = theMemory->count;
+         theSnapshot->memories[m].persistent = (p == 0) ? theJoin->firstJoin :
+                                               (theJoin->rightSideEntryStructure == NULL);
+
+         for (b = 0; b < theMemory->size; b++)
+           {
+            for (theMatch = theMemory->beta[b];
+                 theMatch != NULL;
+                 theMatch = theMatch->nextInMemory)
+              {
+               if (theSnapshot->memories[m].persistent)
+                 { theSnapshot->matches[ordinal - matchBase].persistent = theMatch; }
+               theObjects[ordinal++] = theMatch;
+              }
+           }
+         m++;
+        }
+     }
+
+   for (theModule = GetNextDefmodule(theEnv,NULL);
+        theModule != NULL;
+        theModule = GetNextDefmodule(theEnv,theModule))
+     {
+      for (theActivation = GetDefruleModuleItem(theEnv,theModule)->agenda;
+           theActivation != NULL;
+           theActivation = theActivation->next)
+        { theObjects[ordinal++] = theActivation; }
+     }
+
+   for (i = 0; i < total; i++)
+     { AddSnapshotAddress(&theTable,theObjects[i],i + 1); }
+
+   /*================================================*/
+   /* Convert the pointers in the alpha memories,    */
+   /* partial matches, and activations to ordinals.  */
+   /*================================================*/
+
+   for (i = alphaBase, a = 0; i < matchBase; i++, a++)
+     {
+      theAlphaMemory = (struct alphaMemoryHash *) theObjects[i];
+      theAlphaRecord = &theSnapshot->alphaMemories[a];
+
+      theAlphaRecord->bucket = theAlphaMemory->bucket;
+      theAlphaRecord->owner = theAlphaMemory->owner;
+      theAlphaRecord->alphaMemory = SnapshotOrdinal(&theTable,theAlphaMemory->alphaMemory,&failed);
+      theAlphaRecord->endOfQueue = SnapshotOrdinal(&theTable,theAlphaMemory->endOfQueue,&failed);
+      theAlphaRecord->nextHash = SnapshotOrdinal(&theTable,theAlphaMemory->nextHash,&failed);
+      theAlphaRecord->prevHash = SnapshotOrdinal(&theTable,theAlphaMemory->prevHash,&failed);
+      theAlphaRecord->next = SnapshotOrdinal(&theTable,theAlphaMemory->next,&failed);
+      theAlphaRecord->prev = SnapshotOrdinal(&theTable,theAlphaMemory->prev,&failed);
+     }
+
+   for (i = matchBase, m = 0, bind = 0; i < activationBase; i++, m++)
+     {
+      theMatch = (PartialMatch *) theObjects[i];
+      theRecord = &theSnapshot->matches[m];
+
+      theRecord->betaMemory = theMatch->betaMemory;
+      theRecord->busy = theMatch->busy;
+      theRecord->rhsMemory = theMatch->rhsMemory;
+      theRecord->bcount = theMatch->bcount;
+      theRecord->hashValue = theMatch->hashValue;
+      theRecord->owner = theMatch->owner;
+      theRecord->marker = SnapshotOrdinal(&theTable,theMatch->marker,&failed);
+      theRecord->nextInMemory = SnapshotOrdinal(&theTable,theMatch->nextInMemory,&failed);
+      theRecord->prevInMemory = SnapshotOrdinal(&theTable,theMatch->prevInMemory,&failed);
+      theRecord->children = SnapshotOrdinal(&theTable,theMatch->children,&failed);
+      theRecord->rightParent = SnapshotOrdinal(&theTable,theMatch->rightParent,&failed);
+      theRecord->nextRightChild = SnapshotOrdinal(&theTable,theMatch->nextRightChild,&failed);
+      theRecord->prevRightChild = SnapshotOrdinal(&theTable,theMatch->prevRightChild,&failed);
+      theRecord->leftParent = SnapshotOrdinal(&theTable,theMatch->leftParent,&failed);
+      theRecord->nextLeftChild = SnapshotOrdinal(&theTable,theMatch->nextLeftChild,&failed);
+      theRecord->prevLeftChild = SnapshotOrdinal(&theTable,theMatch->prevLeftChild,&failed);
+      theRecord->blockList = SnapshotOrdinal(&theTable,theMatch->blockList,&failed);
+      theRecord->nextBlocked = SnapshotOrdinal(&theTable,theMatch->nextBlocked,&failed);
+      theRecord->prevBlocked = SnapshotOrdinal(&theTable,theMatch->prevBlocked,&failed);
+
+      /*===================================================*/
+      /* The alpha match of an alpha memory partial match  */
+      /* is allocated in the same block, so the bindings   */
+      /* of a beta memory partial match are stored as the  */
+      /* ordinals of the alpha memory partial matches.     */
+      /*===================================================*/
+
+      if (theMatch->betaMemory == false)
+        {
+         theAlphaMatch = theMatch->binds[0].gm.theMatch;
+         theRecord->matchingItem = SnapshotOrdinal(&theTable,theAlphaMatch->matchingItem,&failed);
+         theRecord->alphaBucket = theAlphaMatch->bucket;
+        }
+      else
+        {
+         theRecord->firstBind = bind;
+         for (b = 0; b < theMatch->bcount; b++)
+           {
+            theAlphaMatch = theMatch->binds[b].gm.theMatch;
+            if (theAlphaMatch == NULL)
+              { theSnapshot->binds[bind++] = 0; }
+            else
+              {
+               theSnapshot->binds[bind++] =
+                  SnapshotOrdinal(&theTable,((char *) theAlphaMatch) - sizeof(struct partialMatch),&failed);
+              }
+           }
+        }
+     }
+
+   for (i = activationBase, a = 0; i < total; i++, a++)
+     {
+      theActivation = (Activation *) theObjects[i];
+      theSnapshot->activations[a].theRule = theActivation->theRule;
+      theSnapshot->activations[a].basis = SnapshotOrdinal(&theTable,theActivation->basis,&failed);
+      theSnapshot->activations[a].salience = theActivation->salience;
+      theSnapshot->activations[a].timetag = theActivation->timetag;
+      theSnapshot->activations[a].randomID = theActivation->randomID;
+     }
+
+   /*====================================================*/
+   /* Every pointer should refer to a structure found in */
+   /* the network. If not, the state can't be captured.  */
+   /*====================================================*/
+
+   if (failed)
+     {
+      theSnapshot->factCount = 0;
+      theSnapshot->matchCount = 0;
+     }
+   else
+     {
+      /*=============================================*/
+      /* Copy the facts and the multifield markers.  */
+      /* The copies hold the atomic values of the    */
+      /* facts until the snapshot is discarded.      */
+      /*=============================================*/
+
+      for (f = 0, p = 0; f < theSnapshot->factCount; f++)
+        {
+         theFact = (Fact *) theObjects[f];
+         theSnapshot->facts[f].theFact = CopySnapshotFact(theEnv,theFact);
+         theSnapshot->facts[f].firstMatch = p;
+
+         for (thePatternMatch = (struct patternMatch *) theFact->list;
+              thePatternMatch != NULL;
+              thePatternMatch = thePatternMatch->next)
+           {
+            theSnapshot->patternMatches[p].theMatch = SnapshotOrdinal(&theTable,thePatternMatch->theMatch,&failed);
+            theSnapshot->patternMatches[p].matchingPattern = thePatternMatch->matchingPattern;
+            p++;
+           }
+
+         theSnapshot->facts[f].matchCount = p - theSnapshot->facts[f].firstMatch;
+        }
+
+      for (i = matchBase, m = 0; i < activationBase; i++, m++)
+        {
+         theMatch = (PartialMatch *) theObjects[i];
+         if (theMatch->betaMemory == false)
+           { theSnapshot->matches[m].markers = CopySnapshotMarkers(theEnv,theMatch->binds[0].gm.theMatch->markers); }
+        }
+
+      for (theFocus = EngineData(theEnv)->CurrentFocus, i = 0;
+           theFocus != NULL;
+           theFocus = theFocus->next, i++)
+        { theSnapshot->focusStack[i] = theFocus->theModule; }
+     }
+
+   genfree(theEnv,theObjects,sizeof(void *) * (total + 1));
+   genfree(theEnv,theTable.entries,sizeof(struct snapshotAddress) * theTable.size);
+   if (theJoins != NULL)
+     { genfree(theEnv,theJoins,sizeof(struct joinNode *) * joinCount); }
+
+   if (failed)
+     {
+      ReturnSnapshot(theEnv,theSnapshot,true);
+      return NULL;
+     }
+
+   return theSnapshot;
+  }
+
+/**********************************************************/
+/* CountSnapshot: Counts the data structures which will   */
+/*   be stored in a snapshot. Returns false if the facts, */
+/*   partial matches, or activations can't be captured.   */
+/**********************************************************/
+static bool CountSnapshot(
+  Environment *theEnv,
+  struct resetSnapshot *theSnapshot,
+  struct joinNode **theJoins,
+  unsigned long joinCount)
+  {
+   Fact *theFact;
+   struct patternMatch *thePatternMatch;
+   struct alphaMemoryHash *theAlphaMemory;
+   PartialMatch *theMatch;
+   struct betaMemory *theMemory;
+   Activation *theActivation;
+   Defmodule *theModule;
+   struct focus *theFocus;
+   unsigned long i, j, b;
+   int p;
+
+   for (theFact = FactData(theEnv)->FactList;
+        theFact != NULL;
+        theFact = theFact->nextFact)
+     {
+      if (! CapturableFact(theFact))
+        { return false; }
+
+      theSnapshot->factCount++;
+      for (thePatternMatch = (struct patternMatch *) theFact->list;
+           thePatternMatch != NULL;
+           thePatternMatch = thePatternMatch->next)
+        { theSnapshot->patternMatchCount++; }
+     }
+
+   for (i = 0; i < ALPHA_MEMORY_HASH_SIZE; i++)
+     {
+      for (theAlphaMemory = DefruleData(theEnv)->AlphaMemoryTable[i];
+           theAlphaMemory != NULL;
+           theAlphaMemory = theAlphaMemory->next)
+        {
+         theSnapshot->alphaMemoryCount++;
+         for (theMatch = theAlphaMemory->alphaMemory;
+              theMatch != NULL;
+              theMatch = theMatch->nextInMemory)
+           {
+            if (theMatch->dependents != NULL)
+              { return false; }
+            theSnapshot->matchCount++;
+           }
+        }
+     }
+
+   for (j = 0; j < joinCount; j++)
+     {
+      for (p = 0; p < 2; p++)
+        {
+         theMemory = (p == 0) ? theJoins[j]->leftMemory : theJoins[j]->rightMemory;
+         if (theMemory == NULL) continue;
+
+         theSnapshot->memoryCount++;
+         for (b = 0; b < theMemory->size; b++)
+           {
+            for (theMatch = theMemory->beta[b];
+                 theMatch != NULL;
+                 theMatch = theMatch->nextInMemory)
+              {
+               if (theMatch->dependents != NULL)
+                 { return false; }
+               theSnapshot->matchCount++;
+               theSnapshot->bindCount += theMatch->bcount;
+              }
+           }
+        }
+     }
+
+   /*=================================================*/
+   /* Saliences evaluated when the activations were   */
+   /* created can't be reused by a later reset.       */
+   /*=================================================*/
+
+   for (theModule = GetNextDefmodule(theEnv,NULL);
+        theModule != NULL;
+        theModule = GetNextDefmodule(theEnv,theModule))
+     {
+      for (theActivation = GetDefruleModuleItem(theEnv,theModule)->agenda;
+           theActivation != NULL;
+           theActivation = theActivation->next)
+        {
+         if ((theActivation->theRule->dynamicSalience != NULL) &&
+             (GetSalienceEvaluation(theEnv) != WHEN_DEFINED))
+           { return false; }
+         theSnapshot->activationCount++;
+        }
+     }
+
+   for (theFocus = EngineData(theEnv)->CurrentFocus;
+        theFocus != NULL;
+        theFocus = theFocus->next)
+     { theSnapshot->focusCount++; }
+
+   return true;
+  }
+
+/*******************************************************/
+/* CapturableFact: Determines if a fact can be stored  */
+/*   in a snapshot. Facts with logical support and     */
+/*   facts containing addresses of other facts, of     */
+/*   instances, or of external data can't be captured. */
+/*******************************************************/
+static bool CapturableFact(
+  Fact *theFact)
+  {
+   long i, j;
+   Multifield *theSegment;
+
+   if ((theFact->patternHeader.dependents != NULL) ||
+       (theFact->basisSlots != NULL))
+     { return false; }
+
+   for (i = 0; i < theFact->theProposition.length; i++)
+     {
+      if (theFact->theProposition.contents[i].header->type == MULTIFIELD_TYPE)
+        {
+         theSegment = theFact->theProposition.contents[i].multifieldValue;
+         for (j = 0; j < theSegment->length; j++)
+           {
+            if (! CapturableValue(&theSegment->contents[j]))
+              { return false; }
+           }
+        }
+      else if (! CapturableValue(&theFact->theProposition.contents[i]))
+        { return false; }
+     }
+
+   return true;
+  }
+
+/*******************************************/
+/* CapturableValue: Determines if a single */
+/*   field value can be stored in a copy.  */
+/*******************************************/
+static bool CapturableValue(
+  CLIPSValue *theValue)
+  {
+   switch (theValue->header->type)
+     {
+      case FACT_ADDRESS_TYPE:
+      case INSTANCE_ADDRESS_TYPE:
+      case EXTERNAL_ADDRESS_TYPE:
+        return false;
+     }
+
+   return true;
+  }
+
+/*******************************************************/
+/* CollectJoins: Stores each join of the network once  */
+/*   in the specified array (if not NULL) and returns  */
+/*   the number of joins. Joins shared between rules   */
+/*   are found once using the join marked flags.       */
+/*******************************************************/
+static unsigned long CollectJoins(
+  Environment *theEnv,
+  struct joinNode **theJoins)
+  {
+   Defmodule *theModule;
+   Defrule *theRule, *theDisjunct;
+   unsigned long count = 0;
+
+   MarkRuleNetwork(theEnv,0);
+
+   SaveCurrentModule(theEnv);
+   for (theModule = GetNextDefmodule(theEnv,NULL);
+        theModule != NULL;
+        theModule = GetNextDefmodule(theEnv,theModule))
+     {
+      SetCurrentModule(theEnv,theModule);
+      for (theRule = GetNextDefrule(theEnv,NULL);
+           theRule != NULL;
+           theRule = GetNextDefrule(theEnv,theRule))
+        {
+         for (theDisjunct = theRule;
+              theDisjunct != NULL;
+              theDisjunct = theDisjunct->disjunct)
+           { CollectRuleJoins(theDisjunct->lastJoin,theJoins,&count); }
+        }
+     }
+   RestoreCurrentModule(theEnv);
+
+   MarkRuleNetwork(theEnv,0);
+
+   return count;
+  }
+
+/*****************************************************/
+/* CollectRuleJoins: Stores the unmarked joins which */
+/*   lead to a join, including the joins entering it */
+/*   from the right, and marks them.                 */
+/*****************************************************/
+static void CollectRuleJoins(
+  struct joinNode *theJoin,
+  struct joinNode **theJoins,
+  unsigned long *count)
+  {
+   while ((theJoin != NULL) && (! theJoin->marked))
+     {
+      if (theJoin->joinFromTheRight)
+        { CollectRuleJoins((struct joinNode *) theJoin->rightSideEntryStructure,theJoins,count); }
+
+      theJoin->marked = true;
+      if (theJoins != NULL)
+        { theJoins[*count] = theJoin; }
+      (*count)++;
+
+      theJoin = theJoin->lastLevel;
+     }
+  }
+
+/*************************************************************/
+/* NetworkUsesChangingValues: Returns true if an expression  */
+/*   in the join network or the fact pattern network, or a   */
+/*   salience which is evaluated when a rule is activated,   */
+/*   uses a value which can change between resets.           */
+/*************************************************************/
+static bool NetworkUsesChangingValues(
+  Environment *theEnv,
+  struct joinNode **theJoins,
+  unsigned long joinCount)
+  {
+   unsigned long i;
+   struct joinNode *theJoin;
+   Defmodule *theModule;
+   Deftemplate *theDeftemplate;
+   Defrule *theRule;
+   bool rv = false;
+
+   for (i = 0; i < joinCount; i++)
+     {
+      theJoin = theJoins[i];
+      if (ExpressionUsesChangingValues(theJoin->networkTest) ||
+          ExpressionUsesChangingValues(theJoin->secondaryNetworkTest) ||
+          ExpressionUsesChangingValues(theJoin->leftHash) ||
+          ExpressionUsesChangingValues(theJoin->rightHash))
+        { return true; }
+     }
+
+   SaveCurrentModule(theEnv);
+   for (theModule = GetNextDefmodule(theEnv,NULL);
+        (theModule != NULL) && (! rv);
+        theModule = GetNextDefmodule(theEnv,theModule))
+     {
+      SetCurrentModule(theEnv,theModule);
+
+      for (theDeftemplate = GetNextDeftemplate(theEnv,NULL);
+           (theDeftemplate != NULL) && (! rv);
+           theDeftemplate = GetNextDeftemplate(theEnv,theDeftemplate))
+        { rv = FactNetworkUsesChangingValues(theDeftemplate->patternNetwork); }
+
+      if (GetSalienceEvaluation(theEnv) == WHEN_DEFINED)
+        { continue; }
+
+      for (theRule = GetNextDefrule(theEnv,NULL);
+           (theRule != NULL) && (! rv);
+           theRule = GetNextDefrule(theEnv,theRule))
+        { rv = ExpressionUsesChangingValues(theRule->dynamicSalience); }
+     }
+   RestoreCurrentModule(theEnv);
+
+   return rv;
+  }
+
+/**************************************************************/
+/* FactNetworkUsesChangingValues: Returns true if a test in a */
+/*   fact pattern network uses a value which can change.      */
+/**************************************************************/
+static bool FactNetworkUsesChangingValues(
+  struct factPatternNode *thePattern)
+  {
+   for (;
+        thePattern != NULL;
+        thePattern = thePattern->rightNode)
+     {
+      if (ExpressionUsesChangingValues(thePattern->networkTest) ||
+          ExpressionUsesChangingValues(thePattern->header.rightHash) ||
+          FactNetworkUsesChangingValues(thePattern->nextLevel))
+        { return true; }
+     }
+
+   return false;
+  }
+
+/***********************************************************/
+/* ExpressionUsesChangingValues: Returns true if an        */
+/*   expression references a defglobal or calls a          */
+/*   deffunction or generic function, any of which can     */
+/*   return a different value each time the network is     */
+/*   reset (for example, after a bind or a redefinition).  */
+/***********************************************************/
+static bool ExpressionUsesChangingValues(
+  struct expr *theExp)
+  {
+   for (;
+        theExp != NULL;
+        theExp = theExp->nextArg)
+     {
+      switch (theExp->type)
+        {
+         case GBL_VARIABLE:
+         case MF_GBL_VARIABLE:
+         case DEFGLOBAL_PTR:
+         case PCALL:
+         case GCALL:
+           return true;
+
+         default:
+           break;
+        }
+
+      if (ExpressionUsesChangingValues(theExp->argList))
+        { return true; }
+     }
+
+   return false;
+  }
+
+#if DEFFACTS_CONSTRUCT
+
+/************************************************************/
+/* DeffactsUseChangingValues: Returns true if a deffacts    */
+/*   asserts a value which can change between resets. Slot  */
+/*   values supplied by a default-dynamic attribute are     */
+/*   copied into the deffacts when it is parsed, so they    */
+/*   are checked along with the values given explicitly.    */
+/************************************************************/
+static bool DeffactsUseChangingValues(
+  Environment *theEnv)
+  {
+   Defmodule *theModule;
+   Deffacts *theDeffacts;
+   void *assertFunction, *prognFunction;
+   bool rv = false;
+
+   assertFunction = FindFunction(theEnv,"assert");
+   prognFunction = FindFunction(theEnv,"progn");
+
+   SaveCurrentModule(theEnv);
+   for (theModule = GetNextDefmodule(theEnv,NULL);
+        (theModule != NULL) && (! rv);
+        theModule = GetNextDefmodule(theEnv,theModule))
+     {
+      SetCurrentModule(theEnv,theModule);
+
+      for (theDeffacts = GetNextDeffacts(theEnv,NULL);
+           (theDeffacts != NULL) && (! rv);
+           theDeffacts = GetNextDeffacts(theEnv,theDeffacts))
+        { rv = AssertListUsesChangingValues(theDeffacts->assertList,assertFunction,prognFunction); }
+     }
+   RestoreCurrentModule(theEnv);
+
+   return rv;
+  }
+
+/**************************************************************/
+/* AssertListUsesChangingValues: Returns true if the asserts  */
+/*   of a deffacts reference a defglobal or call any function */
+/*   other than the assert and progn calls which hold them.   */
+/*   Any function call is treated as changing since it may    */
+/*   have side effects or return a new value (for example,    */
+/*   gensym or random).                                       */
+/**************************************************************/
+static bool AssertListUsesChangingValues(
+  struct expr *theExp,
+  void *assertFunction,
+  void *prognFunction)
+  {
+   for (;
+        theExp != NULL;
+        theExp = theExp->nextArg)
+     {
+      switch (theExp->type)
+        {
+         case FCALL:
+           if ((theExp->value != assertFunction) &&
+               (theExp->value != prognFunction))
+             { return true; }
+           break;
+
+         case GBL_VARIABLE:
+         case MF_GBL_VARIABLE:
+         case DEFGLOBAL_PTR:
+         case PCALL:
+         case GCALL:
+           return true;
+
+         default:
+           break;
+        }
+
+      if (AssertListUsesChangingValues(theExp->argList,assertFunction,prognFunction))
+        { return true; }
+     }
+
+   return false;
+  }
+
+#endif
+
+/****************************************************/
+/* AddSnapshotAddress: Adds a data structure to the */
+/*   address table using linear probing.            */
+/****************************************************/
+static void AddSnapshotAddress(
+  struct snapshotAddressTable *theTable,
+  void *theAddress,
+  unsigned long ordinal)
+  {
+   unsigned long bucket;
+
+   bucket = (((unsigned long) theAddress) >> 3) & (theTable->size - 1);
+   while (theTable->entries[bucket].address != NULL)
+     { bucket = (bucket + 1) & (theTable->size - 1); }
+
+   theTable->entries[bucket].address = theAddress;
+   theTable->entries[bucket].ordinal = ordinal;
+  }
+
+/*******************************************************/
+/* SnapshotOrdinal: Returns the ordinal of a data      */
+/*   structure in the address table, or zero for NULL. */
+/*   The failed flag is set if it isn't in the table.  */
+/*******************************************************/
+static unsigned long SnapshotOrdinal(
+  struct snapshotAddressTable *theTable,
+  void *theAddress,
+  bool *failed)
+  {
+   unsigned long bucket;
+
+   if (theAddress == NULL) return 0;
+
+   bucket = (((unsigned long) theAddress) >> 3) & (theTable->size - 1);
+   while (theTable->entries[bucket].address != NULL)
+     {
+      if (theTable->entries[bucket].address == theAddress)
+        { return theTable->entries[bucket].ordinal; }
+      bucket = (bucket + 1) & (theTable->size - 1);
+     }
+
+   *failed = true;
+   return 0;
+  }
+
+/******************************************************/
+/* CopySnapshotFact: Copies the deftemplate, values,  */
+/*   index, time tag, and hash value of a fact. The   */
+/*   copy isn't placed in the fact-list, but installs */
+/*   its values like an asserted fact.                */
+/******************************************************/
+static Fact *CopySnapshotFact(
+  Environment *theEnv,
+  Fact *theFact)
+  {
+   Fact *theCopy;
+   long i;
+   CLIPSValue *theValue;
+
+   theCopy = CreateFactBySize(theEnv,(unsigned) theFact->theProposition.length);
+   theCopy->whichDeftemplate = theFact->whichDeftemplate;
+   theCopy->factIndex = theFact->factIndex;
+   theCopy->patternHeader.timeTag = theFact->patternHeader.timeTag;
+   theCopy->hashValue = theFact->hashValue;
+
+   for (i = 0; i < theFact->theProposition.length; i++)
+     {
+      theValue = &theCopy->theProposition.contents[i];
+      if (theFact->theProposition.contents[i].header->type == MULTIFIELD_TYPE)
+        { theValue->value = CopyMultifield(theEnv,theFact->theProposition.contents[i].multifieldValue); }
+      else
+        { theValue->value = theFact->theProposition.contents[i].value; }
+
+      AtomInstall(theEnv,theValue->header->type,theValue->value);
+     }
+
+   return theCopy;
+  }
+
+/****************************************************/
+/* CopySnapshotMarkers: Copies a list of multifield */
+/*   markers preserving their order.                */
+/****************************************************/
+static MultifieldMarker *CopySnapshotMarkers(
+  Environment *theEnv,
+  MultifieldMarker *theMarkers)
+  {
+   if (theMarkers == NULL) return NULL;
+
+   return CopyMultifieldMarkers(theEnv,theMarkers);
+  }
+
+/****************************************************/
+/* ReturnSnapshotMarkers: Returns a list of markers */
+/*   to the pool of free memory.                    */
+/****************************************************/
+static void ReturnSnapshotMarkers(
+  Environment *theEnv,
+  MultifieldMarker *theMarkers)
+  {
+   MultifieldMarker *nextMarker;
+
+   while (theMarkers != NULL)
+     {
+      nextMarker = theMarkers->next;
+      rtn_struct(theEnv,multifieldMarker,theMarkers);
+      theMarkers = nextMarker;
+     }
+  }
+
+/*******************************************************/
+/* ReturnSnapshot: Returns a snapshot to the pool of   */
+/*   free memory. The constructs, joins, and pattern   */
+/*   nodes referenced by the snapshot may have already */
+/*   been deleted, so they are never accessed.         */
+/*******************************************************/
+static void ReturnSnapshot(
+  Environment *theEnv,
+  struct resetSnapshot *theSnapshot,
+  bool deinstall)
+  {
+   unsigned long i;
+   long v;
+   Fact *theFact;
+
+   for (i = 0; i < theSnapshot->factCount; i++)
+     {
+      theFact = theSnapshot->facts[i].theFact;
+      if (deinstall)
+        {
+         for (v = 0; v < theFact->theProposition.length; v++)
+           {
+            AtomDeinstall(theEnv,theFact->theProposition.contents[v].header->type,
+                          theFact->theProposition.contents[v].value);
+           }
+        }
+      ReturnFact(theEnv,theFact);
+     }
+
+   for (i = 0; i < theSnapshot->matchCount; i++)
+     { ReturnSnapshotMarkers(theEnv,theSnapshot->matches[i].markers); }
+
+   if (theSnapshot->facts != NULL)
+     { genfree(theEnv,theSnapshot->facts,sizeof(struct snapshotFact) * theSnapshot->factCount); }
+   if (theSnapshot->patternMatches != NULL)
+     { genfree(theEnv,theSnapshot->patternMatches,sizeof(struct snapshotPatternMatch) * theSnapshot->patternMatchCount); }
+   if (theSnapshot->alphaMemories != NULL)
+     { genfree(theEnv,theSnapshot->alphaMemories,sizeof(struct snapshotAlphaMemory) * theSnapshot->alphaMemoryCount); }
+   if (theSnapshot->matches != NULL)
+     { genfree(theEnv,theSnapshot->matches,sizeof(struct snapshotMatch) * theSnapshot->matchCount); }
+   if (theSnapshot->binds != NULL)
+     { genfree(theEnv,theSnapshot->binds,sizeof(unsigned long) * theSnapshot->bindCount); }
+   if (theSnapshot->activations != NULL)
+     { genfree(theEnv,theSnapshot->activations,sizeof(struct snapshotActivation) * theSnapshot->activationCount); }
+   if (theSnapshot->memories != NULL)
+     { genfree(theEnv,theSnapshot->memories,sizeof(struct snapshotMemory) * theSnapshot->memoryCount); }
+   if (theSnapshot->focusStack != NULL)
+     { genfree(theEnv,theSnapshot->focusStack,sizeof(Defmodule *) * theSnapshot->focusCount); }
+
+   rtn_struct(theEnv,resetSnapshot,theSnapshot);
+  }
+
+/**********************************************************/
+/* RestoreSnapshot: Recreates the captured facts, alpha   */
+/*   memories, partial matches, and activations and links */
+/*   them into working memory, the network, and the       */
+/*   agenda in the order they were captured.              */
+/**********************************************************/
+static void RestoreSnapshot(
+  Environment *theEnv,
+  struct resetSnapshot *theSnapshot)
+  {
+   void **theObjects;
+   unsigned long total, alphaBase, matchBase, activationBase, i, j, b, bucket;
+   long k;
+   struct snapshotFact *theFactRecord;
+   struct snapshotAlphaMemory *theAlphaRecord;
+   struct snapshotMatch *theRecord;
+   struct snapshotActivation *theActivationRecord;
+   Fact *theFact, *theCopy;
+   long v;
+   struct patternMatch *thePatternMatch;
+   struct alphaMemoryHash *theAlphaMemory;
+   PartialMatch *theMatch;
+   AlphaMatch *theAlphaMatch;
+   struct betaMemory *theMemory;
+   Activation *theActivation;
+   Deftemplate *theDeftemplate;
+
+   alphaBase = theSnapshot->factCount;
+   matchBase = alphaBase + theSnapshot->alphaMemoryCount;
+   activationBase = matchBase + theSnapshot->matchCount;
+   total = activationBase + theSnapshot->activationCount;
+
+   /*=====================================================*/
+   /* Allocate the data structures. The objects array is  */
+   /* indexed by ordinal, so position zero is for NULL.   */
+   /*=====================================================*/
+
+   theObjects = (void **) genalloc(theEnv,sizeof(void *) * (total + 1));
+   theObjects[0] = NULL;
+
+   for (i = 0; i < theSnapshot->factCount; i++)
+     {
+      theCopy = theSnapshot->facts[i].theFact;
+      theFact = CreateFactBySize(theEnv,(unsigned) theCopy->theProposition.length);
+      theFact->whichDeftemplate = theCopy->whichDeftemplate;
+      theFact->factIndex = theCopy->factIndex;
+      theFact->patternHeader.timeTag = theCopy->patternHeader.timeTag;
+      theFact->hashValue = theCopy->hashValue;
+
+      for (v = 0; v < theCopy->theProposition.length; v++)
+        {
+         if (theCopy->theProposition.contents[v].header->type == MULTIFIELD_TYPE)
+           { theFact->theProposition.contents[v].value = CopyMultifield(theEnv,theCopy->theProposition.contents[v].multifieldValue); }
+         else
+           { theFact->theProposition.contents[v].value = theCopy->theProposition.contents[v].value; }
+        }
+
+      theObjects[i + 1] = theFact;
+     }
+
+   for (i = alphaBase; i < matchBase; i++)
+     { theObjects[i + 1] = get_struct(theEnv,alphaMemoryHash); }
+
+   for (i = matchBase; i < activationBase; i++)
+     {
+      theRecord = &theSnapshot->matches[i - matchBase];
+      if (theRecord->persistent != NULL)
+        { theMatch = theRecord->persistent; }
+      else if (theRecord->betaMemory == false)
+        {
+         theMatch = get_var_struct(theEnv,partialMatch,sizeof(struct alphaMatch));
+         UpdateSubsystemMemory(theEnv,ALPHA_MEMORY,(long) (sizeof(struct partialMatch) + sizeof(struct alphaMatch)));
+        }
+      else
+        {
+         theMatch = get_var_struct(theEnv,partialMatch,sizeof(struct genericMatch) * (theRecord->bcount - 1));
+         UpdateSubsystemMemory(theEnv,BETA_MEMORY,(long) (sizeof(struct partialMatch) +
+                                                          (sizeof(struct genericMatch) * (theRecord->bcount - 1))));
+        }
+      theObjects[i + 1] = theMatch;
+     }
+
+   for (i = activationBase; i < total; i++)
+     {
+      theObjects[i + 1] = get_struct(theEnv,activation);
+      UpdateSubsystemMemory(theEnv,AGENDA_MEMORY,(long) sizeof(struct activation));
+     }
+
+   /*===================================================*/
+   /* Add the facts to the fact-list, their deftemplate */
+   /* lists, and the fact hash table as if asserted.    */
+   /*===================================================*/
+
+   for (i = 0; i < theSnapshot->factCount; i++)
+     {
+      theFactRecord = &theSnapshot->facts[i];
+      theFact = (Fact *) theObjects[i + 1];
+      theDeftemplate = theFact->whichDeftemplate;
+
+      AddHashedFact(theEnv,theFact,theFact->hashValue);
+
+      theFact->previousFact = FactData(theEnv)->LastFact;
+      theFact->nextFact = NULL;
+      if (FactData(theEnv)->LastFact == NULL)
+        { FactData(theEnv)->FactList = theFact; }
+      else
+        { FactData(theEnv)->LastFact->nextFact = theFact; }
+      FactData(theEnv)->LastFact = theFact;
+
+      theFact->previousTemplateFact = theDeftemplate->lastFact;
+      theFact->nextTemplateFact = NULL;
+      if (theDeftemplate->lastFact == NULL)
+        { theDeftemplate->factList = theFact; }
+      else
+        { theDeftemplate->lastFact->nextTemplateFact = theFact; }
+      theDeftemplate->lastFact = theFact;
+
+      FactInstall(theEnv,theFact);
+      for (v = 0; v < theFact->theProposition.length; v++)
+        {
+         AtomInstall(theEnv,theFact->theProposition.contents[v].header->type,
+                     theFact->theProposition.contents[v].value);
+        }
+
+      for (k = (long) theFactRecord->matchCount - 1; k >= 0; k--)
+        {
+         thePatternMatch = get_struct(theEnv,patternMatch);
+         thePatternMatch->next = (struct patternMatch *) theFact->list;
+         thePatternMatch->theMatch = (PartialMatch *) theObjects[theSnapshot->patternMatches[theFactRecord->firstMatch + (unsigned long) k].theMatch];
+         thePatternMatch->matchingPattern = theSnapshot->patternMatches[theFactRecord->firstMatch + (unsigned long) k].matchingPattern;
+         theFact->list = thePatternMatch;
+        }
+     }
+
+   /*===============================*/
+   /* Link the alpha memories into  */
+   /* the alpha memory hash table.  */
+   /*===============================*/
+
+   for (i = alphaBase; i < matchBase; i++)
+     {
+      theAlphaRecord = &theSnapshot->alphaMemories[i - alphaBase];
+      theAlphaMemory = (struct alphaMemoryHash *) theObjects[i + 1];
+
+      theAlphaMemory->bucket = theAlphaRecord->bucket;
+      theAlphaMemory->owner = theAlphaRecord->owner;
+      theAlphaMemory->alphaMemory = (PartialMatch *) theObjects[theAlphaRecord->alphaMemory];
+      theAlphaMemory->endOfQueue = (PartialMatch *) theObjects[theAlphaRecord->endOfQueue];
+      theAlphaMemory->nextHash = (struct alphaMemoryHash *) theObjects[theAlphaRecord->nextHash];
+      theAlphaMemory->prevHash = (struct alphaMemoryHash *) theObjects[theAlphaRecord->prevHash];
+      theAlphaMemory->next = (struct alphaMemoryHash *) theObjects[theAlphaRecord->next];
+      theAlphaMemory->prev = (struct alphaMemoryHash *) theObjects[theAlphaRecord->prev];
+
+      if (theAlphaMemory->prev == NULL)
+        { DefruleData(theEnv)->AlphaMemoryTable[theAlphaMemory->bucket] = theAlphaMemory; }
+      if (theAlphaMemory->prevHash == NULL)
+        { theAlphaMemory->owner->firstHash = theAlphaMemory; }
+      if (theAlphaMemory->nextHash == NULL)
+        { theAlphaMemory->owner->lastHash = theAlphaMemory; }
+     }
+
+   /*==============================================*/
+   /* Restore the sizes and counts of the beta     */
+   /* memories before the partial matches are      */
+   /* placed in their buckets.                     */
+   /*==============================================*/
+
+   for (i = 0; i < theSnapshot->memoryCount; i++)
+     {
+      theMemory = theSnapshot->memories[i].theMemory;
+      if (theMemory->size != theSnapshot->memories[i].size)
+        { SetBetaMemorySize(theEnv,theMemory,theSnapshot->memories[i].size); }
+      theMemory->count = theSnapshot->memories[i].count;
+     }
+
+   /*=============================================*/
+   /* Restore the partial matches. The priming    */
+   /* partial matches are updated in place.       */
+   /*=============================================*/
+
+   for (i = matchBase; i < activationBase; i++)
+     {
+      theRecord = &theSnapshot->matches[i - matchBase];
+      theMatch = (PartialMatch *) theObjects[i + 1];
+
+      theMatch->betaMemory = theRecord->betaMemory;
+      theMatch->busy = theRecord->busy;
+      theMatch->rhsMemory = theRecord->rhsMemory;
+      theMatch->bcount = theRecord->bcount;
+      theMatch->hashValue = theRecord->hashValue;
+      theMatch->owner = theRecord->owner;
+      theMatch->marker = theObjects[theRecord->marker];
+      theMatch->dependents = NULL;
+      theMatch->nextInMemory = (PartialMatch *) theObjects[theRecord->nextInMemory];
+      theMatch->prevInMemory = (PartialMatch *) theObjects[theRecord->prevInMemory];
+      theMatch->children = (PartialMatch *) theObjects[theRecord->children];
+      theMatch->rightParent = (PartialMatch *) theObjects[theRecord->rightParent];
+      theMatch->nextRightChild = (PartialMatch *) theObjects[theRecord->nextRightChild];
+      theMatch->prevRightChild = (PartialMatch *) theObjects[theRecord->prevRightChild];
+      theMatch->leftParent = (PartialMatch *) theObjects[theRecord->leftParent];
+      theMatch->nextLeftChild = (PartialMatch *) theObjects[theRecord->nextLeftChild];
+      theMatch->prevLeftChild = (PartialMatch *) theObjects[theRecord->prevLeftChild];
+      theMatch->blockList = (PartialMatch *) theObjects[theRecord->blockList];
+      theMatch->nextBlocked = (PartialMatch *) theObjects[theRecord->nextBlocked];
+      theMatch->prevBlocked = (PartialMatch *) theObjects[theRecord->prevBlocked];
+
+      if (theRecord->betaMemory == false)
+        {
+         theAlphaMatch = (AlphaMatch *) (((char *) theMatch) + sizeof(struct partialMatch));
+         theAlphaMatch->matchingItem = (struct patternEntity *) theObjects[theRecord->matchingItem];
+         theAlphaMatch->markers = CopySnapshotMarkers(theEnv,theRecord->markers);
+         theAlphaMatch->next = NULL;
+         theAlphaMatch->bucket = theRecord->alphaBucket;
+         theMatch->binds[0].gm.theMatch = theAlphaMatch;
+         continue;
+        }
+
+      for (j = 0; j < theRecord->bcount; j++)
+        {
+         b = theSnapshot->binds[theRecord->firstBind + j];
+         if (b == 0)
+           { theMatch->binds[j].gm.theMatch = NULL; }
+         else
+           { theMatch->binds[j].gm.theMatch = (AlphaMatch *) (((char *) theObjects[b]) + sizeof(struct partialMatch)); }
+        }
+
+      if (theMatch->rhsMemory)
+        { theMemory = ((struct joinNode *) theMatch->owner)->rightMemory; }
+      else
+        { theMemory = ((struct joinNode *) theMatch->owner)->leftMemory; }
+
+      bucket = theMatch->hashValue % theMemory->size;
+      if (theMatch->prevInMemory == NULL)
+        { theMemory->beta[bucket] = theMatch; }
+      if ((theMemory->last != NULL) && (theMatch->nextInMemory == NULL))
+        { theMemory->last[bucket] = theMatch; }
+     }
+
+   /*=====================================*/
+   /* Restore the activations and focus.  */
+   /*=====================================*/
+
+   for (i = activationBase; i < total; i++)
+     {
+      theActivationRecord = &theSnapshot->activations[i - activationBase];
+      theActivation = (Activation *) theObjects[i + 1];
+
+      theActivation->theRule = theActivationRecord->theRule;
+      theActivation->basis = (PartialMatch *) theObjects[theActivationRecord->basis];
+      theActivation->salience = theActivationRecord->salience;
+      theActivation->timetag = theActivationRecord->timetag;
+      theActivation->randomID = theActivationRecord->randomID;
+
+      AppendActivation(theEnv,theActivation);
+     }
+
+   for (i = theSnapshot->focusCount; i > 0; i--)
+     { Focus(theSnapshot->focusStack[i - 1]); }
+
+   /*=================================================*/
+   /* Restore the counters to their values at the end */
+   /* of the captured reset.                          */
+   /*=================================================*/
+
+   FactData(theEnv)->NextFactIndex = theSnapshot->nextFactIndex;
+   FactData(theEnv)->ChangeToFactList = true;
+   DefruleData(theEnv)->CurrentEntityTimeTag = theSnapshot->currentEntityTimeTag;
+   AgendaData(theEnv)->CurrentTimetag = theSnapshot->currentTimetag;
+
+   genfree(theEnv,theObjects,sizeof(void *) * (total + 1));
+  }
+
+/*****************************************************/
+/* SetBetaMemorySize: Changes the number of buckets  */
+/*   of an empty beta memory.                        */
+/*****************************************************/
+static void SetBetaMemorySize(
+  Environment *theEnv,
+  struct betaMemory *theMemory,
+  unsigned long size)
+  {
+   genfree(theEnv,theMemory->beta,sizeof(struct partialMatch *) * theMemory->size);
+   theMemory->beta = (struct partialMatch **) genalloc(theEnv,sizeof(struct partialMatch *) * size);
+   memset(theMemory->beta,0,sizeof(struct partialMatch *) * size);
+
+   if (theMemory->last != NULL)
+     {
+      genfree(theEnv,theMemory->last,sizeof(struct partialMatch *) * theMemory->size);
+      theMemory->last = (struct partialMatch **) genalloc(theEnv,sizeof(struct partialMatch *) * size);
+      memset(theMemory->last,0,sizeof(struct partialMatch *) * size);
+     }
+
+   theMemory->size = size;
+  }
+
+#endif /* DEFRULE_CONSTRUCT && DEFTEMPLATE_CONSTRUCT */
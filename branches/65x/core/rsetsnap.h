@@ -0,0 +1,167 @@
+   /*******************************************************/
+   /*      "C" Language Integrated Production System      */
+   /*                                                     */
+   /*             CLIPS Version 6.50  11/01/16            */
+   /*                                                     */
+   /*              RESET SNAPSHOT HEADER FILE             */
+   /*******************************************************/
+
+/*************************************************************/
+/* Purpose: Captures the state of working memory, the        */
+/*   pattern and join networks, and the agenda at the end of */
+/*   a reset so that subsequent resets can restore the state */
+/*   without asserting the deffacts and matching them again. */
+/*                                                           */
+/* Principal Programmer(s):                                  */
+/*      Gary D. Riley                                        */
+/*                                                           */
+/* Contributing Programmer(s):                               */
+/*                                                           */
+/* Revision History:                                         */
+/*                                                           */
+/*      6.50: Added reset snapshots.                         */
+/*                                                           */
+/*************************************************************/
+
+#ifndef _H_rsetsnap
+
+#pragma once
+
+#define _H_rsetsnap
+
+#include "agenda.h"
+#include "crstrtgy.h"
+#include "factmngr.h"
+#include "match.h"
+#include "network.h"
+#include "ruledef.h"
+
+/*******************************************************/
+/* Pointers to the facts, alpha memories, partial      */
+/* matches, and activations of a snapshot are stored   */
+/* as ordinals. An ordinal of zero represents a NULL   */
+/* pointer, otherwise the ordinal is one more than the */
+/* position of the data structure in the snapshot with */
+/* the facts numbered first, followed by the alpha     */
+/* memories, the partial matches, and the activations. */
+/* Pointers to constructs, joins, and pattern nodes    */
+/* are stored directly since any change to these       */
+/* discards the snapshot.                              */
+/*******************************************************/
+
+struct snapshotFact
+  {
+   Fact *theFact;
+   unsigned long firstMatch;
+   unsigned long matchCount;
+  };
+
+struct snapshotPatternMatch
+  {
+   unsigned long theMatch;
+   struct patternNodeHeader *matchingPattern;
+  };
+
+struct snapshotAlphaMemory
+  {
+   unsigned long bucket;
+   struct patternNodeHeader *owner;
+   unsigned long alphaMemory;
+   unsigned long endOfQueue;
+   unsigned long nextHash;
+   unsigned long prevHash;
+   unsigned long next;
+   unsigned long prev;
+  };
+
+struct snapshotMatch
+  {
+   PartialMatch *persistent;
+   unsigned int betaMemory  :  1;
+   unsigned int busy        :  1;
+   unsigned int rhsMemory   :  1;
+   unsigned short bcount;
+   unsigned long hashValue;
+   void *owner;
+   unsigned long marker;
+   unsigned long nextInMemory;
+   unsigned long prevInMemory;
+   unsigned long children;
+   unsigned long rightParent;
+   unsigned long nextRightChild;
+   unsigned long prevRightChild;
+   unsigned long leftParent;
+   unsigned long nextLeftChild;
+   unsigned long prevLeftChild;
+   unsigned long blockList;
+   unsigned long nextBlocked;
+   unsigned long prevBlocked;
+   unsigned long firstBind;
+   unsigned long matchingItem;
+   unsigned long alphaBucket;
+   MultifieldMarker *markers;
+  };
+
+struct snapshotActivation
+  {
+   Defrule *theRule;
+   unsigned long basis;
+   int salience;
+   unsigned long long timetag;
+   int randomID;
+  };
+
+struct snapshotMemory
+  {
+   struct betaMemory *theMemory;
+   unsigned long size;
+   unsigned long count;
+   bool persistent;
+  };
+
+struct resetSnapshot
+  {
+   StrategyType strategy;
+   SalienceEvaluationType salienceEvaluation;
+   bool factDuplication;
+   long long nextFactIndex;
+   long long currentEntityTimeTag;
+   unsigned long long currentTimetag;
+   unsigned long factCount;
+   unsigned long patternMatchCount;
+   unsigned long alphaMemoryCount;
+   unsigned long matchCount;
+   unsigned long bindCount;
+   unsigned long activationCount;
+   unsigned long memoryCount;
+   unsigned long focusCount;
+   struct snapshotFact *facts;
+   struct snapshotPatternMatch *patternMatches;
+   struct snapshotAlphaMemory *alphaMemories;
+   struct snapshotMatch *matches;
+   unsigned long *binds;
+   struct snapshotActivation *activations;
+   struct snapshotMemory *memories;
+   Defmodule **focusStack;
+  };
+
+#define RESET_SNAPSHOT_DATA 51
+
+struct resetSnapshotData
+  {
+   bool SnapshotEnabled;
+   bool SnapshotRestored;
+   struct resetSnapshot *Snapshot;
+  };
+
+#define ResetSnapshotData(theEnv) ((struct resetSnapshotData *) GetEnvironmentData(theEnv,RESET_SNAPSHOT_DATA))
+
+   void                           InitializeResetSnapshot(Environment *);
+   bool                           GetResetSnapshot(Environment *);
+   bool                           SetResetSnapshot(Environment *,bool);
+   void                           DiscardResetSnapshot(Environment *);
+   bool                           ResetSnapshotRestored(Environment *);
+   void                           GetResetSnapshotCommand(Environment *,UDFContext *,UDFValue *);
+   void                           SetResetSnapshotCommand(Environment *,UDFContext *,UDFValue *);
+
+#endif /* _H_rsetsnap */
@@ -38,6 +38,10 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added support for cost-based join reordering.  */
+/*                                                           */
+/*            Added salience dependency fields.              */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -101,11 +105,13 @@ void DefruleBinarySetup(
                              BsaveStorage,BsaveBinaryItem,
                              BloadStorage,BloadBinaryItem,
                              ClearBload);
+   AddAfterBloadFunction(theEnv,"defrule",BuildDynamicSalienceRules,0,NULL);
 #endif
 #if BLOAD || BLOAD_ONLY
    AddBinaryItem(theEnv,"defrule",20,NULL,NULL,NULL,NULL,
                              BloadStorage,BloadBinaryItem,
                              ClearBload);
+   AddAfterBloadFunction(theEnv,"defrule",BuildDynamicSalienceRules,0,NULL);
 #endif
   }
 
@@ -140,6 +146,7 @@ static void DeallocateDefruleBloadData(
         {
          tmpActivation = theActivation->next;
 
+         UpdateSubsystemMemory(theEnv,AGENDA_MEMORY,- (long) sizeof(struct activation));
          rtn_struct(theEnv,activation,theActivation);
 
          theActivation = tmpActivation;
@@ -935,6 +942,11 @@ static void UpdateDefrule(
    DefruleBinaryData(theEnv)->DefruleArray[obji].complexity = br->complexity;
    DefruleBinaryData(theEnv)->DefruleArray[obji].autoFocus = br->autoFocus;
    DefruleBinaryData(theEnv)->DefruleArray[obji].executing = 0;
+   DefruleBinaryData(theEnv)->DefruleArray[obji].patternCount = 0;
+   DefruleBinaryData(theEnv)->DefruleArray[obji].patternOrder = NULL;
+   DefruleBinaryData(theEnv)->DefruleArray[obji].salienceDependency = SALIENCE_UNCLASSIFIED;
+   DefruleBinaryData(theEnv)->DefruleArray[obji].salienceTag = 0;
+   DefruleBinaryData(theEnv)->DefruleArray[obji].nextDynamicSalience = NULL;
    DefruleBinaryData(theEnv)->DefruleArray[obji].afterBreakpoint = 0;
 #if DEBUGGING_FUNCTIONS
    DefruleBinaryData(theEnv)->DefruleArray[obji].watchActivation = AgendaData(theEnv)->WatchActivations;
@@ -1118,6 +1130,8 @@ static void ClearBload(
 
    DefruleData(theEnv)->RightPrimeJoins = NULL;
    DefruleData(theEnv)->LeftPrimeJoins = NULL;
+   DefruleData(theEnv)->DynamicSalienceRules = NULL;
+   DefruleData(theEnv)->LastDynamicSalienceRule = NULL;
   }
 
 /*******************************************************/
@@ -55,6 +55,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: The network isn't primed when a reset restores */
+/*            a reset snapshot.                              */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -75,6 +78,10 @@
 #include "ruledef.h"
 #include "watch.h"
 
+#if DEFTEMPLATE_CONSTRUCT
+#include "rsetsnap.h"
+#endif
+
 #if BLOAD || BLOAD_ONLY || BLOAD_AND_BSAVE
 #include "rulebin.h"
 #endif
@@ -198,6 +205,10 @@ static void ResetDefrulesPrime(
    struct joinLink *theLink;
    struct partialMatch *notParent;
 
+#if DEFTEMPLATE_CONSTRUCT
+   if (ResetSnapshotRestored(theEnv)) return;
+#endif
+
    for (theLink = DefruleData(theEnv)->RightPrimeJoins;
         theLink != NULL;
         theLink = theLink->next)
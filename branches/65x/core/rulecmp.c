@@ -43,6 +43,8 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added support for cost-based join reordering.  */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -477,12 +479,18 @@ static void DefruleToCode(
 
    if (theDefrule->disjunct != NULL)
      {
-      fprintf(theFile,"&%s%d_%ld[%ld]}",ConstructPrefix(DefruleData(theEnv)->DefruleCodeItem),
+      fprintf(theFile,"&%s%d_%ld[%ld],",ConstructPrefix(DefruleData(theEnv)->DefruleCodeItem),
                      imageID,(theDefrule->disjunct->header.bsaveID / maxIndices) + 1,
                              theDefrule->disjunct->header.bsaveID % maxIndices);
      }
    else
-     { fprintf(theFile,"NULL}"); }
+     { fprintf(theFile,"NULL,"); }
+
+   /*===============*/
+   /* Pattern Order */
+   /*===============*/
+
+   fprintf(theFile,"0,NULL}");
   }
 
 /***************************************************/
@@ -69,6 +69,10 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added support for cost-based join reordering.  */
+/*                                                           */
+/*            Added rules-fired command.                     */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -124,6 +128,7 @@
    static const char             *BetaHeaderString(Environment *,struct joinInformation *,long,long);
    static const char             *ActivityHeaderString(Environment *,struct joinInformation *,long,long);
    static void                    JoinActivityReset(Environment *,ConstructHeader *,void *);
+   static void                    ListPatternOrder(Environment *,Defrule *);
 #endif
 
 /****************************************************************/
@@ -134,6 +139,7 @@ void DefruleCommands(
   {
 #if ! RUN_TIME
    AddUDF(theEnv,"run","v",0,1,"l",RunCommand,"RunCommand",NULL);
+   AddUDF(theEnv,"rules-fired","l",0,0,NULL,RulesFiredCommand,"RulesFiredCommand",NULL);
    AddUDF(theEnv,"halt","v",0,0,NULL,HaltCommand,"HaltCommand",NULL);
    AddUDF(theEnv,"focus","b",1,UNBOUNDED,"y",FocusCommand,"FocusCommand",NULL);
    AddUDF(theEnv,"clear-focus-stack","v",0,0,NULL,ClearFocusStackCommand,"ClearFocusStackCommand",NULL);
@@ -157,6 +163,9 @@ void DefruleCommands(
    AddUDF(theEnv,"get-beta-memory-resizing","b",0,0,NULL,GetBetaMemoryResizingCommand,"GetBetaMemoryResizingCommand",NULL);
    AddUDF(theEnv,"set-beta-memory-resizing","b",1,1,NULL,SetBetaMemoryResizingCommand,"SetBetaMemoryResizingCommand",NULL);
 
+   AddUDF(theEnv,"get-join-reordering","b",0,0,NULL,GetJoinReorderingCommand,"GetJoinReorderingCommand",NULL);
+   AddUDF(theEnv,"set-join-reordering","b",1,1,NULL,SetJoinReorderingCommand,"SetJoinReorderingCommand",NULL);
+
    AddUDF(theEnv,"get-strategy","y",0,0,NULL,GetStrategyCommand,"GetStrategyCommand",NULL);
    AddUDF(theEnv,"set-strategy","y",1,1,"y",SetStrategyCommand,"SetStrategyCommand",NULL);
 
@@ -242,6 +251,72 @@ void GetBetaMemoryResizingCommand(
    returnValue->lexemeValue = CreateBoolean(theEnv,GetBetaMemoryResizing(theEnv));
   }
 
+/********************************************/
+/* GetJoinReordering: C access routine for  */
+/*   the get-join-reordering command.       */
+/********************************************/
+bool GetJoinReordering(
+  Environment *theEnv)
+  {
+   return DefruleData(theEnv)->JoinReorderingFlag;
+  }
+
+/********************************************/
+/* SetJoinReordering: C access routine for  */
+/*   the set-join-reordering command.       */
+/********************************************/
+bool SetJoinReordering(
+  Environment *theEnv,
+  bool value)
+  {
+   bool ov;
+
+   ov = DefruleData(theEnv)->JoinReorderingFlag;
+
+   DefruleData(theEnv)->JoinReorderingFlag = value;
+
+   return(ov);
+  }
+
+/************************************************/
+/* SetJoinReorderingCommand: H/L access routine */
+/*   for the set-join-reordering command.       */
+/************************************************/
+void SetJoinReorderingCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   UDFValue theArg;
+
+   returnValue->lexemeValue = CreateBoolean(theEnv,GetJoinReordering(theEnv));
+
+   /*========================================================*/
+   /* The symbol FALSE disables join reordering. Any other   */
+   /* value enables reordering for subsequently built rules. */
+   /*========================================================*/
+
+   if (! UDFFirstArgument(context,ANY_TYPE_BITS,&theArg))
+     { return; }
+
+   if (theArg.value == FalseSymbol(theEnv))
+     { SetJoinReordering(theEnv,false); }
+   else
+     { SetJoinReordering(theEnv,true); }
+  }
+
+/************************************************/
+/* GetJoinReorderingCommand: H/L access routine */
+/*   for the get-join-reordering command.       */
+/************************************************/
+void GetJoinReorderingCommand(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   returnValue->lexemeValue = CreateBoolean(theEnv,GetJoinReordering(theEnv));
+  }
+
 #if DEBUGGING_FUNCTIONS
 
 /****************************************/
@@ -345,6 +420,14 @@ void Matches(
 
       AlphaJoins(theEnv,rulePtr,arraySize,theInfo);
 
+      /*==============================================*/
+      /* If the patterns were reordered when the rule */
+      /* was built, list the order that was chosen.   */
+      /*==============================================*/
+
+      if ((rulePtr->patternOrder != NULL) && (output != TERSE))
+        { ListPatternOrder(theEnv,rulePtr); }
+
       /*=========================*/
       /* List the alpha matches. */
       /*=========================*/
@@ -428,6 +511,35 @@ void Matches(
    returnValue->multifieldValue->contents[2].integerValue = CreateInteger(theEnv,activations);
   }
 
+/*************************************************************/
+/* ListPatternOrder: Lists the CE numbers of the patterns of */
+/*   a disjunct in the order the patterns are joined.        */
+/*************************************************************/
+static void ListPatternOrder(
+  Environment *theEnv,
+  Defrule *theDisjunct)
+  {
+   unsigned short i;
+
+   PrintString(theEnv,WDISPLAY,"Join order:");
+
+   for (i = 0; i < theDisjunct->patternCount; i++)
+     {
+      if (i > 0)
+        { PrintString(theEnv,WDISPLAY,","); }
+
+      if (theDisjunct->patternOrder[i] == 0)
+        { PrintString(theEnv,WDISPLAY," *"); }
+      else
+        {
+         PrintString(theEnv,WDISPLAY," CE ");
+         PrintInteger(theEnv,WDISPLAY,theDisjunct->patternOrder[i]);
+        }
+     }
+
+   PrintString(theEnv,WDISPLAY,"\n");
+  }
+
 /****************************************************/
 /* AlphaJoinCountDriver: Driver routine to iterate  */
 /*   over a rule's joins to determine the number of */
@@ -504,9 +616,9 @@ void AlphaJoins(
   }
 
 /****************************************************/
-/* BetaJoinCountDriver: Driver routine to iterate  */
+/* BetaJoinCountDriver: Driver routine to iterate   */
 /*   over a rule's joins to determine the number of */
-/*   beta joins.                                   */
+/*   beta joins.                                    */
 /****************************************************/
 static long BetaJoinCountDriver(
   Environment *theEnv,
@@ -60,6 +60,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added support for cost-based join reordering.  */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_rulecom
@@ -92,6 +94,10 @@ typedef enum
    bool                           SetBetaMemoryResizing(Environment *,bool);
    void                           GetBetaMemoryResizingCommand(Environment *,UDFContext *,UDFValue *);
    void                           SetBetaMemoryResizingCommand(Environment *,UDFContext *,UDFValue *);
+   bool                           GetJoinReordering(Environment *);
+   bool                           SetJoinReordering(Environment *,bool);
+   void                           GetJoinReorderingCommand(Environment *,UDFContext *,UDFValue *);
+   void                           SetJoinReorderingCommand(Environment *,UDFContext *,UDFValue *);
    void                           Matches(Defrule *,Verbosity,CLIPSValue *);
    void                           JoinActivity(Environment *,Defrule *,int,UDFValue *);
    void                           DefruleCommands(Environment *);
@@ -64,6 +64,13 @@
 /*                                                           */
 /*            ALLOW_ENVIRONMENT_GLOBALS no longer supported. */
 /*                                                           */
+/*      6.50: Join reordering is disabled by default.        */
+/*                                                           */
+/*            Added reset snapshots.                         */
+/*                                                           */
+/*            Added the list of rules with a dynamic         */
+/*            salience.                                      */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -85,6 +92,10 @@
 #include "rulepsr.h"
 #include "ruledlt.h"
 
+#if DEFTEMPLATE_CONSTRUCT
+#include "rsetsnap.h"
+#endif
+
 #if BLOAD || BLOAD_AND_BSAVE || BLOAD_ONLY
 #include "bload.h"
 #include "rulebin.h"
@@ -135,6 +146,10 @@ void InitializeDefrules(
 
    DefruleCommands(theEnv);
 
+#if DEFTEMPLATE_CONSTRUCT
+   InitializeResetSnapshot(theEnv);
+#endif
+
    DefruleData(theEnv)->DefruleConstruct =
       AddConstruct(theEnv,"defrule","defrules",
                    ParseDefrule,
@@ -153,9 +168,12 @@ void InitializeDefrules(
    for (i = 0; i < ALPHA_MEMORY_HASH_SIZE; i++) DefruleData(theEnv)->AlphaMemoryTable[i] = NULL;
 
    DefruleData(theEnv)->BetaMemoryResizingFlag = true;
+   DefruleData(theEnv)->JoinReorderingFlag = false;
 
    DefruleData(theEnv)->RightPrimeJoins = NULL;
    DefruleData(theEnv)->LeftPrimeJoins = NULL;
+   DefruleData(theEnv)->DynamicSalienceRules = NULL;
+   DefruleData(theEnv)->LastDynamicSalienceRule = NULL;
   }
 
 /**************************************************/
@@ -191,6 +209,7 @@ static void DeallocateDefruleData(
         {
          tmpActivation = theActivation->next;
 
+         UpdateSubsystemMemory(theEnv,AGENDA_MEMORY,- (long) sizeof(struct activation));
          rtn_struct(theEnv,activation,theActivation);
 
          theActivation = tmpActivation;
@@ -389,6 +408,91 @@ Defrule *GetNthDisjunct(
    return NULL;
   }
 
+/*************************************************************/
+/* AddDynamicSalienceRule: Adds a rule to the end of the     */
+/*   list of rules with a dynamic salience. This list is     */
+/*   used to refresh saliences when salience evaluation is   */
+/*   set to every-cycle. Only the first disjunct is stored.  */
+/*************************************************************/
+void AddDynamicSalienceRule(
+  Environment *theEnv,
+  Defrule *theRule)
+  {
+   theRule->nextDynamicSalience = NULL;
+
+   if (theRule->dynamicSalience == NULL) return;
+
+   if (DefruleData(theEnv)->LastDynamicSalienceRule == NULL)
+     { DefruleData(theEnv)->DynamicSalienceRules = theRule; }
+   else
+     { DefruleData(theEnv)->LastDynamicSalienceRule->nextDynamicSalience = theRule; }
+
+   DefruleData(theEnv)->LastDynamicSalienceRule = theRule;
+  }
+
+/************************************************************/
+/* RemoveDynamicSalienceRule: Removes a rule from the list  */
+/*   of rules with a dynamic salience.                      */
+/************************************************************/
+void RemoveDynamicSalienceRule(
+  Environment *theEnv,
+  Defrule *theRule)
+  {
+   Defrule *lastRule = NULL, *tempRule;
+
+   if (theRule->dynamicSalience == NULL) return;
+
+   for (tempRule = DefruleData(theEnv)->DynamicSalienceRules;
+        tempRule != NULL;
+        tempRule = tempRule->nextDynamicSalience)
+     {
+      if (tempRule == theRule) break;
+      lastRule = tempRule;
+     }
+
+   if (tempRule == NULL) return;
+
+   if (lastRule == NULL)
+     { DefruleData(theEnv)->DynamicSalienceRules = theRule->nextDynamicSalience; }
+   else
+     { lastRule->nextDynamicSalience = theRule->nextDynamicSalience; }
+
+   if (DefruleData(theEnv)->LastDynamicSalienceRule == theRule)
+     { DefruleData(theEnv)->LastDynamicSalienceRule = lastRule; }
+
+   theRule->nextDynamicSalience = NULL;
+  }
+
+/***********************************************************/
+/* BuildDynamicSalienceRules: Rebuilds the list of rules   */
+/*   with a dynamic salience from the rules in all of the  */
+/*   modules. Used after a binary or run-time image has    */
+/*   been loaded.                                          */
+/***********************************************************/
+void BuildDynamicSalienceRules(
+  Environment *theEnv,
+  void *context)
+  {
+#if MAC_XCD
+#pragma unused(context)
+#endif
+   Defmodule *theModule;
+   Defrule *theRule;
+
+   DefruleData(theEnv)->DynamicSalienceRules = NULL;
+   DefruleData(theEnv)->LastDynamicSalienceRule = NULL;
+
+   for (theModule = GetNextDefmodule(theEnv,NULL);
+        theModule != NULL;
+        theModule = GetNextDefmodule(theEnv,theModule))
+     {
+      for (theRule = (Defrule *) GetDefruleModuleItem(theEnv,theModule)->header.firstItem;
+           theRule != NULL;
+           theRule = (Defrule *) theRule->header.next)
+        { AddDynamicSalienceRule(theEnv,theRule); }
+     }
+  }
+
 #if RUN_TIME
 
 /******************************************/
@@ -428,6 +532,8 @@ void DefruleRunTimeInitialize(
      }
 
    RestoreCurrentModule(theEnv);
+
+   BuildDynamicSalienceRules(theEnv,NULL);
   }
 
 
@@ -66,6 +66,14 @@
 /*                                                           */
 /*            ALLOW_ENVIRONMENT_GLOBALS no longer supported. */
 /*                                                           */
+/*      6.50: Added join reordering flag and the pattern     */
+/*            order used for a reordered disjunct.           */
+/*                                                           */
+/*            Added salience dependency fields.              */
+/*                                                           */
+/*            Added the list of rules with a dynamic         */
+/*            salience.                                      */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_ruledef
@@ -76,6 +84,10 @@
 
 #define GetDisjunctIndex(r) (r->header.bsaveID)
 
+#define SALIENCE_UNCLASSIFIED 0
+#define SALIENCE_ON_GLOBALS   1
+#define SALIENCE_VOLATILE     2
+
 typedef struct defrule Defrule;
 struct defruleModule;
 
@@ -100,6 +112,11 @@ struct defrule
    struct joinNode *logicalJoin;
    struct joinNode *lastJoin;
    Defrule *disjunct;
+   unsigned short patternCount;
+   unsigned short *patternOrder;
+   unsigned int salienceDependency : 2;
+   unsigned long long salienceTag;
+   Defrule *nextDynamicSalience;
   };
 
 #include "agenda.h"
@@ -130,8 +147,11 @@ struct defruleData
    long long CurrentEntityTimeTag;
    struct alphaMemoryHash **AlphaMemoryTable;
    bool BetaMemoryResizingFlag;
+   bool JoinReorderingFlag;
    struct joinLink *RightPrimeJoins;
    struct joinLink *LeftPrimeJoins;
+   Defrule *DynamicSalienceRules;
+   Defrule *LastDynamicSalienceRule;
 
 #if DEBUGGING_FUNCTIONS
     bool WatchRules;
@@ -170,6 +190,9 @@ struct defruleData
 #endif
    long                           GetDisjunctCount(Environment *,Defrule *);
    Defrule                       *GetNthDisjunct(Environment *,Defrule *,long);
+   void                           AddDynamicSalienceRule(Environment *,Defrule *);
+   void                           RemoveDynamicSalienceRule(Environment *,Defrule *);
+   void                           BuildDynamicSalienceRules(Environment *,void *);
    const char                    *DefruleModule(Defrule *);
    const char                    *DefruleName(Defrule *);
    const char                    *DefrulePPForm(Defrule *);
@@ -38,6 +38,11 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added support for cost-based join reordering.  */
+/*                                                           */
+/*            Removing a defrule discards the reset          */
+/*            snapshot.                                      */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -59,6 +64,9 @@
 #include "pattern.h"
 #include "reteutil.h"
 #include "retract.h"
+#if DEFTEMPLATE_CONSTRUCT
+#include "rsetsnap.h"
+#endif
 
 #include "ruledlt.h"
 
@@ -89,6 +97,12 @@ void ReturnDefrule(
 
    if (theDefrule == NULL) return;
 
+   RemoveDynamicSalienceRule(theEnv,theDefrule);
+
+#if DEFTEMPLATE_CONSTRUCT
+   DiscardResetSnapshot(theEnv);
+#endif
+
    /*======================================*/
    /* If a rule is redefined, then we want */
    /* to save its breakpoint status.       */
@@ -173,6 +187,13 @@ void ReturnDefrule(
          ReturnPackedExpression(theEnv,theDefrule->actions);
         }
 
+      /*======================================*/
+      /* Get rid of the rule's pattern order. */
+      /*======================================*/
+
+      if (theDefrule->patternOrder != NULL)
+        { rm(theEnv,theDefrule->patternOrder,sizeof(unsigned short) * theDefrule->patternCount); }
+
       /*===============================*/
       /* Move on to the next disjunct. */
       /*===============================*/
@@ -238,6 +259,9 @@ void DestroyDefrule(
 #if (! BLOAD_ONLY) && (! RUN_TIME)
       if (theDefrule->actions != NULL)
         { ReturnPackedExpression(theEnv,theDefrule->actions); }
+
+      if (theDefrule->patternOrder != NULL)
+        { rm(theEnv,theDefrule->patternOrder,sizeof(unsigned short) * theDefrule->patternCount); }
 #endif
 
       nextDisjunct = theDefrule->disjunct;
@@ -48,6 +48,14 @@
 /*                                                           */
 /*            Fact ?var:slot references in defrules.         */
 /*                                                           */
+/*            Added support for cost-based join reordering.  */
+/*                                                           */
+/*            New defrules are added to the construct index. */
+/*                                                           */
+/*            Added salience dependency fields.              */
+/*                                                           */
+/*            Adding a defrule discards the reset snapshot.  */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -89,6 +97,7 @@
 
 #if DEFTEMPLATE_CONSTRUCT
 #include "factgen.h"
+#include "rsetsnap.h"
 #include "tmpltfun.h"
 #endif
 
@@ -112,6 +121,7 @@
    static int                     ExpressionComplexity(Environment *,struct expr *);
    static int                     LogicalAnalysis(Environment *,struct lhsParseNode *);
    static void                    AddToDefruleList(Defrule *);
+   static void                    SetPatternOrder(Environment *,Defrule *,struct lhsParseNode *);
 #endif
 
 /****************************************************/
@@ -257,7 +267,12 @@ bool ParseDefrule(
    /* Rule completely parsed. Add to list of rules. */
    /*===============================================*/
 
+#if DEFTEMPLATE_CONSTRUCT
+   DiscardResetSnapshot(theEnv);
+#endif
+
    AddToDefruleList(topDisjunct);
+   AddDynamicSalienceRule(theEnv,topDisjunct);
 
    /*========================================================================*/
    /* If a rule is redefined, then we want to restore its breakpoint status. */
@@ -457,6 +472,13 @@ static Defrule *ProcessRuleLHS(
       currentDisjunct = CreateNewDisjunct(theEnv,ruleName,localVarCnt,packPtr,complexity,
                                           (unsigned) logicalJoin,lastJoin);
 
+      /*=================================================*/
+      /* Remember the order in which the patterns were   */
+      /* joined if they were reordered by their cost.    */
+      /*=================================================*/
+
+      SetPatternOrder(theEnv,currentDisjunct,tempNode);
+
       /*============================================================*/
       /* Place the disjunct in the list of disjuncts for this rule. */
       /* If the disjunct is the first disjunct, then increment the  */
@@ -527,6 +549,11 @@ static Defrule *CreateNewDisjunct(
    newDisjunct->autoFocus = PatternData(theEnv)->GlobalAutoFocus;
    newDisjunct->dynamicSalience = PatternData(theEnv)->SalienceExpression;
    newDisjunct->localVarCnt = localVarCnt;
+   newDisjunct->patternCount = 0;
+   newDisjunct->patternOrder = NULL;
+   newDisjunct->salienceDependency = SALIENCE_UNCLASSIFIED;
+   newDisjunct->salienceTag = 0;
+   newDisjunct->nextDynamicSalience = NULL;
 
    /*=====================================*/
    /* Add a pointer to the rule's module. */
@@ -565,6 +592,53 @@ static Defrule *CreateNewDisjunct(
    return(newDisjunct);
   }
 
+/*****************************************************************/
+/* SetPatternOrder: If the pattern CEs of a disjunct were joined */
+/*   in an order different from the order in which they were     */
+/*   specified, records the CE number of each pattern in the     */
+/*   order joined so that it can be reported by the matches      */
+/*   command. Patterns added while analyzing the rule are        */
+/*   recorded as CE 0.                                           */
+/*****************************************************************/
+static void SetPatternOrder(
+  Environment *theEnv,
+  Defrule *theDisjunct,
+  struct lhsParseNode *theLHS)
+  {
+   struct lhsParseNode *tmpLHS;
+   unsigned short count = 0, lastCE = 0;
+   bool reordered = false;
+
+   for (tmpLHS = theLHS; tmpLHS != NULL; tmpLHS = tmpLHS->bottom)
+     {
+      if (tmpLHS->pnType != PATTERN_CE_NODE) continue;
+
+      count++;
+
+      if (! tmpLHS->userCE) continue;
+
+      if (tmpLHS->whichCE < lastCE)
+        { reordered = true; }
+      lastCE = tmpLHS->whichCE;
+     }
+
+   if (! reordered) return;
+
+   theDisjunct->patternCount = count;
+   theDisjunct->patternOrder = (unsigned short *)
+                               gm2(theEnv,sizeof(unsigned short) * count);
+
+   for (tmpLHS = theLHS, count = 0; tmpLHS != NULL; tmpLHS = tmpLHS->bottom)
+     {
+      if (tmpLHS->pnType != PATTERN_CE_NODE) continue;
+
+      if (tmpLHS->userCE)
+        { theDisjunct->patternOrder[count++] = (unsigned short) tmpLHS->whichCE; }
+      else
+        { theDisjunct->patternOrder[count++] = 0; }
+     }
+  }
+
 /****************************************************************/
 /* ReplaceExpressionVariables: Replaces all symbolic references */
 /*   to variables (local and global) found in an expression on  */
@@ -986,6 +1060,8 @@ static void AddToDefruleList(
      }
 
    theModuleItem->header.lastItem = &rulePtr->header;
+
+   AddConstructToIndex(rulePtr->header.env,&rulePtr->header);
   }
 
 #if DEVELOPER && DEBUGGING_FUNCTIONS
@@ -37,6 +37,13 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Tokens are scanned into a retained buffer      */
+/*            which doubles in size and the lexemes for      */
+/*            punctuation tokens are cached.                 */
+/*                                                           */
+/*            The print forms of string and number tokens    */
+/*            can be omitted when they are not needed.       */
+/*                                                           */
 /*************************************************************/
 
 #include <ctype.h>
@@ -67,6 +74,8 @@
    static CLIPSLexeme            *ScanSymbol(Environment *,const char *,int,TokenType *);
    static CLIPSLexeme            *ScanString(Environment *,const char *);
    static void                    ScanNumber(Environment *,const char *,struct token *);
+   static void                    SaveTokenChar(Environment *,int);
+   static CLIPSLexeme            *TokenLexeme(Environment *,CLIPSLexeme **,const char *,unsigned short);
    static void                    DeallocateScannerData(Environment *);
 
 /************************************************/
@@ -96,7 +105,10 @@ static void DeallocateScannerData(
 /*   the type of token (e.g., symbol, string, integer, etc.), the data */
 /*   value for the token (i.e., a symbol table location if it is a     */
 /*   symbol or string, an integer table location if it is an integer), */
-/*   and the pretty print representation.                              */
+/*   and the pretty print representation. When print forms are         */
+/*   omitted, the print form of a string is its contents and the print */
+/*   form of a number is the scanned text, which is only valid until   */
+/*   the next token is read.                                           */
 /***********************************************************************/
 void GetToken(
  Environment *theEnv,
@@ -114,7 +126,8 @@ void GetToken(
    theToken->value = NULL;
    theToken->printForm = "unknown";
    ScannerData(theEnv)->GlobalPos = 0;
-   ScannerData(theEnv)->GlobalMax = 0;
+   if (ScannerData(theEnv)->GlobalString != NULL)
+     { ScannerData(theEnv)->GlobalString[0] = EOS; }
 
    /*==============================================*/
    /* Remove all white space before processing the */
@@ -169,7 +182,10 @@ void GetToken(
       case '"':
          theToken->lexemeValue = ScanString(theEnv,logicalName);
          theToken->tknType = STRING_TOKEN;
-         theToken->printForm = StringPrintForm(theEnv,theToken->lexemeValue->contents);
+         if (ScannerData(theEnv)->OmitPrintForms)
+           { theToken->printForm = theToken->lexemeValue->contents; }
+         else
+           { theToken->printForm = StringPrintForm(theEnv,theToken->lexemeValue->contents); }
          break;
 
       /*=======================================*/
@@ -274,7 +290,7 @@ void GetToken(
          else
            {
             theToken->tknType = SYMBOL_TOKEN;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,'$',ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,'$');
             UngetcRouter(theEnv,logicalName,inchar);
             theToken->lexemeValue = ScanSymbol(theEnv,logicalName,1,&type);
             theToken->printForm = theToken->lexemeValue->contents;
@@ -287,7 +303,7 @@ void GetToken(
 
       case '<':
          theToken->tknType = SYMBOL_TOKEN;
-         ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,'<',ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+         SaveTokenChar(theEnv,'<');
          theToken->lexemeValue = ScanSymbol(theEnv,logicalName,1,&type);
          theToken->printForm = theToken->lexemeValue->contents;
          break;
@@ -298,31 +314,31 @@ void GetToken(
 
       case '(':
          theToken->tknType = LEFT_PARENTHESIS_TOKEN;
-         theToken->lexemeValue = CreateString(theEnv,"(");
+         theToken->lexemeValue = TokenLexeme(theEnv,&ScannerData(theEnv)->LeftParenthesisLexeme,"(",STRING_TYPE);
          theToken->printForm = "(";
          break;
 
       case ')':
          theToken->tknType= RIGHT_PARENTHESIS_TOKEN;
-         theToken->lexemeValue = CreateString(theEnv,")");
+         theToken->lexemeValue = TokenLexeme(theEnv,&ScannerData(theEnv)->RightParenthesisLexeme,")",STRING_TYPE);
          theToken->printForm = ")";
          break;
 
       case '~':
          theToken->tknType = NOT_CONSTRAINT_TOKEN;
-         theToken->lexemeValue = CreateString(theEnv,"~");
+         theToken->lexemeValue = TokenLexeme(theEnv,&ScannerData(theEnv)->NotConstraintLexeme,"~",STRING_TYPE);
          theToken->printForm = "~";
          break;
 
       case '|':
          theToken->tknType = OR_CONSTRAINT_TOKEN;
-         theToken->lexemeValue = CreateString(theEnv,"|");
+         theToken->lexemeValue = TokenLexeme(theEnv,&ScannerData(theEnv)->OrConstraintLexeme,"|",STRING_TYPE);
          theToken->printForm = "|";
          break;
 
       case '&':
          theToken->tknType =  AND_CONSTRAINT_TOKEN;
-         theToken->lexemeValue = CreateString(theEnv,"&");
+         theToken->lexemeValue = TokenLexeme(theEnv,&ScannerData(theEnv)->AndConstraintLexeme,"&",STRING_TYPE);
          theToken->printForm = "&";
          break;
 
@@ -334,7 +350,7 @@ void GetToken(
       case 0:
       case 3:
          theToken->tknType = STOP_TOKEN;
-         theToken->lexemeValue = CreateSymbol(theEnv,"stop");
+         theToken->lexemeValue = TokenLexeme(theEnv,&ScannerData(theEnv)->StopLexeme,"stop",SYMBOL_TYPE);
          theToken->printForm = "";
          break;
 
@@ -371,10 +387,11 @@ void GetToken(
 #endif
 
    /*=========================================================*/
-   /* Return the temporary memory used in scanning the token. */
+   /* The buffer used for scanning tokens is kept for the     */
+   /* next token unless an unusually long token expanded it.  */
    /*=========================================================*/
 
-   if (ScannerData(theEnv)->GlobalString != NULL)
+   if (ScannerData(theEnv)->GlobalMax > MAXIMUM_RETAINED_TOKEN_BUFFER)
      {
       rm(theEnv,ScannerData(theEnv)->GlobalString,ScannerData(theEnv)->GlobalMax);
       ScannerData(theEnv)->GlobalString = NULL;
@@ -413,7 +430,7 @@ static CLIPSLexeme *ScanSymbol(
             IsUTF8MultiByteContinuation(inchar) ||
             isprint(inchar)))
      {
-      ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+      SaveTokenChar(theEnv,inchar);
 
       count++;
       inchar = GetcRouter(theEnv,logicalName);
@@ -471,10 +488,6 @@ static CLIPSLexeme *ScanString(
   const char *logicalName)
   {
    int inchar;
-   size_t pos = 0;
-   size_t max = 0;
-   char *theString = NULL;
-   CLIPSLexeme *thePtr;
 
    /*============================================*/
    /* Scan characters and add them to the string */
@@ -487,7 +500,16 @@ static CLIPSLexeme *ScanString(
       if (inchar == '\\')
         { inchar = GetcRouter(theEnv,logicalName); }
 
-      theString = ExpandStringWithChar(theEnv,inchar,theString,&pos,&max,max+80);
+      if (inchar == '\b')
+        {
+         ScannerData(theEnv)->GlobalString =
+            ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,
+                                 &ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,
+                                 ScannerData(theEnv)->GlobalMax + TOKEN_BUFFER_SIZE);
+        }
+      else
+        { SaveTokenChar(theEnv,inchar); }
+
       inchar = GetcRouter(theEnv,logicalName);
      }
 
@@ -502,15 +524,10 @@ static CLIPSLexeme *ScanString(
    /* the symbol table address of the string.       */
    /*===============================================*/
 
-   if (theString == NULL)
-     { thePtr = CreateString(theEnv,""); }
-   else
-     {
-      thePtr = CreateString(theEnv,theString);
-      rm(theEnv,theString,max);
-     }
+   if (ScannerData(theEnv)->GlobalString == NULL)
+     { return CreateString(theEnv,""); }
 
-   return thePtr;
+   return CreateString(theEnv,ScannerData(theEnv)->GlobalString);
   }
 
 /**************************************/
@@ -549,26 +566,26 @@ static void ScanNumber(
            {
             phase = 0;
             digitFound = true;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
          else if ((inchar == '+') || (inchar == '-'))
            {
             phase = 0;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
          else if (inchar == '.')
            {
             processFloat = true;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
             phase = 1;
            }
          else if ((inchar == 'E') || (inchar == 'e'))
            {
             processFloat = true;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
             phase = 2;
            }
@@ -581,7 +598,7 @@ static void ScanNumber(
          else
            {
             phase = 9;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
         }
@@ -590,20 +607,20 @@ static void ScanNumber(
          if (isdigit(inchar))
            {
             digitFound = true;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
          else if (inchar == '.')
            {
             processFloat = true;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
             phase = 1;
            }
          else if ((inchar == 'E') || (inchar == 'e'))
            {
             processFloat = true;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
             phase = 2;
            }
@@ -616,7 +633,7 @@ static void ScanNumber(
          else
            {
             phase = 9;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
         }
@@ -625,12 +642,12 @@ static void ScanNumber(
          if (isdigit(inchar))
            {
             digitFound = true;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
          else if ((inchar == 'E') || (inchar == 'e'))
            {
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
             phase = 2;
            }
@@ -643,7 +660,7 @@ static void ScanNumber(
          else
            {
             phase = 9;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
         }
@@ -651,13 +668,13 @@ static void ScanNumber(
         {
          if (isdigit(inchar))
            {
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
             phase = 3;
            }
          else if ((inchar == '+') || (inchar == '-'))
            {
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
             phase = 3;
            }
@@ -673,7 +690,7 @@ static void ScanNumber(
          else
            {
             phase = 9;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
         }
@@ -681,7 +698,7 @@ static void ScanNumber(
         {
          if (isdigit(inchar))
            {
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
          else if ( (inchar == '<') || (inchar == '"') ||
@@ -697,7 +714,7 @@ static void ScanNumber(
          else
            {
             phase = 9;
-            ScannerData(theEnv)->GlobalString = ExpandStringWithChar(theEnv,inchar,ScannerData(theEnv)->GlobalString,&ScannerData(theEnv)->GlobalPos,&ScannerData(theEnv)->GlobalMax,ScannerData(theEnv)->GlobalMax+80);
+            SaveTokenChar(theEnv,inchar);
             count++;
            }
         }
@@ -734,7 +751,10 @@ static void ScanNumber(
       fvalue = atof(ScannerData(theEnv)->GlobalString);
       theToken->tknType = FLOAT_TOKEN;
       theToken->floatValue = CreateFloat(theEnv,fvalue);
-      theToken->printForm = FloatToString(theEnv,theToken->floatValue->contents);
+      if (ScannerData(theEnv)->OmitPrintForms)
+        { theToken->printForm = ScannerData(theEnv)->GlobalString; }
+      else
+        { theToken->printForm = FloatToString(theEnv,theToken->floatValue->contents); }
      }
    else
      {
@@ -751,12 +771,66 @@ static void ScanNumber(
         }
       theToken->tknType = INTEGER_TOKEN;
       theToken->integerValue = CreateInteger(theEnv,lvalue);
-      theToken->printForm = LongIntegerToString(theEnv,theToken->integerValue->contents);
+      if (ScannerData(theEnv)->OmitPrintForms)
+        { theToken->printForm = ScannerData(theEnv)->GlobalString; }
+      else
+        { theToken->printForm = LongIntegerToString(theEnv,theToken->integerValue->contents); }
      }
 
    return;
   }
 
+/*******************************************************/
+/* SaveTokenChar: Adds a character to the buffer used  */
+/*   for scanning tokens. The buffer doubles in size   */
+/*   when full so that long symbols and strings aren't */
+/*   copied each time a few characters are added.      */
+/*******************************************************/
+static void SaveTokenChar(
+  Environment *theEnv,
+  int inchar)
+  {
+   size_t newMax;
+
+   if ((ScannerData(theEnv)->GlobalPos + 1) >= ScannerData(theEnv)->GlobalMax)
+     {
+      if (ScannerData(theEnv)->GlobalMax == 0)
+        { newMax = TOKEN_BUFFER_SIZE; }
+      else
+        { newMax = ScannerData(theEnv)->GlobalMax * 2; }
+
+      ScannerData(theEnv)->GlobalString =
+         (char *) genrealloc(theEnv,ScannerData(theEnv)->GlobalString,
+                             ScannerData(theEnv)->GlobalMax,newMax);
+      ScannerData(theEnv)->GlobalMax = newMax;
+     }
+
+   ScannerData(theEnv)->GlobalString[ScannerData(theEnv)->GlobalPos++] = (char) inchar;
+   ScannerData(theEnv)->GlobalString[ScannerData(theEnv)->GlobalPos] = EOS;
+  }
+
+/*******************************************************/
+/* TokenLexeme: Returns the lexeme for a punctuation   */
+/*   or stop token. The lexeme is looked up in the     */
+/*   symbol table the first time it's needed and then  */
+/*   retained so that scanning these tokens doesn't    */
+/*   require hashing.                                  */
+/*******************************************************/
+static CLIPSLexeme *TokenLexeme(
+  Environment *theEnv,
+  CLIPSLexeme **theLexeme,
+  const char *str,
+  unsigned short theType)
+  {
+   if (*theLexeme == NULL)
+     {
+      *theLexeme = AddSymbol(theEnv,str,theType);
+      IncrementLexemeCount(*theLexeme);
+     }
+
+   return *theLexeme;
+  }
+
 /***********************************************************/
 /* CopyToken: Copies values of one token to another token. */
 /***********************************************************/
@@ -37,6 +37,11 @@
 /*            Removed use of void pointers for specific      */
 /*            data structures.                               */
 /*                                                           */
+/*      6.50: Added fields for the retained token buffer and */
+/*            cached punctuation lexemes.                    */
+/*                                                           */
+/*            Added the OmitPrintForms flag.                 */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_scanner
@@ -91,8 +96,18 @@ struct scannerData
    size_t GlobalPos;
    long LineCount;
    bool IgnoreCompletionErrors;
+   bool OmitPrintForms;
+   CLIPSLexeme *LeftParenthesisLexeme;
+   CLIPSLexeme *RightParenthesisLexeme;
+   CLIPSLexeme *NotConstraintLexeme;
+   CLIPSLexeme *OrConstraintLexeme;
+   CLIPSLexeme *AndConstraintLexeme;
+   CLIPSLexeme *StopLexeme;
   };
 
+#define TOKEN_BUFFER_SIZE 80
+#define MAXIMUM_RETAINED_TOKEN_BUFFER 4096
+
 #define ScannerData(theEnv) ((struct scannerData *) GetEnvironmentData(theEnv,SCANNER_DATA))
 
    void                           InitializeScannerData(Environment *);
@@ -34,6 +34,9 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added native comparisons of numbers for the    */
+/*            sort function and the sort-by-key function.    */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -45,6 +48,8 @@
 #include "extnfunc.h"
 #include "memalloc.h"
 #include "multifld.h"
+#include "prntutil.h"
+#include "router.h"
 #include "sysdep.h"
 
 #include "sortfun.h"
@@ -64,8 +69,17 @@ struct sortFunctionData
 
    static void                    DoMergeSort(Environment *,UDFValue *,UDFValue *,unsigned long,
                                               unsigned long,unsigned long,unsigned long,
-                                              bool (*)(Environment *,UDFValue *,UDFValue *));
+                                              SortSwapFunction *);
    static bool                    DefaultCompareSwapFunction(Environment *,UDFValue *,UDFValue *);
+   static bool                    GreaterThanSwapFunction(Environment *,UDFValue *,UDFValue *);
+   static bool                    GreaterThanOrEqualSwapFunction(Environment *,UDFValue *,UDFValue *);
+   static bool                    LessThanSwapFunction(Environment *,UDFValue *,UDFValue *);
+   static bool                    LessThanOrEqualSwapFunction(Environment *,UDFValue *,UDFValue *);
+   static SortSwapFunction       *NativeSwapFunction(Environment *,struct expr *,UDFValue *,long);
+   static struct expr            *SortFunctionReference(Environment *,UDFContext *,unsigned int,
+                                                        int,const char *);
+   static bool                    EvaluateSortKey(Environment *,struct expr *,UDFValue *);
+   static void                    SortDriver(Environment *,UDFContext *,UDFValue *,bool);
    static void                    DeallocateSortFunctionData(Environment *);
 
 /****************************************/
@@ -78,6 +92,7 @@ void SortFunctionDefinitions(
    AllocateEnvironmentData(theEnv,SORTFUN_DATA,sizeof(struct sortFunctionData),DeallocateSortFunctionData);
 #if ! RUN_TIME
    AddUDF(theEnv,"sort","bm",1,UNBOUNDED,"*;y",SortFunction,"SortFunction",NULL);
+   AddUDF(theEnv,"sort-by-key","bm",2,UNBOUNDED,"*;y;y",SortByKeyFunction,"SortByKeyFunction",NULL);
 #endif
   }
 
@@ -115,46 +130,162 @@ static bool DefaultCompareSwapFunction(
    return true;
   }
 
-/************************************/
-/* SortFunction: H/L access routine */
-/*   for the rest$ function.        */
-/************************************/
-void SortFunction(
+/*****************************************************/
+/* GreaterThanSwapFunction: Native equivalent of the */
+/*   > function used to sort a list of numbers.      */
+/*****************************************************/
+static bool GreaterThanSwapFunction(
+  Environment *theEnv,
+  UDFValue *item1,
+  UDFValue *item2)
+  {
+#if MAC_XCD
+#pragma unused(theEnv)
+#endif
+
+   if ((item1->header->type == INTEGER_TYPE) && (item2->header->type == INTEGER_TYPE))
+     { return (item1->integerValue->contents > item2->integerValue->contents); }
+
+   return (CVCoerceToFloat(item1) > CVCoerceToFloat(item2));
+  }
+
+/************************************************************/
+/* GreaterThanOrEqualSwapFunction: Native equivalent of the */
+/*   >= function used to sort a list of numbers.            */
+/************************************************************/
+static bool GreaterThanOrEqualSwapFunction(
+  Environment *theEnv,
+  UDFValue *item1,
+  UDFValue *item2)
+  {
+#if MAC_XCD
+#pragma unused(theEnv)
+#endif
+
+   if ((item1->header->type == INTEGER_TYPE) && (item2->header->type == INTEGER_TYPE))
+     { return (item1->integerValue->contents >= item2->integerValue->contents); }
+
+   return (CVCoerceToFloat(item1) >= CVCoerceToFloat(item2));
+  }
+
+/**************************************************/
+/* LessThanSwapFunction: Native equivalent of the */
+/*   < function used to sort a list of numbers.   */
+/**************************************************/
+static bool LessThanSwapFunction(
+  Environment *theEnv,
+  UDFValue *item1,
+  UDFValue *item2)
+  {
+#if MAC_XCD
+#pragma unused(theEnv)
+#endif
+
+   if ((item1->header->type == INTEGER_TYPE) && (item2->header->type == INTEGER_TYPE))
+     { return (item1->integerValue->contents < item2->integerValue->contents); }
+
+   return (CVCoerceToFloat(item1) < CVCoerceToFloat(item2));
+  }
+
+/*********************************************************/
+/* LessThanOrEqualSwapFunction: Native equivalent of the */
+/*   <= function used to sort a list of numbers.         */
+/*********************************************************/
+static bool LessThanOrEqualSwapFunction(
+  Environment *theEnv,
+  UDFValue *item1,
+  UDFValue *item2)
+  {
+#if MAC_XCD
+#pragma unused(theEnv)
+#endif
+
+   if ((item1->header->type == INTEGER_TYPE) && (item2->header->type == INTEGER_TYPE))
+     { return (item1->integerValue->contents <= item2->integerValue->contents); }
+
+   return (CVCoerceToFloat(item1) <= CVCoerceToFloat(item2));
+  }
+
+/*************************************************************/
+/* NativeSwapFunction: Returns a native comparison function  */
+/*   equivalent to calling the system function referenced by */
+/*   the sort function if every value to be sorted is a      */
+/*   number. Otherwise the comparison function is evaluated  */
+/*   for each comparison and NULL is returned.               */
+/*************************************************************/
+static SortSwapFunction *NativeSwapFunction(
+  Environment *theEnv,
+  struct expr *functionReference,
+  UDFValue *theList,
+  long listSize)
+  {
+   SortSwapFunction *swapFunction;
+   struct functionDefinition *fptr;
+   long i;
+
+   if (functionReference->type != FCALL)
+     { return NULL; }
+
+   fptr = functionReference->functionValue;
+
+   if (fptr == FindFunction(theEnv,">"))
+     { swapFunction = GreaterThanSwapFunction; }
+   else if (fptr == FindFunction(theEnv,">="))
+     { swapFunction = GreaterThanOrEqualSwapFunction; }
+   else if (fptr == FindFunction(theEnv,"<"))
+     { swapFunction = LessThanSwapFunction; }
+   else if (fptr == FindFunction(theEnv,"<="))
+     { swapFunction = LessThanOrEqualSwapFunction; }
+   else
+     { return NULL; }
+
+   /*=================================================*/
+   /* Any value which isn't a number has to be passed */
+   /* to the function so the error is reported.       */
+   /*=================================================*/
+
+   for (i = 0; i < listSize; i++)
+     {
+      if ((theList[i].header->type != INTEGER_TYPE) &&
+          (theList[i].header->type != FLOAT_TYPE))
+        { return NULL; }
+     }
+
+   return swapFunction;
+  }
+
+/**************************************************************/
+/* SortFunctionReference: Returns a function call expression  */
+/*   for the function named by an argument of a sort function */
+/*   after verifying the function accepts the specified       */
+/*   number of arguments. Returns NULL if an error occurs.    */
+/**************************************************************/
+static struct expr *SortFunctionReference(
   Environment *theEnv,
   UDFContext *context,
-  UDFValue *returnValue)
+  unsigned int whichArgument,
+  int argumentCount,
+  const char *sortFunctionName)
   {
-   long argumentCount, i, j, k = 0;
-   UDFValue *theArguments, *theArguments2;
    UDFValue theArg;
-   Multifield *theMultifield, *tempMultifield;
-   const char *functionName;
    struct expr *functionReference;
-   int argumentSize = 0;
    struct functionDefinition *fptr;
 #if DEFFUNCTION_CONSTRUCT
    Deffunction *dptr;
 #endif
 
    /*==================================*/
-   /* Set up the default return value. */
+   /* Verify that the function exists. */
    /*==================================*/
 
-   returnValue->lexemeValue = FalseSymbol(theEnv);
-
-   /*=============================================*/
-   /* Verify that the comparison function exists. */
-   /*=============================================*/
+   if (! UDFNthArgument(context,whichArgument,SYMBOL_BIT,&theArg))
+     { return NULL; }
 
-   if (! UDFNthArgument(context,1,SYMBOL_BIT,&theArg))
-     { return; }
-
-   functionName = theArg.lexemeValue->contents;
-   functionReference = FunctionReferenceExpression(theEnv,functionName);
+   functionReference = FunctionReferenceExpression(theEnv,theArg.lexemeValue->contents);
    if (functionReference == NULL)
      {
-      ExpectedTypeError1(theEnv,"sort",1,"function name, deffunction name, or defgeneric name");
-      return;
+      ExpectedTypeError1(theEnv,sortFunctionName,whichArgument,"function name, deffunction name, or defgeneric name");
+      return NULL;
      }
 
    /*======================================*/
@@ -165,13 +296,15 @@ void SortFunction(
    if (functionReference->type == FCALL)
      {
       fptr = functionReference->functionValue;
-      if ((GetMinimumArgs(fptr) > 2) ||
-          (GetMaximumArgs(fptr) == 0) ||
-          (GetMaximumArgs(fptr) == 1))
+      if ((GetMinimumArgs(fptr) > argumentCount) ||
+          ((GetMaximumArgs(fptr) != UNBOUNDED) &&
+           (GetMaximumArgs(fptr) < argumentCount)))
         {
-         ExpectedTypeError1(theEnv,"sort",1,"function name expecting two arguments");
+         ExpectedTypeError1(theEnv,sortFunctionName,whichArgument,
+                            (argumentCount == 1) ? "function name expecting one argument" :
+                                                   "function name expecting two arguments");
          ReturnExpression(theEnv,functionReference);
-         return;
+         return NULL;
         }
      }
 
@@ -184,17 +317,134 @@ void SortFunction(
    if (functionReference->type == PCALL)
      {
       dptr = (Deffunction *) functionReference->value;
-      if ((dptr->minNumberOfParameters > 2) ||
-          (dptr->maxNumberOfParameters == 0) ||
-          (dptr->maxNumberOfParameters == 1))
+      if ((dptr->minNumberOfParameters > argumentCount) ||
+          ((dptr->maxNumberOfParameters != UNBOUNDED) &&
+           (dptr->maxNumberOfParameters < argumentCount)))
         {
-         ExpectedTypeError1(theEnv,"sort",1,"deffunction name expecting two arguments");
+         ExpectedTypeError1(theEnv,sortFunctionName,whichArgument,
+                            (argumentCount == 1) ? "deffunction name expecting one argument" :
+                                                   "deffunction name expecting two arguments");
          ReturnExpression(theEnv,functionReference);
-         return;
+         return NULL;
         }
      }
 #endif
 
+   return functionReference;
+  }
+
+/*************************************************************/
+/* EvaluateSortKey: Replaces a value to be sorted with the   */
+/*   key returned by calling the key function for the value. */
+/*   The value is kept in the supplemental information of    */
+/*   the key so it moves with the key as the list is sorted. */
+/*************************************************************/
+static bool EvaluateSortKey(
+  Environment *theEnv,
+  struct expr *keyReference,
+  UDFValue *theItem)
+  {
+   UDFValue keyValue;
+
+   keyReference->argList = GenConstant(theEnv,theItem->header->type,theItem->value);
+   ExpressionInstall(theEnv,keyReference);
+   EvaluateExpression(theEnv,keyReference,&keyValue);
+   ExpressionDeinstall(theEnv,keyReference);
+   ReturnExpression(theEnv,keyReference->argList);
+   keyReference->argList = NULL;
+
+   if (EvaluationData(theEnv)->EvaluationError)
+     { return false; }
+
+   if (keyValue.header->type == MULTIFIELD_TYPE)
+     {
+      PrintErrorID(theEnv,"SORTFUN",1,false);
+      PrintString(theEnv,WERROR,"The key function for sort-by-key must return a single field value.\n");
+      SetEvaluationError(theEnv,true);
+      return false;
+     }
+
+   theItem->supplementalInfo = theItem->value;
+   theItem->value = keyValue.value;
+   IncrementUDFValueReferenceCount(theEnv,theItem);
+
+   return true;
+  }
+
+/************************************/
+/* SortFunction: H/L access routine */
+/*   for the sort function.         */
+/************************************/
+void SortFunction(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   SortDriver(theEnv,context,returnValue,false);
+  }
+
+/*****************************************/
+/* SortByKeyFunction: H/L access routine */
+/*   for the sort-by-key function.       */
+/*****************************************/
+void SortByKeyFunction(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue)
+  {
+   SortDriver(theEnv,context,returnValue,true);
+  }
+
+/**************************************************************/
+/* SortDriver: Sorts the values passed to the sort function.  */
+/*   For the sort-by-key function, the key function is called */
+/*   once for each value and the keys are compared instead.   */
+/**************************************************************/
+static void SortDriver(
+  Environment *theEnv,
+  UDFContext *context,
+  UDFValue *returnValue,
+  bool useKeys)
+  {
+   long argumentCount, i, j, k = 0, keyCount = 0;
+   UDFValue *theArguments, *theArguments2;
+   Multifield *theMultifield, *tempMultifield;
+   const char *sortFunctionName;
+   struct expr *functionReference, *keyReference = NULL;
+   int argumentSize = 0;
+   int firstItem;
+   SortSwapFunction *swapFunction;
+
+   /*==================================*/
+   /* Set up the default return value. */
+   /*==================================*/
+
+   returnValue->lexemeValue = FalseSymbol(theEnv);
+
+   /*==============================================*/
+   /* Verify that the comparison and key functions */
+   /* exist and accept the number of arguments.    */
+   /*==============================================*/
+
+   sortFunctionName = useKeys ? "sort-by-key" : "sort";
+
+   functionReference = SortFunctionReference(theEnv,context,1,2,sortFunctionName);
+   if (functionReference == NULL)
+     { return; }
+
+   if (useKeys)
+     {
+      keyReference = SortFunctionReference(theEnv,context,2,1,sortFunctionName);
+      if (keyReference == NULL)
+        {
+         ReturnExpression(theEnv,functionReference);
+         return;
+        }
+      firstItem = 3;
+     }
+   else
+     { firstItem = 2; }
+
    /*=====================================*/
    /* If there are no items to be sorted, */
    /* then return an empty multifield.    */
@@ -202,10 +452,11 @@ void SortFunction(
 
    argumentCount = UDFArgumentCount(context);
 
-   if (argumentCount == 1)
+   if (argumentCount < firstItem)
      {
       SetMultifieldErrorValue(theEnv,returnValue);
       ReturnExpression(theEnv,functionReference);
+      ReturnExpression(theEnv,keyReference);
       return;
      }
 
@@ -214,23 +465,24 @@ void SortFunction(
    /* and determine how many there are.   */
    /*=====================================*/
 
-   theArguments = (UDFValue *) genalloc(theEnv,(argumentCount - 1) * sizeof(UDFValue));
+   theArguments = (UDFValue *) genalloc(theEnv,(argumentCount - firstItem + 1) * sizeof(UDFValue));
 
-   for (i = 2; i <= argumentCount; i++)
+   for (i = firstItem; i <= argumentCount; i++)
      {
-      UDFNthArgument(context,i,ANY_TYPE_BITS,&theArguments[i-2]);
+      UDFNthArgument(context,i,ANY_TYPE_BITS,&theArguments[i-firstItem]);
 
-      if (theArguments[i-2].header->type == MULTIFIELD_TYPE)
-        { argumentSize += theArguments[i-2].range; }
+      if (theArguments[i-firstItem].header->type == MULTIFIELD_TYPE)
+        { argumentSize += theArguments[i-firstItem].range; }
       else
         { argumentSize++; }
      }
 
    if (argumentSize == 0)
      {
-      genfree(theEnv,theArguments,(argumentCount - 1) * sizeof(UDFValue)); /* Bug Fix */
+      genfree(theEnv,theArguments,(argumentCount - firstItem + 1) * sizeof(UDFValue)); /* Bug Fix */
       SetMultifieldErrorValue(theEnv,returnValue);
       ReturnExpression(theEnv,functionReference);
+      ReturnExpression(theEnv,keyReference);
       return;
      }
 
@@ -241,40 +493,91 @@ void SortFunction(
 
    theArguments2 = (UDFValue *) genalloc(theEnv,argumentSize * sizeof(UDFValue));
 
-   for (i = 2; i <= argumentCount; i++)
+   for (i = firstItem; i <= argumentCount; i++)
      {
-      if (theArguments[i-2].header->type == MULTIFIELD_TYPE)
+      if (theArguments[i-firstItem].header->type == MULTIFIELD_TYPE)
         {
-         tempMultifield = theArguments[i-2].multifieldValue;
-         for (j = theArguments[i-2].begin; j < (theArguments[i-2].begin + theArguments[i-2].range); j++, k++)
+         tempMultifield = theArguments[i-firstItem].multifieldValue;
+         for (j = theArguments[i-firstItem].begin; j < (theArguments[i-firstItem].begin + theArguments[i-firstItem].range); j++, k++)
            {
             theArguments2[k].value = tempMultifield->contents[j].value;
            }
         }
       else
         {
-         theArguments2[k].value = theArguments[i-2].value;
+         theArguments2[k].value = theArguments[i-firstItem].value;
          k++;
         }
      }
 
-   genfree(theEnv,theArguments,(argumentCount - 1) * sizeof(UDFValue));
-
-   functionReference->nextArg = SortFunctionData(theEnv)->SortComparisonFunction;
-   SortFunctionData(theEnv)->SortComparisonFunction = functionReference;
+   genfree(theEnv,theArguments,(argumentCount - firstItem + 1) * sizeof(UDFValue));
 
    for (i = 0; i < argumentSize; i++)
      { IncrementUDFValueReferenceCount(theEnv,&theArguments2[i]); }
 
-   MergeSort(theEnv,(unsigned long) argumentSize,theArguments2,DefaultCompareSwapFunction);
+   /*=====================================================*/
+   /* Call the key function once for each item. The items */
+   /* are then sorted by comparing their keys.            */
+   /*=====================================================*/
 
-   for (i = 0; i < argumentSize; i++)
-     { DecrementUDFValueReferenceCount(theEnv,&theArguments2[i]); }
+   if (useKeys)
+     {
+      for (keyCount = 0; keyCount < argumentSize; keyCount++)
+        {
+         if (! EvaluateSortKey(theEnv,keyReference,&theArguments2[keyCount]))
+           { break; }
+        }
+
+      ReturnExpression(theEnv,keyReference);
+     }
+
+   /*==========================================*/
+   /* Use a native comparison if the function  */
+   /* is a numeric comparison of numbers only. */
+   /*==========================================*/
+
+   if ((! useKeys) || (keyCount == argumentSize))
+     {
+      swapFunction = NativeSwapFunction(theEnv,functionReference,theArguments2,argumentSize);
+      if (swapFunction == NULL)
+        {
+         functionReference->nextArg = SortFunctionData(theEnv)->SortComparisonFunction;
+         SortFunctionData(theEnv)->SortComparisonFunction = functionReference;
+
+         MergeSort(theEnv,(unsigned long) argumentSize,theArguments2,DefaultCompareSwapFunction);
+
+         SortFunctionData(theEnv)->SortComparisonFunction = SortFunctionData(theEnv)->SortComparisonFunction->nextArg;
+         functionReference->nextArg = NULL;
+        }
+      else
+        { MergeSort(theEnv,(unsigned long) argumentSize,theArguments2,swapFunction); }
+     }
 
-   SortFunctionData(theEnv)->SortComparisonFunction = SortFunctionData(theEnv)->SortComparisonFunction->nextArg;
-   functionReference->nextArg = NULL;
    ReturnExpression(theEnv,functionReference);
 
+   /*===================================*/
+   /* Release the keys and the items. A */
+   /* key which couldn't be evaluated   */
+   /* leaves the item in its place.     */
+   /*===================================*/
+
+   for (i = 0; i < argumentSize; i++)
+     {
+      if (i < keyCount)
+        {
+         DecrementUDFValueReferenceCount(theEnv,&theArguments2[i]);
+         theArguments2[i].value = theArguments2[i].supplementalInfo;
+        }
+
+      DecrementUDFValueReferenceCount(theEnv,&theArguments2[i]);
+     }
+
+   if (useKeys && (keyCount != argumentSize))
+     {
+      genfree(theEnv,theArguments2,argumentSize * sizeof(UDFValue));
+      return;
+     }
+
    theMultifield = CreateMultifield(theEnv,(unsigned long) argumentSize);
 
    for (i = 0; i < argumentSize; i++)
@@ -298,7 +601,7 @@ void MergeSort(
   Environment *theEnv,
   unsigned long listSize,
   UDFValue *theList,
-  bool (*swapFunction)(Environment *,UDFValue *,UDFValue *))
+  SortSwapFunction *swapFunction)
   {
    UDFValue *tempList;
    unsigned long middle;
@@ -340,7 +643,7 @@ static void DoMergeSort(
   unsigned long e1,
   unsigned long s2,
   unsigned long e2,
-  bool (*swapFunction)(Environment *,UDFValue *,UDFValue *))
+  SortSwapFunction *swapFunction)
   {
    UDFValue temp;
    unsigned long middle, size;
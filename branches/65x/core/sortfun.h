@@ -36,6 +36,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added sort-by-key function.                    */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_sortfun
@@ -44,10 +46,12 @@
 
 #define _H_sortfun
 
+typedef bool SortSwapFunction(Environment *,UDFValue *,UDFValue *);
+
    void                           SortFunctionDefinitions(Environment *);
-   void                           MergeSort(Environment *,unsigned long,UDFValue *,
-                                            bool (*)(Environment *,UDFValue *,UDFValue *));
+   void                           MergeSort(Environment *,unsigned long,UDFValue *,SortSwapFunction *);
    void                           SortFunction(Environment *,UDFContext *,UDFValue *);
+   void                           SortByKeyFunction(Environment *,UDFContext *,UDFValue *);
 
 #endif /* _H_sortfun */
 
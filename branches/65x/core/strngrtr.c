@@ -35,6 +35,9 @@
 /*                                                           */
 /*            Changed return values for router functions.    */
 /*                                                           */
+/*      6.50: Opening and closing string routers invalidates */
+/*            the router cache.                              */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -292,6 +295,8 @@ static bool CreateReadStringSource(
    newStringRouter->next = StringRouterData(theEnv)->ListOfStringRouters;
    StringRouterData(theEnv)->ListOfStringRouters = newStringRouter;
 
+   InvalidateRouterCache(theEnv);
+
    return true;
   }
 
@@ -313,6 +318,7 @@ bool CloseStringSource(
          if (last == NULL)
            {
             StringRouterData(theEnv)->ListOfStringRouters = head->next;
+            InvalidateRouterCache(theEnv);
             rm(theEnv,(void *) head->name,strlen(head->name) + 1);
             rtn_struct(theEnv,stringRouter,head);
             return true;
@@ -320,6 +326,7 @@ bool CloseStringSource(
          else
            {
             last->next = head->next;
+            InvalidateRouterCache(theEnv);
             rm(theEnv,(void *) head->name,strlen(head->name) + 1);
             rtn_struct(theEnv,stringRouter,head);
             return true;
@@ -358,6 +365,8 @@ bool OpenStringDestination(
    newStringRouter->next = StringRouterData(theEnv)->ListOfStringRouters;
    StringRouterData(theEnv)->ListOfStringRouters = newStringRouter;
 
+   InvalidateRouterCache(theEnv);
+
    return true;
   }
 
@@ -413,6 +422,8 @@ bool OpenStringBuilderDestination(
    newStringRouter->next = StringRouterData(theEnv)->ListOfStringBuilderRouters;
    StringRouterData(theEnv)->ListOfStringBuilderRouters = newStringRouter;
 
+   InvalidateRouterCache(theEnv);
+
    return true;
   }
 
@@ -435,6 +446,7 @@ bool CloseStringBuilderDestination(
          if (last == NULL)
            {
             StringRouterData(theEnv)->ListOfStringBuilderRouters = head->next;
+            InvalidateRouterCache(theEnv);
             rm(theEnv,(void *) head->name,strlen(head->name) + 1);
             rtn_struct(theEnv,stringBuilderRouter,head);
             return true;
@@ -442,6 +454,7 @@ bool CloseStringBuilderDestination(
          else
            {
             last->next = head->next;
+            InvalidateRouterCache(theEnv);
             rm(theEnv,(void *) head->name,strlen(head->name) + 1);
             rtn_struct(theEnv,stringBuilderRouter,head);
             return true;
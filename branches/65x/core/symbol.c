@@ -68,6 +68,15 @@
 /*                                                           */
 /*            ALLOW_ENVIRONMENT_GLOBALS no longer supported. */
 /*                                                           */
+/*      6.50: Ephemeral atoms are counted per garbage frame  */
+/*            and reclaimed atoms are added to the garbage   */
+/*            statistics.                                    */
+/*                                                           */
+/*            Small integers are preallocated when the atom  */
+/*            tables are initialized so that CreateInteger   */
+/*            can return them without hashing or creating    */
+/*            an ephemeral integer.                          */
+/*                                                           */
 /*************************************************************/
 
 #include <stdio.h>
@@ -108,12 +117,13 @@
    static void                    RemoveHashNode(Environment *,GENERIC_HN *,GENERIC_HN **,int,int);
    static void                    AddEphemeralHashNode(Environment *,GENERIC_HN *,struct ephemeron **,
                                                        int,int,bool);
-   static void                    RemoveEphemeralHashNodes(Environment *,struct ephemeron **,
+   static unsigned long           RemoveEphemeralHashNodes(Environment *,struct ephemeron **,
                                                            GENERIC_HN **,
                                                            int,int,int);
    static const char             *StringWithinString(const char *,const char *);
    static size_t                  CommonPrefixLength(const char *,const char *);
    static void                    DeallocateSymbolData(Environment *);
+   static void                    RefreshSmallIntegers(Environment *);
 
 /*******************************************************/
 /* InitializeAtomTables: Initializes the SymbolTable,  */
@@ -136,6 +146,9 @@ void InitializeAtomTables(
 #pragma unused(externalAddressTable)
 #endif
    unsigned long i;
+#if ! RUN_TIME
+   long long theInteger;
+#endif
 
    AllocateEnvironmentData(theEnv,SYMBOL_DATA,sizeof(struct symbolData),DeallocateSymbolData);
 
@@ -183,6 +196,19 @@ void InitializeAtomTables(
    IncrementLexemeCount(SymbolData(theEnv)->NegativeInfinity);
    SymbolData(theEnv)->Zero = CreateInteger(theEnv,0LL);
    IncrementIntegerCount(SymbolData(theEnv)->Zero);
+
+   /*==========================================================*/
+   /* Preallocate the small integers. Each is given a count so */
+   /* that it is never reclaimed and is then placed in a table */
+   /* indexed by value which CreateInteger checks first.       */
+   /*==========================================================*/
+
+   for (theInteger = SMALL_INTEGER_MINIMUM; theInteger <= SMALL_INTEGER_MAXIMUM; theInteger++)
+     {
+      CLIPSInteger *smallInteger = CreateInteger(theEnv,theInteger);
+      IncrementIntegerCount(smallInteger);
+      SymbolData(theEnv)->SmallIntegers[theInteger - SMALL_INTEGER_MINIMUM] = smallInteger;
+     }
 #else
    SetSymbolTable(theEnv,symbolTable);
    SetFloatTable(theEnv,floatTable);
@@ -231,6 +257,7 @@ static void DeallocateSymbolData(
          nextSHPtr = shPtr->next;
          if (! shPtr->permanent)
            {
+            UpdateSubsystemMemory(theEnv,ATOM_MEMORY,- (long) (sizeof(CLIPSLexeme) + strlen(shPtr->contents) + 1));
             rm(theEnv,(void *) shPtr->contents,strlen(shPtr->contents)+1);
             rtn_struct(theEnv,clipsLexeme,shPtr);
            }
@@ -246,7 +273,10 @@ static void DeallocateSymbolData(
         {
          nextFHPtr = fhPtr->next;
          if (! fhPtr->permanent)
-           { rtn_struct(theEnv,clipsFloat,fhPtr); }
+           {
+            UpdateSubsystemMemory(theEnv,ATOM_MEMORY,- (long) sizeof(CLIPSFloat));
+            rtn_struct(theEnv,clipsFloat,fhPtr);
+           }
          fhPtr = nextFHPtr;
         }
      }
@@ -259,7 +289,10 @@ static void DeallocateSymbolData(
         {
          nextIHPtr = ihPtr->next;
          if (! ihPtr->permanent)
-           { rtn_struct(theEnv,clipsInteger,ihPtr); }
+           {
+            UpdateSubsystemMemory(theEnv,ATOM_MEMORY,- (long) sizeof(CLIPSInteger));
+            rtn_struct(theEnv,clipsInteger,ihPtr);
+           }
          ihPtr = nextIHPtr;
         }
      }
@@ -273,6 +306,7 @@ static void DeallocateSymbolData(
          nextBMHPtr = bmhPtr->next;
          if (! bmhPtr->permanent)
            {
+            UpdateSubsystemMemory(theEnv,ATOM_MEMORY,- (long) (sizeof(CLIPSBitMap) + bmhPtr->size));
             rm(theEnv,(void *) bmhPtr->contents,bmhPtr->size);
             rtn_struct(theEnv,clipsBitMap,bmhPtr);
            }
@@ -289,6 +323,7 @@ static void DeallocateSymbolData(
          nextEAHPtr = eahPtr->next;
          if (! eahPtr->permanent)
            {
+            UpdateSubsystemMemory(theEnv,ATOM_MEMORY,- (long) sizeof(CLIPSExternalAddress));
             rtn_struct(theEnv,clipsExternalAddress,eahPtr);
            }
          eahPtr = nextEAHPtr;
@@ -428,6 +463,7 @@ CLIPSLexeme *AddSymbol(
     length = strlen(str) + 1;
     buffer = (char *) gm2(theEnv,length);
     genstrcpy(buffer,str);
+    UpdateSubsystemMemory(theEnv,ATOM_MEMORY,(long) (sizeof(CLIPSLexeme) + length));
     peek->contents = buffer;
     peek->next = NULL;
     peek->bucket = tally;
@@ -516,6 +552,7 @@ CLIPSFloat *CreateFloat(
     /*=================================================*/
 
     peek = get_struct(theEnv,clipsFloat);
+    UpdateSubsystemMemory(theEnv,ATOM_MEMORY,(long) sizeof(CLIPSFloat));
 
     if (past == NULL) SymbolData(theEnv)->FloatTable[tally] = peek;
     else past->next = peek;
@@ -555,6 +592,18 @@ CLIPSInteger *CreateInteger(
    unsigned long tally;
    CLIPSInteger *past = NULL, *peek;
 
+    /*=============================================*/
+    /* Small integers are permanently allocated    */
+    /* and can be returned directly from the table */
+    /* without searching the hash table.           */
+    /*=============================================*/
+
+    if ((number >= SMALL_INTEGER_MINIMUM) && (number <= SMALL_INTEGER_MAXIMUM))
+      {
+       peek = SymbolData(theEnv)->SmallIntegers[number - SMALL_INTEGER_MINIMUM];
+       if (peek != NULL) return peek;
+      }
+
     /*==================================*/
     /* Get the hash value for the long. */
     /*==================================*/
@@ -582,6 +631,7 @@ CLIPSInteger *CreateInteger(
     /*================================================*/
 
     peek = get_struct(theEnv,clipsInteger);
+    UpdateSubsystemMemory(theEnv,ATOM_MEMORY,(long) sizeof(CLIPSInteger));
     if (past == NULL) SymbolData(theEnv)->IntegerTable[tally] = peek;
     else past->next = peek;
 
@@ -689,6 +739,7 @@ void *AddBitMap(
 
     buffer = (char *) gm2(theEnv,size);
     for (i = 0; i < size ; i++) buffer[i] = theBitMap[i];
+    UpdateSubsystemMemory(theEnv,ATOM_MEMORY,(long) (sizeof(CLIPSBitMap) + size));
     peek->contents = buffer;
     peek->next = NULL;
     peek->bucket = tally;
@@ -757,6 +808,7 @@ CLIPSExternalAddress *CreateExternalAddress(
     /*=================================================*/
 
     peek = get_struct(theEnv,clipsExternalAddress);
+    UpdateSubsystemMemory(theEnv,ATOM_MEMORY,(long) sizeof(CLIPSExternalAddress));
     if (past == NULL) SymbolData(theEnv)->ExternalAddressTable[tally] = peek;
     else past->next = peek;
 
@@ -1190,13 +1242,17 @@ static void RemoveHashNode(
    /* use to store the character or bitmap string.    */
    /*=================================================*/
 
+   UpdateSubsystemMemory(theEnv,ATOM_MEMORY,- (long) size);
+
    if (type == SYMBOL_TYPE)
      {
+      UpdateSubsystemMemory(theEnv,ATOM_MEMORY,- (long) (strlen(((CLIPSLexeme *) theValue)->contents) + 1));
       rm(theEnv,(void *) ((CLIPSLexeme *) theValue)->contents,
          strlen(((CLIPSLexeme *) theValue)->contents) + 1);
      }
    else if (type == BITMAPARRAY)
      {
+      UpdateSubsystemMemory(theEnv,ATOM_MEMORY,- (long) ((CLIPSBitMap *) theValue)->size);
       rm(theEnv,(void *) ((CLIPSBitMap *) theValue)->contents,
          ((CLIPSBitMap *) theValue)->size);
      }
@@ -1259,6 +1315,8 @@ static void AddEphemeralHashNode(
    temp->associatedValue = theHashNode;
    temp->next = *theEphemeralList;
    *theEphemeralList = temp;
+
+   UtilityData(theEnv)->CurrentGarbageFrame->ephemeralCount++;
   }
 
 /***************************************************/
@@ -1271,20 +1329,23 @@ void RemoveEphemeralAtoms(
   Environment *theEnv)
   {
    struct garbageFrame *theGarbageFrame;
+   unsigned long removed;
 
    theGarbageFrame = UtilityData(theEnv)->CurrentGarbageFrame;
    if (! theGarbageFrame->dirty) return;
 
-   RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralSymbolList,(GENERIC_HN **) SymbolData(theEnv)->SymbolTable,
-                            sizeof(CLIPSLexeme),SYMBOL_TYPE,AVERAGE_STRING_SIZE);
-   RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralFloatList,(GENERIC_HN **) SymbolData(theEnv)->FloatTable,
-                            sizeof(CLIPSFloat),FLOAT_TYPE,0);
-   RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralIntegerList,(GENERIC_HN **) SymbolData(theEnv)->IntegerTable,
-                            sizeof(CLIPSInteger),INTEGER_TYPE,0);
-   RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralBitMapList,(GENERIC_HN **) SymbolData(theEnv)->BitMapTable,
-                            sizeof(CLIPSBitMap),BITMAPARRAY,AVERAGE_BITMAP_SIZE);
-   RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralExternalAddressList,(GENERIC_HN **) SymbolData(theEnv)->ExternalAddressTable,
-                            sizeof(CLIPSExternalAddress),EXTERNAL_ADDRESS_TYPE,0);
+   removed = RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralSymbolList,(GENERIC_HN **) SymbolData(theEnv)->SymbolTable,
+                                      sizeof(CLIPSLexeme),SYMBOL_TYPE,AVERAGE_STRING_SIZE);
+   removed += RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralFloatList,(GENERIC_HN **) SymbolData(theEnv)->FloatTable,
+                                       sizeof(CLIPSFloat),FLOAT_TYPE,0);
+   removed += RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralIntegerList,(GENERIC_HN **) SymbolData(theEnv)->IntegerTable,
+                                       sizeof(CLIPSInteger),INTEGER_TYPE,0);
+   removed += RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralBitMapList,(GENERIC_HN **) SymbolData(theEnv)->BitMapTable,
+                                       sizeof(CLIPSBitMap),BITMAPARRAY,AVERAGE_BITMAP_SIZE);
+   removed += RemoveEphemeralHashNodes(theEnv,&theGarbageFrame->ephemeralExternalAddressList,(GENERIC_HN **) SymbolData(theEnv)->ExternalAddressTable,
+                                       sizeof(CLIPSExternalAddress),EXTERNAL_ADDRESS_TYPE,0);
+
+   UtilityData(theEnv)->GarbageStats.atomsReclaimed += removed;
   }
 
 /***********************************************/
@@ -1360,7 +1421,7 @@ void EphemerateValue(
 /*   this routine needs to check through both the previous and  */
 /*   current evaluation depth.                                  */
 /****************************************************************/
-static void RemoveEphemeralHashNodes(
+static unsigned long RemoveEphemeralHashNodes(
   Environment *theEnv,
   struct ephemeron **theEphemeralList,
   GENERIC_HN **theTable,
@@ -1369,6 +1430,7 @@ static void RemoveEphemeralHashNodes(
   int averageContentsSize)
   {
    struct ephemeron *edPtr, *lastPtr = NULL, *nextPtr;
+   unsigned long removed = 0;
 
    edPtr = *theEphemeralList;
 
@@ -1394,6 +1456,7 @@ static void RemoveEphemeralHashNodes(
          rtn_struct(theEnv,ephemeron,edPtr);
          if (lastPtr == NULL) *theEphemeralList = nextPtr;
          else lastPtr->next = nextPtr;
+         removed++;
         }
 
       /*=======================================*/
@@ -1420,6 +1483,8 @@ static void RemoveEphemeralHashNodes(
 
       edPtr = nextPtr;
      }
+
+   return removed;
   }
 
 /*********************************************************/
@@ -1530,6 +1595,23 @@ void RefreshSpecialSymbols(
    SymbolData(theEnv)->PositiveInfinity = FindSymbolHN(theEnv,POSITIVE_INFINITY_STRING,SYMBOL_BIT);
    SymbolData(theEnv)->NegativeInfinity = FindSymbolHN(theEnv,NEGATIVE_INFINITY_STRING,SYMBOL_BIT);
    SymbolData(theEnv)->Zero = FindLongHN(theEnv,0L);
+   RefreshSmallIntegers(theEnv);
+  }
+
+/**************************************************************/
+/* RefreshSmallIntegers: Resets the table of small integers   */
+/*   from the integer hash table. Used when the atom tables   */
+/*   have been replaced by precompiled tables. Values missing */
+/*   from the hash table are left as NULL and are created     */
+/*   through the hash table by CreateInteger as needed.       */
+/**************************************************************/
+static void RefreshSmallIntegers(
+  Environment *theEnv)
+  {
+   long long theInteger;
+
+   for (theInteger = SMALL_INTEGER_MINIMUM; theInteger <= SMALL_INTEGER_MAXIMUM; theInteger++)
+     { SymbolData(theEnv)->SmallIntegers[theInteger - SMALL_INTEGER_MINIMUM] = FindLongHN(theEnv,theInteger); }
   }
 
 /***********************************************************/
@@ -74,6 +74,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Added a preallocated table of small integers.  */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_symbol
@@ -108,6 +110,16 @@ typedef struct genericHashNode GENERIC_HN;
 #define EXTERNAL_ADDRESS_HASH_SIZE        8191
 #endif
 
+#ifndef SMALL_INTEGER_MINIMUM
+#define SMALL_INTEGER_MINIMUM   -128
+#endif
+
+#ifndef SMALL_INTEGER_MAXIMUM
+#define SMALL_INTEGER_MAXIMUM   1023
+#endif
+
+#define SMALL_INTEGER_COUNT (SMALL_INTEGER_MAXIMUM - SMALL_INTEGER_MINIMUM + 1)
+
 /******************************/
 /* genericHashNode STRUCTURE: */
 /******************************/
@@ -165,6 +177,7 @@ struct symbolData
    CLIPSLexeme *PositiveInfinity;
    CLIPSLexeme *NegativeInfinity;
    CLIPSInteger *Zero;
+   CLIPSInteger *SmallIntegers[SMALL_INTEGER_COUNT];
    CLIPSLexeme **SymbolTable;
    CLIPSFloat **FloatTable;
    CLIPSInteger **IntegerTable;
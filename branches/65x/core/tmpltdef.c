@@ -55,6 +55,9 @@
 /*                                                           */
 /*            ALLOW_ENVIRONMENT_GLOBALS no longer supported. */
 /*                                                           */
+/*      6.50: Removing a deftemplate discards the reset      */
+/*            snapshot.                                      */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -72,6 +75,7 @@
 #include "modulutl.h"
 #include "network.h"
 #include "router.h"
+#include "rsetsnap.h"
 #include "tmpltbsc.h"
 #include "tmpltfun.h"
 #include "tmpltpsr.h"
@@ -321,6 +325,10 @@ static void ReturnDeftemplate(
 
    if (theDeftemplate == NULL) return;
 
+#if DEFRULE_CONSTRUCT
+   DiscardResetSnapshot(theEnv);
+#endif
+
    /*====================================================================*/
    /* If a template is redefined, then we want to save its debug status. */
    /*====================================================================*/
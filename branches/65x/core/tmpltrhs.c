@@ -35,6 +35,8 @@
 /*                                                           */
 /*            UDF redesign.                                  */
 /*                                                           */
+/*      6.50: Uses RequiredSlotValueError.                   */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -517,10 +519,7 @@ static struct expr *GetSlotAssertValues(
 
       if (slotPtr->noDefault)
         {
-         PrintErrorID(theEnv,"TMPLTRHS",1,true);
-         PrintString(theEnv,WERROR,"Slot ");
-         PrintString(theEnv,WERROR,slotPtr->slotName->contents);
-         PrintString(theEnv,WERROR," requires a value because of its (default ?NONE) attribute.\n");
+         RequiredSlotValueError(theEnv,slotPtr->slotName->contents);
          *error = true;
          return NULL;
         }
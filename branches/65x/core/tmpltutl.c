@@ -55,6 +55,9 @@
 /*            Watch facts for modify command only prints     */
 /*            changed slots.                                 */
 /*                                                           */
+/*      6.50: Added RequiredSlotValueError and               */
+/*            CheckLiteralSlotValues.                        */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -124,6 +127,21 @@ void SingleFieldSlotCardinalityError(
    PrintString(theEnv,WERROR," can only contain a single field value.\n");
   }
 
+/********************************************************/
+/* RequiredSlotValueError: Error message used when no   */
+/*   value is supplied for a slot with the (default     */
+/*   ?NONE) attribute.                                  */
+/********************************************************/
+void RequiredSlotValueError(
+  Environment *theEnv,
+  const char *slotName)
+  {
+   PrintErrorID(theEnv,"TMPLTRHS",1,true);
+   PrintString(theEnv,WERROR,"Slot ");
+   PrintString(theEnv,WERROR,slotName);
+   PrintString(theEnv,WERROR," requires a value because of its (default ?NONE) attribute.\n");
+  }
+
 /**********************************************************************/
 /* MultiIntoSingleFieldSlotError: Determines if a multifield value is */
 /*   being placed into a single field slot of a deftemplate fact.     */
@@ -254,6 +272,46 @@ bool CheckRHSSlotTypes(
    return true;
   }
 
+/******************************************************************/
+/* CheckLiteralSlotValues: Checks the validity of an array of     */
+/*   literal values to be stored in a slot. Produces the same     */
+/*   error messages as CheckRHSSlotTypes for the equivalent chain */
+/*   of constant expressions.                                     */
+/******************************************************************/
+bool CheckLiteralSlotValues(
+  Environment *theEnv,
+  CLIPSValue *theValues,
+  size_t valueCount,
+  struct templateSlot *slotPtr,
+  const char *thePlace)
+  {
+   int rv = NO_VIOLATION;
+   size_t i;
+   const char *theName;
+
+   if (! CheckCardinalityConstraint(theEnv,(long) valueCount,slotPtr->constraints))
+     { rv = CARDINALITY_VIOLATION; }
+   else
+     {
+      for (i = 0; (i < valueCount) && (rv == NO_VIOLATION); i++)
+        {
+         rv = ConstraintCheckValue(theEnv,theValues[i].header->type,
+                                   theValues[i].value,slotPtr->constraints);
+        }
+     }
+
+   if (rv != NO_VIOLATION)
+     {
+      if (rv != CARDINALITY_VIOLATION) theName = "A literal slot value";
+      else theName = "Literal slot values";
+      ConstraintViolationErrorMessage(theEnv,theName,thePlace,true,0,
+                                      slotPtr->slotName,0,rv,slotPtr->constraints,true);
+      return false;
+     }
+
+   return true;
+  }
+
 /*********************************************************/
 /* GetNthSlot: Given a deftemplate and an integer index, */
 /*   returns the nth slot of a deftemplate.              */
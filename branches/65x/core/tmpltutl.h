@@ -46,6 +46,9 @@
 /*            Watch facts for modify command only prints     */
 /*            changed slots.                                 */
 /*                                                           */
+/*      6.50: Added RequiredSlotValueError and               */
+/*            CheckLiteralSlotValues.                        */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_tmpltutl
@@ -62,9 +65,11 @@
 
    void                           InvalidDeftemplateSlotMessage(Environment *,const char *,const char *,bool);
    void                           SingleFieldSlotCardinalityError(Environment *,const char *);
+   void                           RequiredSlotValueError(Environment *,const char *);
    void                           MultiIntoSingleFieldSlotError(Environment *,struct templateSlot *,Deftemplate *);
    void                           CheckTemplateFact(Environment *,Fact *);
    bool                           CheckRHSSlotTypes(Environment *,struct expr *,struct templateSlot *,const char *);
+   bool                           CheckLiteralSlotValues(Environment *,CLIPSValue *,size_t,struct templateSlot *,const char *);
    struct templateSlot           *GetNthSlot(Deftemplate *,int);
    int                            FindSlotPosition(Deftemplate *,CLIPSLexeme *);
    void                           PrintTemplateFact(Environment *,const char *,Fact *,bool,bool,const char *);
@@ -66,6 +66,11 @@
 /*                                                           */
 /*            Added StringBuilder functions.                 */
 /*                                                           */
+/*      6.50: Added SweepCurrentGarbageFrame so that loops   */
+/*            such as rule execution can defer garbage       */
+/*            collection to a tunable interval. Sweeps keep  */
+/*            reclamation statistics.                        */
+/*                                                           */
 /*************************************************************/
 
 #include "setup.h"
@@ -98,6 +103,7 @@
 /***************************************/
 
    static void                    DeallocateUtilityData(Environment *);
+   static void                    SweepGarbageFrame(Environment *,struct garbageFrame *);
 
 /************************************************/
 /* InitializeUtilityData: Allocates environment */
@@ -114,6 +120,9 @@ void InitializeUtilityData(
    UtilityData(theEnv)->GarbageCollectionLocks = 0;
    UtilityData(theEnv)->PeriodicFunctionsEnabled = true;
    UtilityData(theEnv)->YieldFunctionEnabled = true;
+
+   UtilityData(theEnv)->GarbageSweepInterval = DEFAULT_GARBAGE_SWEEP_INTERVAL;
+   UtilityData(theEnv)->GarbageSweepThreshold = DEFAULT_GARBAGE_SWEEP_THRESHOLD;
   }
 
 /**************************************************/
@@ -234,9 +243,7 @@ void CleanCurrentGarbageFrame(
    if (returnValue != NULL)
      { IncrementUDFValueReferenceCount(theEnv,returnValue); }
 
-   CallCleanupFunctions(theEnv);
-   RemoveEphemeralAtoms(theEnv);
-   FlushMultifields(theEnv);
+   SweepGarbageFrame(theEnv,currentGarbageFrame);
 
    if (returnValue != NULL)
      { DecrementUDFValueReferenceCount(theEnv,returnValue); }
@@ -250,6 +257,135 @@ void CleanCurrentGarbageFrame(
      { currentGarbageFrame->dirty = false; }
   }
 
+/*****************************************************/
+/* SweepCurrentGarbageFrame: Cleans the current      */
+/*   garbage frame once the sweep interval has been  */
+/*   reached or once the number of ephemeral values  */
+/*   added to the frame exceeds the sweep threshold. */
+/*   Used in place of CleanCurrentGarbageFrame by    */
+/*   loops such as rule execution where a full sweep */
+/*   on every iteration would dominate the cost of   */
+/*   the iteration and where atoms discarded in one  */
+/*   iteration are likely to be recreated in the     */
+/*   next. The frame must still be cleaned (or       */
+/*   restored) when the loop completes.              */
+/*****************************************************/
+void SweepCurrentGarbageFrame(
+  Environment *theEnv,
+  UDFValue *returnValue)
+  {
+   struct garbageFrame *currentGarbageFrame;
+
+   currentGarbageFrame = UtilityData(theEnv)->CurrentGarbageFrame;
+
+   if (! currentGarbageFrame->dirty) return;
+
+   currentGarbageFrame->deferredSweeps++;
+
+   if ((currentGarbageFrame->deferredSweeps < UtilityData(theEnv)->GarbageSweepInterval) &&
+       (currentGarbageFrame->ephemeralCount < UtilityData(theEnv)->GarbageSweepThreshold))
+     { return; }
+
+   CleanCurrentGarbageFrame(theEnv,returnValue);
+  }
+
+/*****************************************************/
+/* SweepGarbageFrame: Removes the garbage facts and  */
+/*   instances, ephemeral atoms, and multifields of  */
+/*   a garbage frame and updates the statistics for  */
+/*   the number of values reclaimed.                 */
+/*****************************************************/
+static void SweepGarbageFrame(
+  Environment *theEnv,
+  struct garbageFrame *theGarbageFrame)
+  {
+   GarbageStatistics *theStats = &UtilityData(theEnv)->GarbageStats;
+   unsigned long long atoms, multifields;
+
+   atoms = theStats->atomsReclaimed;
+   multifields = theStats->multifieldsReclaimed;
+
+   CallCleanupFunctions(theEnv);
+   RemoveEphemeralAtoms(theEnv);
+   FlushMultifields(theEnv);
+
+   theStats->sweeps++;
+   theStats->lastAtomsReclaimed = (unsigned long) (theStats->atomsReclaimed - atoms);
+   theStats->lastMultifieldsReclaimed = (unsigned long) (theStats->multifieldsReclaimed - multifields);
+
+   theGarbageFrame->ephemeralCount = 0;
+   theGarbageFrame->deferredSweeps = 0;
+  }
+
+/************************************************/
+/* SetGarbageSweepInterval: Sets the number of  */
+/*   iterations (such as rule firings) between  */
+/*   sweeps of the current garbage frame. A     */
+/*   value of 1 (or 0) sweeps on every          */
+/*   iteration. Returns the previous interval.  */
+/************************************************/
+unsigned long SetGarbageSweepInterval(
+  Environment *theEnv,
+  unsigned long value)
+  {
+   unsigned long ov = UtilityData(theEnv)->GarbageSweepInterval;
+
+   UtilityData(theEnv)->GarbageSweepInterval = value;
+
+   return ov;
+  }
+
+/***********************************************/
+/* GetGarbageSweepInterval: Returns the number */
+/*   of iterations between garbage sweeps.     */
+/***********************************************/
+unsigned long GetGarbageSweepInterval(
+  Environment *theEnv)
+  {
+   return UtilityData(theEnv)->GarbageSweepInterval;
+  }
+
+/************************************************/
+/* SetGarbageSweepThreshold: Sets the number of */
+/*   ephemeral values which can accumulate in a */
+/*   garbage frame before a sweep is forced     */
+/*   regardless of the sweep interval. Returns  */
+/*   the previous threshold.                    */
+/************************************************/
+unsigned long SetGarbageSweepThreshold(
+  Environment *theEnv,
+  unsigned long value)
+  {
+   unsigned long ov = UtilityData(theEnv)->GarbageSweepThreshold;
+
+   UtilityData(theEnv)->GarbageSweepThreshold = value;
+
+   return ov;
+  }
+
+/**************************************************/
+/* GetGarbageSweepThreshold: Returns the number   */
+/*   of ephemeral values which force a sweep.     */
+/**************************************************/
+unsigned long GetGarbageSweepThreshold(
+  Environment *theEnv)
+  {
+   return UtilityData(theEnv)->GarbageSweepThreshold;
+  }
+
+/**************************************************/
+/* GetGarbageStatistics: Returns the number of    */
+/*   garbage sweeps and the number of atoms and   */
+/*   multifields reclaimed, both in total and by  */
+/*   the most recent sweep.                       */
+/**************************************************/
+void GetGarbageStatistics(
+  Environment *theEnv,
+  GarbageStatistics *theStats)
+  {
+   *theStats = UtilityData(theEnv)->GarbageStats;
+  }
+
 /*****************************/
 /* RestorePriorGarbageFrame: */
 /*****************************/
@@ -262,9 +398,7 @@ void RestorePriorGarbageFrame(
    if (newGarbageFrame->dirty)
      {
       if (returnValue != NULL) IncrementUDFValueReferenceCount(theEnv,returnValue);
-      CallCleanupFunctions(theEnv);
-      RemoveEphemeralAtoms(theEnv);
-      FlushMultifields(theEnv);
+      SweepGarbageFrame(theEnv,newGarbageFrame);
      }
 
    UtilityData(theEnv)->CurrentGarbageFrame = oldGarbageFrame;
@@ -63,6 +63,9 @@
 /*                                                           */
 /*            Added StringBuilder functions.                 */
 /*                                                           */
+/*      6.50: Garbage frames can be swept at a tunable       */
+/*            interval and keep reclamation statistics.      */
+/*                                                           */
 /*************************************************************/
 
 #ifndef _H_utility
@@ -87,6 +90,7 @@ typedef struct voidCallFunctionItem VoidCallFunctionItem;
 
 typedef struct clipsBlock CLIPSBlock;
 typedef struct stringBuilder StringBuilder;
+typedef struct garbageStatistics GarbageStatistics;
 
 struct voidCallFunctionItem
   {
@@ -135,6 +139,8 @@ struct garbageFrame
    struct ephemeron *ephemeralExternalAddressList;
    Multifield *ListOfMultifields;
    Multifield *LastMultifield;
+   unsigned long ephemeralCount;
+   unsigned long deferredSweeps;
   };
 
 struct clipsBlock
@@ -144,6 +150,15 @@ struct clipsBlock
    UDFValue *result;
   };
 
+struct garbageStatistics
+  {
+   unsigned long long sweeps;
+   unsigned long long atomsReclaimed;
+   unsigned long long multifieldsReclaimed;
+   unsigned long lastAtomsReclaimed;
+   unsigned long lastMultifieldsReclaimed;
+  };
+
 struct stringBuilder
   {
    Environment *sbEnv;
@@ -166,8 +181,14 @@ struct utilityData
    struct trackedMemory *trackList;
    struct garbageFrame MasterGarbageFrame;
    struct garbageFrame *CurrentGarbageFrame;
+   unsigned long GarbageSweepInterval;
+   unsigned long GarbageSweepThreshold;
+   GarbageStatistics GarbageStats;
   };
 
+#define DEFAULT_GARBAGE_SWEEP_INTERVAL 16
+#define DEFAULT_GARBAGE_SWEEP_THRESHOLD 4096
+
 #define UtilityData(theEnv) ((struct utilityData *) GetEnvironmentData(theEnv,UTILITY_DATA))
 
   /* Is c the start of a utf8 sequence? */
@@ -224,6 +245,12 @@ struct utilityData
    void                           CallCleanupFunctions(Environment *);
    void                           CallPeriodicTasks(Environment *);
    void                           CleanCurrentGarbageFrame(Environment *,UDFValue *);
+   void                           SweepCurrentGarbageFrame(Environment *,UDFValue *);
+   unsigned long                  SetGarbageSweepInterval(Environment *,unsigned long);
+   unsigned long                  GetGarbageSweepInterval(Environment *);
+   unsigned long                  SetGarbageSweepThreshold(Environment *,unsigned long);
+   unsigned long                  GetGarbageSweepThreshold(Environment *);
+   void                           GetGarbageStatistics(Environment *,GarbageStatistics *);
    void                           CLIPSBlockStart(Environment *,CLIPSBlock *);
    void                           CLIPSBlockEnd(Environment *,CLIPSBlock *,UDFValue *);
    StringBuilder                 *CreateStringBuilder(Environment *,size_t);
@@ -0,0 +1,173 @@
+;;;*******************************************************************
+;;; BENCHMARKS
+;;;
+;;; This file runs the benchmark programs in the test suite at
+;;; several scale factors and writes the results to benchmrk.csv.
+;;; The results are then compared against the baseline file
+;;; benchmrk.bsl and the differences are written to benchmrk.rsl.
+;;; The benchmarks are not run by testall.tst. To make the current
+;;; results the new baseline, copy Results//benchmrk.csv to
+;;; benchmrk.bsl.
+;;;
+;;; To test, execute the command (batch "benchmrk.tst").
+;;;*******************************************************************
+(unwatch all)
+(set-dynamic-constraint-checking FALSE)
+(set-sequence-operator-recognition FALSE)
+(set-reset-globals TRUE)
+(set-fact-duplication FALSE)
+(set-salience-evaluation when-defined)
+(set-strategy depth)
+(open "Results//benchmrk.csv" benchmrk "w")
+; manners 16 guests
+(clear)
+(load "manners.clp")
+(load "benchmrk.clp")
+(bench-header)
+(bench-run manners 16 1 manners-guests 16)
+; manners 32 guests
+(clear)
+(load "manners.clp")
+(load "benchmrk.clp")
+(bench-run manners 32 1 manners-guests 32)
+; manners 64 guests
+(clear)
+(load "manners.clp")
+(load "benchmrk.clp")
+(bench-run manners 64 1 manners-guests 64)
+; manners 128 guests
+(clear)
+(load "manners.clp")
+(load "benchmrk.clp")
+(bench-run manners 128 1 manners-guests 128)
+; waltz 1 copies of waltz12
+(clear)
+(load "waltz.clp")
+(load "benchmrk.clp")
+(bench-run waltz 1 1 waltz-lines "waltz12.fct" 1)
+; waltz 2 copies of waltz12
+(clear)
+(load "waltz.clp")
+(load "benchmrk.clp")
+(bench-run waltz 2 1 waltz-lines "waltz12.fct" 2)
+; waltz 4 copies of waltz12
+(clear)
+(load "waltz.clp")
+(load "benchmrk.clp")
+(bench-run waltz 4 1 waltz-lines "waltz12.fct" 4)
+; sudoku 1 repetitions
+(clear)
+(load "sudoku.clp")
+(load "solve.clp")
+(load "output-frills.clp")
+(load "grid3x3-p17.clp")
+(load "benchmrk.clp")
+(bench-run sudoku 1 1)
+; sudoku 4 repetitions
+(clear)
+(load "sudoku.clp")
+(load "solve.clp")
+(load "output-frills.clp")
+(load "grid3x3-p17.clp")
+(load "benchmrk.clp")
+(bench-run sudoku 4 4)
+; sudoku 16 repetitions
+(clear)
+(load "sudoku.clp")
+(load "solve.clp")
+(load "output-frills.clp")
+(load "grid3x3-p17.clp")
+(load "benchmrk.clp")
+(bench-run sudoku 16 16)
+; zebra 1 repetitions
+(clear)
+(load "zebra.clp")
+(load "benchmrk.clp")
+(bench-run zebra 1 1)
+; zebra 10 repetitions
+(clear)
+(load "zebra.clp")
+(load "benchmrk.clp")
+(bench-run zebra 10 10)
+; zebra 100 repetitions
+(clear)
+(load "zebra.clp")
+(load "benchmrk.clp")
+(bench-run zebra 100 100)
+; mab 1 repetitions
+(clear)
+(load "mab.clp")
+(load "benchmrk.clp")
+(bench-run mab 1 1)
+; mab 10 repetitions
+(clear)
+(load "mab.clp")
+(load "benchmrk.clp")
+(bench-run mab 10 10)
+; mab 100 repetitions
+(clear)
+(load "mab.clp")
+(load "benchmrk.clp")
+(bench-run mab 100 100)
+; wordgame 1 repetitions
+(clear)
+(load "wordgame.clp")
+(load "benchmrk.clp")
+(bench-run wordgame 1 1)
+; wordgame 10 repetitions
+(clear)
+(load "wordgame.clp")
+(load "benchmrk.clp")
+(bench-run wordgame 10 10)
+; wordgame 100 repetitions
+(clear)
+(load "wordgame.clp")
+(load "benchmrk.clp")
+(bench-run wordgame 100 100)
+; circuit3 1 repetitions
+(clear)
+(set-strategy mea)
+(load "electrnc.clp")
+(load "circuit3.clp")
+(load "benchmrk.clp")
+(bench-run circuit3 1 1)
+(set-strategy depth)
+; circuit3 10 repetitions
+(clear)
+(set-strategy mea)
+(load "electrnc.clp")
+(load "circuit3.clp")
+(load "benchmrk.clp")
+(bench-run circuit3 10 10)
+(set-strategy depth)
+; circuit3 100 repetitions
+(clear)
+(set-strategy mea)
+(load "electrnc.clp")
+(load "circuit3.clp")
+(load "benchmrk.clp")
+(bench-run circuit3 100 100)
+(set-strategy depth)
+; logical 1000 items
+(clear)
+(load "lgclbnch.clp")
+(load "benchmrk.clp")
+(bench-run logical 1000 1 logical-data 1000 4 1000)
+; logical 4000 items
+(clear)
+(load "lgclbnch.clp")
+(load "benchmrk.clp")
+(bench-run logical 4000 1 logical-data 4000 4 4000)
+; logical 16000 items
+(clear)
+(load "lgclbnch.clp")
+(load "benchmrk.clp")
+(bench-run logical 16000 1 logical-data 16000 4 16000)
+; compare against the baseline
+(close benchmrk)
+(clear)
+(load "benchmrk.clp")
+(open "Results//benchmrk.rsl" benchmrk "w")
+(printout benchmrk "Benchmark differences from baseline are as follows:" crlf)
+(bench-compare "benchmrk.bsl" "Results//benchmrk.csv" benchmrk 25.0 1.0)
+(close benchmrk)
@@ -39,3 +39,21 @@
   (bind ?rest 34)
   (printout t ?rest crlf))
 (wildcard-test 1 2 3 4 5 6)
+(deffunction local-depth (?n)
+  (bind ?a ?n)
+  (bind ?b (* ?n 2))
+  (if (> ?n 0)
+     then
+     (bind ?c (local-depth (- ?n 1)))
+     else
+     (bind ?c 0))
+  (+ ?c (- ?b ?a)))
+(local-depth 10)
+(local-depth 300)
+(deffunction local-loop (?n)
+  (bind ?s 0)
+  (loop-for-count (?i ?n)
+     (bind ?t (local-depth 3))
+     (bind ?s (+ ?s ?t ?i)))
+  ?s)
+(local-loop 100)
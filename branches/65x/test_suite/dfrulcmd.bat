@@ -284,3 +284,57 @@
 (show-breaks FOO)
 (show-breaks BAR)
 (show-breaks *)
+(clear) ; Join reordering
+(get-join-reordering)
+(deftemplate big (slot id) (slot v))
+(deftemplate small (slot id))
+(deffacts data (small (id 3)) (small (id 7)))
+(reset)
+(loop-for-count (?i 1 50) do (assert (big (id ?i) (v (mod ?i 5)))))
+(set-join-reordering TRUE)
+(defrule j1 (big (id ?x) (v ?v)) (small (id ?x)) => (printout t "j1 " ?x " " ?v crlf))
+(defrule j2 (big (id ?x) (v ?v&:(> ?v 0))) (small (id ?y&:(= ?y ?x))) => (printout t "j2 " ?x crlf))
+(defrule j3 (big (id ?x)) (small (id ?x)) (test (> ?x 4)) (small (id 3)) => (printout t "j3 " ?x crlf))
+(defrule j4 (logical (big (id ?x))) (small (id ?x)) (not (small (id 5))) => (printout t "j4 " ?x crlf))
+(matches j1 succinct)
+(matches j2 succinct)
+(matches j3 succinct)
+(matches j4 succinct)
+(run)
+(defrule j7 (big (id ?x)) (test (> ?x 2)) (small (id ?y)) =>)
+(matches j7 succinct)
+(defrule j8 (big (id ?x)) (small (id ?y)) (test (= ?x ?y)) =>)
+(matches j8 succinct)
+(defrule j9 (big (v ?y)) (small (id ?x&~?y)) =>)
+(matches j9 succinct)
+(defrule j10 (big (id ?y)) (small (id 7|?y)) =>)
+(matches j10 succinct)
+(set-join-reordering FALSE)
+(defrule j5 (big (id ?x)) (small (id ?x)) =>)
+(matches j5 succinct)
+(set-join-reordering TRUE)
+(set-strategy mea)
+(defrule j6 (big (id ?x)) (small (id ?x)) =>)
+(matches j6 succinct)
+(set-strategy depth)
+(set-join-reordering FALSE)
+(clear)
+(clear) ; Dynamic salience dependencies
+(set-salience-evaluation every-cycle)
+(defglobal ?*g* = 0 ?*h* = 10)
+(deffunction vsal () ?*h*)
+(deffacts data (a 1) (a 2) (a 3))
+(defrule r-global (declare (salience (* ?*g* 2))) (a ?x) => (printout t "r-global " ?x crlf) (bind ?*g* (- ?*g* 2)))
+(defrule r-volatile (declare (salience (vsal))) (a ?x) => (printout t "r-volatile " ?x crlf) (bind ?*h* (- ?*h* 4)))
+(defrule r-fixed (declare (salience 5)) (a ?x) => (printout t "r-fixed " ?x crlf) (bind ?*g* 5))
+(reset)
+(agenda)
+(run)
+(bsave "Temp//dfrulcmd.bin")
+(clear)
+(bload "Temp//dfrulcmd.bin")
+(reset)
+(run)
+(clear)
+(set-salience-evaluation when-defined)
+(clear)
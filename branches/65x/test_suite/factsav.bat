@@ -69,3 +69,41 @@
 (load-facts "Temp//fctsav8.fct")
 (facts *)
 (retract *)
+(clear) ; Test loading facts directly from tokens
+(deftemplate point (slot x (type INTEGER)) (slot y (default 7)) (multislot tags) (slot s (allowed-symbols a b c)))
+(deftemplate req (slot a (default ?NONE)) (slot b (default-dynamic (+ 1 2))))
+(open "Temp//fctsav9.fct" lf "w")
+(printout lf "(a b 1 2.5 \"str\" [inst]) (point (x 3) (tags a \"b c\" 4.5))" crlf)
+(printout lf "(point (y 9) (s b)) (req (a 1)) (req (a 2) (b 4))" crlf)
+(close lf)
+(load-facts "Temp//fctsav9.fct")
+(facts)
+(open "Temp//fctsav9.fct" lf "w")
+(printout lf "(point (x 3) (z 4))" crlf)
+(close lf)
+(load-facts "Temp//fctsav9.fct")
+(open "Temp//fctsav9.fct" lf "w")
+(printout lf "(point (x 3) (x 4))" crlf)
+(close lf)
+(load-facts "Temp//fctsav9.fct")
+(open "Temp//fctsav9.fct" lf "w")
+(printout lf "(point (x 1.5))" crlf)
+(close lf)
+(load-facts "Temp//fctsav9.fct")
+(open "Temp//fctsav9.fct" lf "w")
+(printout lf "(point (s d))" crlf)
+(close lf)
+(load-facts "Temp//fctsav9.fct")
+(open "Temp//fctsav9.fct" lf "w")
+(printout lf "(point (x 1 2))" crlf)
+(close lf)
+(load-facts "Temp//fctsav9.fct")
+(open "Temp//fctsav9.fct" lf "w")
+(printout lf "(req (b 1))" crlf)
+(close lf)
+(load-facts "Temp//fctsav9.fct")
+(open "Temp//fctsav9.fct" lf "w")
+(printout lf "(a ?x)" crlf)
+(close lf)
+(load-facts "Temp//fctsav9.fct")
+(facts)
@@ -107,3 +107,39 @@
 (ppfact 3 t FALSE)
 (ppfact 3 t TRUE)
 (clear)
+(clear)                            ; removing logical support in any order
+(defrule support (logical (item ?x)) => (assert (present)))
+(defrule chain1 (logical (present)) => (assert (level 1)))
+(defrule chain2 (logical (level 1)) => (assert (level 2)))
+(defrule expand (logical (batch)) => (assert (member 1) (member 2) (member 3)))
+(assert (item 1) (item 2) (item 3) (item 4) (batch))
+(run)
+(dependencies 9)
+(retract 2)
+(dependencies 9)
+(dependents 5)
+(retract 7)
+(dependents 5)
+(retract 5)
+(facts)
+(retract 4 1)
+(dependencies 9)
+(retract 10)
+(facts)
+(retract 3)
+(facts)
+(clear)
+(clear)                            ; order of cascading logical retractions
+(defrule r1 (logical (root)) => (assert (a 1) (a 2) (a 3)))
+(defrule r2 (logical (a ?x)) => (assert (b ?x) (c ?x)))
+(defrule r3 (logical (b ?x)) => (assert (d ?x)))
+(defrule r4 (d ?x) =>)
+(defrule r5 (not (c 2)) =>)
+(assert (root))
+(run)
+(watch facts)
+(watch activations)
+(retract 1)
+(unwatch all)
+(agenda)
+(clear)
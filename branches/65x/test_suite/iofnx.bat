@@ -1,7 +1,7 @@
 (clear)                            
 (open)                             ; 10.5.2.1
 (open "blah1.dat")                 ; 10.5.2.1
-(open "blah2.dat" blah2 "r" 10)    ; 10.5.2.1
+(open "blah2.dat" blah2 "r" 10 20) ; 10.5.2.1
 (open 10 blah3 "r")                ; 10.5.2.1
 (open [blah2.dat] blah4 "r")       ; 10.5.2.1
 (open "blah4.dat" (create$) "r")   ; 10.5.2.1
@@ -111,3 +111,36 @@ xyz abc
 (read temp)
 (close temp)
 (remove "Temp/iofun.dat") 
+(open "Temp/iofun.dat" temp "w" 4096)
+(printout temp red crlf)
+(open "Temp/iofun.dat" check "r")
+(read check)
+(close check)
+(flush temp)
+(open "Temp/iofun.dat" check "r")
+(read check)
+(close check)
+(printout temp green crlf)
+(flush)
+(close temp)
+(flush)
+(flush temp)
+(open "Temp/iofun.dat" temp "r")
+(read temp)
+(read temp)
+(read temp)
+(close temp)
+(open "Temp/iofun.dat" temp "a" 0)
+(printout temp blue crlf)
+(close temp)
+(open "Temp/iofun.dat" temp "r" -1)
+(open "Temp/iofun.dat" temp "w" 100000000000)
+(open "Temp/iofun.dat" temp "r" 1024)
+(read temp)
+(read temp)
+(read temp)
+(read temp)
+(close temp)
+(printout temp "closed")
+(flush "bad" extra)
+(remove "Temp/iofun.dat")
@@ -405,3 +405,11 @@
 (mod 5 2)                          ; 10.6.2.13 : 1
 (format nil "%0.6f" (mod 3.7 1.2)) ; 10.6.2.13 : 0.1
 (clear)
+(eq 1023 (+ 1000 23))              ; small integer boundary : TRUE
+(eq 1024 (+ 1000 24))              ; small integer boundary : TRUE
+(eq -128 (- -100 28))              ; small integer boundary : TRUE
+(eq -129 (- -100 29))              ; small integer boundary : TRUE
+(defglobal ?*count* = 0)
+(loop-for-count 2000 do (bind ?*count* (+ ?*count* 1)))
+?*count*                           ; 2000
+(clear)
@@ -49,3 +49,89 @@
 (ppdefinstances foo)
 (ppdefmessage-handler SNAFU fubar)
 (conserve-mem off)
+(clear) ; Garbage sweep interval
+(get-garbage-sweep-interval)
+(set-garbage-sweep-interval)
+(set-garbage-sweep-interval -1)
+(set-garbage-sweep-interval 1)
+(get-garbage-sweep-interval)
+(deftemplate counter (slot n))
+(defrule count
+   ?f <- (counter (n ?n&:(< ?n 100)))
+   =>
+   (modify ?f (n (+ ?n 1))))
+(assert (counter (n 0)))
+(run)
+(set-garbage-sweep-interval 16)
+(assert (counter (n 50)))
+(run)
+(length$ (garbage-statistics))
+(facts)
+(defrule label
+   ?f <- (counter (n ?n&:(< ?n 200)))
+   =>
+   (str-cat "label-" ?n)
+   (modify ?f (n (+ ?n 1))))
+(deffunction sweeps-during-run ()
+   (bind ?before (nth$ 1 (garbage-statistics)))
+   (run)
+   (- (nth$ 1 (garbage-statistics)) ?before))
+(set-garbage-sweep-interval 1)
+(assert (counter (n 100)))
+(sweeps-during-run)
+(set-garbage-sweep-interval 16)
+(assert (counter (n 100)))
+(sweeps-during-run)
+(set-garbage-sweep-interval 50)
+(assert (counter (n 100)))
+(sweeps-during-run)
+(set-garbage-sweep-interval 16)
+(clear) ; Memory limits
+(get-memory-limits)
+(set-memory-limits -1 0)
+(set-memory-limits 0)
+(set-memory-limits 2000000 1000000)
+(get-memory-limits)
+(set-memory-limits 1000000 0)
+(get-memory-limits)
+(set-memory-limits 0 0)
+(> (mem-peak) 0)
+(>= (mem-peak facts) 0)
+(mem-peak foo)
+(deftemplate item (slot n))
+(assert (item (n 1)))
+(> (mem-peak facts) 0)
+(set-memory-limits 0 (+ (mem-used) 100000))
+(loop-for-count (?i 100000) (assert (item (n ?i))))
+(< (length$ (find-all-facts ((?f item)) TRUE)) 100000)
+(set-memory-limits 0 0)
+(reset)
+(set-memory-limits (+ (mem-used) 10000) 0)
+(loop-for-count (?i 1000) (assert (item (n ?i))))
+(length$ (find-all-facts ((?f item)) TRUE))
+(set-memory-limits 0 0)
+(get-memory-limits)
+(reset)
+(mem-peak-reset)
+(= (mem-peak) (mem-used))
+(loop-for-count (?i 100) (assert (item (n ?i))))
+(reset)
+(> (mem-peak) (mem-used))
+(defrule count-items (item (n ?n)) =>)
+(loop-for-count (?i 5) (assert (item (n ?i))))
+(run)
+(rules-fired)
+(run)
+(rules-fired)
+(clear) ; Subsystem memory after a clear
+(defclass A (is-a USER) (slot x))
+(defrule r (a ?x) =>)
+(assert (a 1) (a 2))
+(make-instance a1 of A (x 1))
+(> (mem-peak agenda) 0)
+(> (mem-peak instances) 0)
+(clear)
+(mem-peak-reset)
+(mem-peak agenda)
+(mem-peak instances)
+(mem-peak facts)
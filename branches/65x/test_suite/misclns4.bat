@@ -361,3 +361,194 @@
 (run)
 (facts)
 (clear)
+(clear) ;; incremental reset of loaded rules
+(defclass W (is-a USER) (slot s))
+(make-instance v of W (s 1))
+(assert (x 1) (x 2) (x 5) (y 1))
+(open "Temp//batch.tmp" batch "w")
+(printout batch "(defrule c (x ?v) (y ?v) =>)" crlf)
+(printout batch "(defglobal ?*i* = (make-instance w of W (s 5)))" crlf)
+(printout batch "(defrule d (object (is-a W) (s ?s)) (x ?s) =>)" crlf)
+(printout batch "(defrule e (object (is-a W) (s ?s)) =>)" crlf)
+(printout batch "(defrule f (x ?v) (not (y ?v)) =>)" crlf)
+(close batch)
+(load "Temp//batch.tmp")
+(agenda)
+(run)
+(send [w] put-s 1)
+(agenda)
+(load "Temp//batch.tmp")
+(agenda)
+(clear)
+(clear) ;; agenda order of rules loaded over existing facts
+(assert (a 1) (b 1) (a 2))
+(open "Temp//batch.tmp" batch "w")
+(printout batch "(defrule r1 (a ?x) =>)" crlf)
+(printout batch "(defrule r2 (b ?x) =>)" crlf)
+(printout batch "(defrule r3 (a ?x) (b ?x) =>)" crlf)
+(close batch)
+(load "Temp//batch.tmp")
+(agenda)
+(clear)
+(assert (a 1) (b 1) (a 2))
+(watch activations)
+(load "Temp//batch.tmp")
+(unwatch activations)
+(agenda)
+(clear)
+(clear) ;; reset snapshots
+(get-reset-snapshot)
+(set-reset-snapshot TRUE)
+(deftemplate item (slot id) (multislot tags))
+(deffacts start (item (id 1) (tags a b)) (item (id 2) (tags c)) (item (id 3)) (go))
+(defrule pair (item (id ?x)) (item (id ?y&:(> ?y ?x))) =>)
+(defrule lone (go) (not (item (id 4))) =>)
+(defrule tagged (exists (item (tags $? c $?))) =>)
+(reset)
+(facts)
+(agenda)
+(reset)
+(facts)
+(agenda)
+(assert (item (id 4) (tags c)))
+(agenda)
+(reset)
+(retract 2)
+(agenda)
+(run)
+(reset)
+(agenda)
+(watch facts)
+(reset)
+(unwatch facts)
+(deffacts more (item (id 0)))
+(reset)
+(agenda)
+(reset)
+(facts)
+(undefrule pair)
+(reset)
+(agenda)
+(set-reset-snapshot FALSE)
+(get-reset-snapshot)
+(reset)
+(agenda)
+(set-reset-snapshot TRUE)
+(clear)
+(get-reset-snapshot)
+(set-reset-snapshot FALSE)
+(clear)
+(clear) ;; reset snapshots with defglobals and deffunctions
+(set-reset-snapshot TRUE)
+(defglobal ?*t* = 0)
+(deffacts d (a 1) (a 2) (a 3))
+(defrule r (a ?x) (test (> ?x ?*t*)) =>)
+(reset)
+(agenda)
+(defglobal ?*t* = 2)
+(reset)
+(agenda)
+(set-reset-globals FALSE)
+(bind ?*t* 0)
+(reset)
+(agenda)
+(set-reset-globals TRUE)
+(undefrule r)
+(deffunction limit () 1)
+(defrule s (a ?x&:(> ?x (limit))) =>)
+(reset)
+(agenda)
+(deffunction limit () 2)
+(reset)
+(agenda)
+(set-reset-snapshot FALSE)
+(clear)
+(clear) ;; reset snapshots with computed deffacts values
+(set-reset-globals FALSE)
+(defglobal ?*g* = 1)
+(deftemplate level (slot n (default-dynamic ?*g*)))
+(deffacts d (val ?*g*) (level))
+(set-reset-snapshot TRUE)
+(reset)
+(facts)
+(bind ?*g* 2)
+(reset)
+(facts)
+(undeffacts d)
+(deffacts e (count (+ ?*g* 1)))
+(reset)
+(facts)
+(bind ?*g* 3)
+(reset)
+(facts)
+(set-reset-snapshot FALSE)
+(set-reset-globals TRUE)
+(clear)
+(clear) ;; binary trace files
+(deftemplate point (slot x))
+(defrule left (point (x ?x)) (not (point (x 99))) => (printout t "left " ?x crlf))
+(defrule drop ?f <- (point (x 2)) => (retract ?f))
+(binary-trace-on "Temp//trace.bin" facts bogus)
+(binary-trace-off)
+(binary-trace-on "Temp//trace.bin")
+(reset)
+(assert (point (x 1)) (point (x 2)))
+(run)
+(assert (point (x 99)))
+(binary-trace-off)
+(binary-trace-decode "Temp//trace.bin")
+(binary-trace-on "Temp//trace.bin" rules)
+(retract 3)
+(run)
+(binary-trace-off)
+(binary-trace-decode "Temp//trace.bin")
+(binary-trace-decode "misclns4.bat")
+(deffunction copy-trace (?from ?to ?limit ?position ?byte)
+   (open ?from trace-in "rb")
+   (open ?to trace-out "wb")
+   (bind ?i 0)
+   (bind ?c (get-char trace-in))
+   (while (and (<> ?c -1) (< ?i ?limit))
+      (if (= ?i ?position) then (put-char trace-out ?byte) else (put-char trace-out ?c))
+      (bind ?i (+ ?i 1))
+      (bind ?c (get-char trace-in)))
+   (close trace-in)
+   (close trace-out))
+(copy-trace "Temp//trace.bin" "Temp//bad.bin" 42 -1 0)
+(binary-trace-decode "Temp//bad.bin")
+(copy-trace "Temp//trace.bin" "Temp//bad.bin" 1000 20 200)
+(binary-trace-decode "Temp//bad.bin")
+(copy-trace "Temp//trace.bin" "Temp//bad.bin" 1000 20 0)
+(binary-trace-decode "Temp//bad.bin")
+(copy-trace "Temp//trace.bin" "Temp//bad.bin" 1000 40 0)
+(binary-trace-decode "Temp//bad.bin")
+(clear)
+(clear) ;; compressed pretty print forms
+(conserve-mem bogus)
+(conserve-mem compress)
+(defmodule MAIN (export ?ALL))
+(deftemplate point "A point" (slot x (default 0)) (slot y (default 0)))
+(defrule point-rule "Compare the coordinates of points"
+   (point (x ?x) (y ?y&:(> ?y ?x)))
+   (point (x ?x) (y ?y2&:(> ?y2 ?y)))
+   =>
+   (printout t "Points with x " ?x " and y " ?y " and " ?y2 crlf)
+   (printout t "Points with x " ?x " and y " ?y " and " ?y2 crlf))
+(deffunction double (?x) (* ?x 2))
+(defgeneric combine)
+(defmethod combine ((?x INTEGER) (?y INTEGER)) (+ ?x ?y))
+(defclass WIDGET (is-a USER) (slot size (default 10)))
+(defmessage-handler WIDGET grow () (bind ?self:size (* ?self:size 2)))
+(ppdeftemplate point)
+(ppdefrule point-rule)
+(ppdeffunction double)
+(ppdefmethod combine 1)
+(ppdefclass WIDGET)
+(ppdefmessage-handler WIDGET grow)
+(ppdefmodule MAIN)
+(ppdefrule point-rule)
+(conserve-mem off)
+(defrule uncompressed => (printout t "uncompressed" crlf))
+(ppdefrule uncompressed)
+(ppdefrule point-rule)
+(clear)
@@ -37,3 +37,28 @@
 (get-current-module)
 (clear)
 (list-defmodules)
+(deffunction MAIN::f () MAIN)
+(defmodule A (export deffunction ?ALL))
+(deffunction A::f () A)
+(deffunction A::g () A-g)
+(defmodule B (import A deffunction g))
+(deffunction B::f () B)
+(f)
+(g)
+(A::f)
+(MAIN::f)
+(undeffunction B::f)
+(f)
+(deffunction B::f () B2)
+(f)
+(deffunction A::g () A-g2)
+(g)
+(ppdeffunction f)
+(set-current-module A)
+(ppdeffunction f)
+(list-deffunctions *)
+(clear)
+(deffunction f () cleared)
+(f)
+(clear)
+(list-deffunctions)
@@ -116,3 +116,40 @@
 (make-instance t of test)
 (send [t] test-arg-cnt)
 (send [t] test-arg-cnt 1 2 3)
+(clear) ;; direct slot accessors
+(defclass A (is-a USER) (slot x (default 1)) (multislot z (default a b c)) (slot r (access initialize-only) (default 5)))
+(defclass C (is-a A) (slot x (default 3)))
+(make-instance a of A)
+(make-instance c of C)
+(send [a] get-x)
+(send [c] get-x)
+(send [a] put-x 10)
+(send [a] get-x)
+(send [a] put-z 1 (create$ 2 3) 4)
+(send [a] get-z)
+(send [a] put-x)
+(send [a] get-x)
+(send [a] put-x (create$ 9))
+(send [a] put-x 1 2)
+(send [a] put-r 9)
+(send [a] get-x 1 2)
+(defmessage-handler A get-x around () (printout t "around" crlf) (call-next-handler))
+(send [a] get-x)
+(send [c] get-x)
+(undefmessage-handler A get-x around)
+(send [a] get-x)
+(watch messages)
+(send [a] get-x)
+(unwatch messages)
+(defrule matched (object (is-a A) (x 77) (name ?n)) => (printout t "matched " ?n crlf))
+(send [c] put-x 77)
+(run)
+(set-dynamic-constraint-checking TRUE)
+(defclass D (is-a USER) (slot n (type INTEGER)))
+(make-instance d of D)
+(send [d] put-n abc)
+(send [d] get-n)
+(set-dynamic-constraint-checking FALSE)
+(send [a] delete)
+(send [a] get-x)
+(clear)
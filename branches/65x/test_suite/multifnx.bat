@@ -213,3 +213,21 @@
 (rest$ (create$ a b c))
 (rest$ (create$ a))
 (rest$ (create$))
+(clear) ; member$ position index
+(defglobal ?*big* = (create$))
+(progn
+   (loop-for-count (?i 1 600)
+      (bind ?*big* (insert$ ?*big* (+ (length$ ?*big*) 1) (sym-cat s (mod ?i 200)))))
+   (length$ ?*big*))
+(member$ s17 ?*big*)
+(member$ s17 ?*big*)
+(member$ (create$ s17 s18) ?*big*)
+(member$ (create$ s17 s19) ?*big*)
+(member$ none ?*big*)
+(member$ s17 (subseq$ ?*big* 100 600))
+(member$ s17 (subseq$ ?*big* 100 600))
+(replace$ ?*big* 2 599 x)
+(delete$ ?*big* 3 598)
+(insert$ (delete$ ?*big* 3 598) 3 q r)
+(bind ?*big* (create$))
+(member$ s17 ?*big*)
@@ -574,3 +574,134 @@
 (run)
 (unwatch all)
 (clear)
+(clear) ; Object patterns selected by class and modified slot
+
+(defclass A (is-a USER)
+   (slot x)
+   (slot y)
+   (slot z))
+
+(defclass B (is-a A))
+
+(defclass C (is-a USER)
+   (slot x))
+
+(defrule ax
+   (object (is-a A) (name ?n) (x ?x&~0))
+   =>
+   (printout t "ax " ?n " " ?x crlf))
+
+(defrule by
+   (object (is-a B) (name ?n) (y ?y&~0))
+   =>
+   (printout t "by " ?n " " ?y crlf))
+
+(defrule cx
+   (object (is-a C) (name ?n) (x ?x&~0))
+   =>
+   (printout t "cx " ?n " " ?x crlf))
+(make-instance a1 of A (x 0) (y 0) (z 0))
+(make-instance b1 of B (x 0) (y 0) (z 0))
+(make-instance c1 of C (x 0))
+(run)
+(modify-instance [a1] (x 1) (y 1))
+(modify-instance [b1] (x 2) (y 2))
+(modify-instance [c1] (x 3))
+(run)
+(modify-instance [b1] (z 4))
+(run)
+(defrule yz
+   (object (is-a A) (name ?n) (y ?y&~0) (z ?z&~0))
+   =>
+   (printout t "yz " ?n " " ?y " " ?z crlf))
+(run)
+(modify-instance [a1] (y 5) (z 5))
+(run)
+(undefrule ax)
+(modify-instance [a1] (x 6))
+(modify-instance [b1] (x 6) (y 6))
+(run)
+(clear)
+(clear) ; Queued object match actions
+
+(defclass A (is-a USER)
+   (slot x))
+
+(defclass B (is-a USER)
+   (slot x))
+
+(defrule ax
+   (object (is-a A) (name ?n) (x ?x))
+   =>
+   (printout t "ax " ?n " " ?x crlf))
+
+(defrule bx
+   (object (is-a B) (name ?n) (x ?x))
+   =>
+   (printout t "bx " ?n " " ?x crlf))
+(make-instance a0 of A (x 0))
+(make-instance b0 of B (x 0))
+(run)
+(object-pattern-match-delay
+   (make-instance a1 of A (x 1))
+   (make-instance b1 of B (x 1))
+   (make-instance a2 of A (x 2))
+   (modify-instance [a1] (x 3))
+   (modify-instance [b0] (x 4))
+   (modify-instance [a0] (x 5))
+   (send [b0] delete)
+   (make-instance b2 of B (x 6))
+   (send [a2] delete)
+   (modify-instance [a0] (x 7)))
+(agenda)
+(run)
+(clear)
+(deffunction bad () ab)
+(deftemplate point
+   (slot x)
+   (slot s))
+
+(defclass P
+   (is-a USER)
+   (slot x))
+
+(defrule infer
+   ?f <- (point (x ?x) (s ?s))
+   =>
+   (printout t (fact-index ?f) " " (str-length ?s) " " (str-cat ?s (+ ?x 2)) crlf)
+   (retract ?f))
+
+(defrule infer-object
+   ?o <- (object (is-a P) (x ?x))
+   =>
+   (printout t (instance-name ?o) " " (integerp (+ ?x 1)) crlf)
+   (send ?o delete))
+(assert (point (x 3) (s "abc")))
+(make-instance p1 of P (x 1))
+(run)
+(assert (point (x (bad)) (s "abc")))
+(run)
+(clear)
+(clear)
+(deftemplate item (slot id))
+(deftemplate block (slot id))
+(deftemplate seen (slot id))
+(defrule unlinked-not
+   (item (id ?x))
+   (not (block (id ?x)))
+   =>)
+(defrule unlinked-join
+   (seen (id ?x))
+   (item (id ?x))
+   (block (id ?x))
+   =>)
+(assert (item (id 1)) (item (id 2)))
+(agenda)
+(assert (block (id 1)))
+(agenda)
+(assert (seen (id 2)))
+(agenda)
+(assert (block (id 2)))
+(agenda)
+(retract 3 5)
+(agenda)
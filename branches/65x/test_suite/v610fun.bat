@@ -16,6 +16,24 @@
 (deffunction three (?a ?b ?c)
    (> ?a ?b ?c))
 (sort three 4 8 2 5 3)
+(sort > 3 2.5 5 1 2 2.0)
+(sort < 3 2.5 5 1 2 2.0)
+(sort >= 3 a 1)
+(deffunction neg (?x)
+   (- 0 ?x))
+(sort-by-key > neg 3 2.5 5 1 2)
+(sort-by-key > str-length "ccc" "a" "bb" "dd" "e")
+(sort-by-key < neg)
+(sort-by-key > create$ 1 2)
+(sort-by-key > 3 1 2)
+(sort-by-key > three 1 2)
+(sort-by-key str> sym-cat ax aa dj ce bx)
+(deftemplate ev
+   (slot ts))
+(deffunction ts (?f)
+   (fact-slot-value ?f ts))
+(assert (ev (ts 3)) (ev (ts 1)) (ev (ts 2)))
+(sort-by-key > ts (find-all-facts ((?f ev)) TRUE))
 (clear)
 (get-class-defaults-mode)
 (get-class-defaults-mode 10)